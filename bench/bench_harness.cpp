@@ -0,0 +1,199 @@
+#include "bench_harness.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string_view>
+
+namespace {
+std::atomic<std::uint64_t> g_allocations{0};
+}  // namespace
+
+namespace {
+void *counted_alloc(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void *counted_aligned_alloc(std::size_t size, std::align_val_t alignment) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    const auto align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+    return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+    // aligned_alloc wants the size to be a multiple of the alignment.
+    const std::size_t rounded = ((size == 0 ? 1 : size) + align - 1) / align * align;
+    return std::aligned_alloc(align, rounded);
+#endif
+}
+
+void aligned_free(void *memory) {
+#ifdef _WIN32
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+}  // namespace
+
+// Counting replacements for the global allocation functions: the plain,
+// array and aligned forms are all replaced, so containers that over-align
+// their storage (SmallVector) are counted too. The nothrow forms forward to
+// these by default.
+void *operator new(std::size_t size) {
+    if (void *memory = counted_alloc(size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) {
+    if (void *memory = counted_alloc(size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    if (void *memory = counted_aligned_alloc(size, alignment)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void *memory = counted_aligned_alloc(size, alignment)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void *memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::align_val_t) noexcept {
+    aligned_free(memory);
+}
+
+void operator delete(void *memory, std::size_t, std::align_val_t) noexcept {
+    aligned_free(memory);
+}
+
+void operator delete[](void *memory, std::align_val_t) noexcept {
+    aligned_free(memory);
+}
+
+void operator delete[](void *memory, std::size_t, std::align_val_t) noexcept {
+    aligned_free(memory);
+}
+
+namespace wslmon::bench {
+
+namespace {
+double percentile(const std::vector<double> &sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const auto rank = static_cast<std::size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+void write_json(std::ostream &out, const std::vector<BenchResult> &results) {
+    out << std::fixed << std::setprecision(3);
+    out << "{\"benchmarks\":[";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto &result = results[i];
+        out << (i == 0 ? "" : ",") << "\n  {\"name\":\"" << result.name << "\",\"ops\":" << result.ops
+            << ",\"ns_per_op\":" << result.ns_per_op << ",\"p50_ns\":" << result.p50_ns
+            << ",\"p90_ns\":" << result.p90_ns << ",\"p99_ns\":" << result.p99_ns
+            << ",\"allocs_per_op\":" << result.allocs_per_op << "}";
+    }
+    out << "\n]}\n";
+}
+}  // namespace
+
+std::uint64_t AllocationCount() {
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+BenchRunner::BenchRunner(int argc, char **argv) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg(argv[i]);
+        if (arg == "--json") {
+            json_ = true;
+        } else if (arg.substr(0, 7) == "--json=") {
+            json_ = true;
+            json_path_ = std::string(arg.substr(7));
+        } else if (arg.substr(0, 9) == "--filter=") {
+            filter_ = std::string(arg.substr(9));
+        } else if (arg.substr(0, 14) == "--min-time-ms=") {
+            min_time_ = std::chrono::milliseconds(std::strtoll(std::string(arg.substr(14)).c_str(), nullptr, 10));
+        } else {
+            std::cerr << "unknown argument " << arg << "\n";
+        }
+    }
+}
+
+bool BenchRunner::selected(const std::string &name) const {
+    return filter_.empty() || name.find(filter_) != std::string::npos;
+}
+
+void BenchRunner::record(const std::string &name,
+                         std::uint64_t ops,
+                         std::chrono::steady_clock::duration total,
+                         std::uint64_t allocations,
+                         std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    BenchResult result;
+    result.name = name;
+    result.ops = ops;
+    result.ns_per_op = std::chrono::duration<double, std::nano>(total).count() / static_cast<double>(ops);
+    result.allocs_per_op = static_cast<double>(allocations) / static_cast<double>(ops);
+    result.p50_ns = percentile(samples, 0.50);
+    result.p90_ns = percentile(samples, 0.90);
+    result.p99_ns = percentile(samples, 0.99);
+    if (!json_) {
+        std::cout << std::left << std::setw(34) << name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << result.ns_per_op << " ns/op  p50 " << std::setw(10) << result.p50_ns
+                  << "  p90 " << std::setw(10) << result.p90_ns << "  p99 " << std::setw(10) << result.p99_ns
+                  << std::setprecision(2) << "  allocs/op " << result.allocs_per_op << "\n";
+    }
+    results_.push_back(std::move(result));
+}
+
+int BenchRunner::Finish() {
+    if (!json_) {
+        return 0;
+    }
+    if (json_path_.empty()) {
+        write_json(std::cout, results_);
+        return 0;
+    }
+    std::ofstream out(json_path_, std::ios::out | std::ios::trunc);
+    if (!out) {
+        std::cerr << "cannot write " << json_path_ << "\n";
+        return 1;
+    }
+    write_json(out, results_);
+    return 0;
+}
+
+}  // namespace wslmon::bench
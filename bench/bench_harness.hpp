@@ -0,0 +1,86 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace wslmon::bench {
+
+// Process-wide count of global operator new calls, including the array and
+// aligned forms; the harness replaces the global allocation functions to
+// maintain it.
+std::uint64_t AllocationCount();
+
+struct BenchResult {
+    std::string name;
+    std::uint64_t ops = 0;
+    double ns_per_op = 0.0;
+    double allocs_per_op = 0.0;
+    // Percentiles of per-sample ns/op; each sample times one batch.
+    double p50_ns = 0.0;
+    double p90_ns = 0.0;
+    double p99_ns = 0.0;
+};
+
+// Runs named benchmarks and reports them as a table on stdout, or as JSON
+// with --json (to stdout) or --json=<path>. --filter=<text> runs only the
+// benchmarks whose name contains the text; --min-time-ms=<n> sets how long
+// each one samples (default 300).
+class BenchRunner {
+  public:
+    BenchRunner(int argc, char **argv);
+
+    // Times |fn(i)| in batches of |batch| calls until the minimum time has
+    // elapsed, after one untimed warm-up batch.
+    template <typename Fn>
+    void Run(const std::string &name, std::size_t batch, Fn &&fn) {
+        if (!selected(name)) {
+            return;
+        }
+        std::uint64_t index = 0;
+        for (std::size_t i = 0; i < batch; ++i) {
+            fn(index++);
+        }
+        std::vector<double> samples;
+        const std::uint64_t allocations_before = AllocationCount();
+        const auto deadline = std::chrono::steady_clock::now() + min_time_;
+        std::chrono::steady_clock::duration total{};
+        do {
+            const auto start = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < batch; ++i) {
+                fn(index++);
+            }
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            total += elapsed;
+            samples.push_back(std::chrono::duration<double, std::nano>(elapsed).count() /
+                              static_cast<double>(batch));
+        } while (std::chrono::steady_clock::now() < deadline || samples.size() < kMinSamples);
+        const std::uint64_t allocations = AllocationCount() - allocations_before;
+        const std::uint64_t ops = static_cast<std::uint64_t>(batch) * samples.size();
+        record(name, ops, total, allocations, std::move(samples));
+    }
+
+    // Prints the collected results; returns the process exit code.
+    int Finish();
+
+  private:
+    static constexpr std::size_t kMinSamples = 10;
+
+    [[nodiscard]] bool selected(const std::string &name) const;
+    void record(const std::string &name,
+                std::uint64_t ops,
+                std::chrono::steady_clock::duration total,
+                std::uint64_t allocations,
+                std::vector<double> samples);
+
+    std::string filter_;
+    bool json_ = false;
+    std::string json_path_;
+    std::chrono::milliseconds min_time_{300};
+    std::vector<BenchResult> results_;
+};
+
+}  // namespace wslmon::bench
@@ -0,0 +1,16 @@
+#pragma once
+
+namespace wslmon::bench {
+
+class BenchRunner;
+
+// Suites that compare implementations of one component (legacy against
+// current, or one SIMD backend against another). Each lives in its own
+// translation unit and is run by shared_bench alongside the hot-path suites.
+void BenchEventDeserialize(BenchRunner &runner);
+void BenchTimestamp(BenchRunner &runner);
+void BenchJsonEscape(BenchRunner &runner);
+void BenchEventBatch(BenchRunner &runner);
+void BenchSha256(BenchRunner &runner);
+
+}  // namespace wslmon::bench
@@ -0,0 +1,52 @@
+#include "bench_harness.hpp"
+#include "bench_suites.hpp"
+
+#include "event_batch.hpp"
+#include "heuristic_analyzer.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace wslmon::bench {
+
+void BenchEventBatch(BenchRunner &runner) {
+    // A fleet export: mostly routine journal traffic across both channels,
+    // with a sprinkling of the categories the heuristics look at. Each op is
+    // one pass over all of it, as rows and as columns.
+    constexpr std::size_t kEvents = 100000;
+    const char *categories[] = {"Journal", "Journal", "Journal", "Resource", "Network", "ServiceHealth", "Process",
+                                "Kmsg"};
+    const Symbol origins[] = {"host", "guest"};
+    std::mt19937 rng(42);
+    const auto base = std::chrono::system_clock::now() - std::chrono::hours(1);
+
+    std::vector<TimelineEvent> timeline;
+    timeline.reserve(kEvents);
+    EventBatch batch;
+    batch.Reserve(kEvents, kEvents * 3);
+    for (std::size_t i = 0; i < kEvents; ++i) {
+        EventRecord record;
+        record.source = "bench";
+        record.category = categories[rng() % 8];
+        record.severity = static_cast<Severity>(rng() % 6);
+        record.message = "Routine status line for unit " + std::to_string(rng() % 500);
+        record.attributes.push_back({"unit", "svc.service"});
+        record.attributes.push_back({"pid", static_cast<std::uint64_t>(rng() % 65536)});
+        record.attributes.push_back({"state", "running"});
+        record.timestamp = base + std::chrono::milliseconds(i);
+        record.sequence = i;
+        const Symbol origin = origins[i % 2];
+        batch.Append(origin, record);
+        timeline.push_back({origin, std::move(record), std::string(64, 'a')});
+    }
+
+    runner.Run("event_batch/snapshot_rows_100k", 1, [&](std::uint64_t) { ComputeCrossChannelSnapshot(timeline); });
+    runner.Run("event_batch/snapshot_columns_100k", 1, [&](std::uint64_t) { ComputeCrossChannelSnapshot(batch); });
+    runner.Run("event_batch/analyze_rows_100k", 1, [&](std::uint64_t) { AnalyzeEventTimeline(timeline); });
+    runner.Run("event_batch/analyze_columns_100k", 1, [&](std::uint64_t) { AnalyzeEventTimeline(batch); });
+}
+
+}  // namespace wslmon::bench
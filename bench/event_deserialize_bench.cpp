@@ -0,0 +1,45 @@
+#include "bench_harness.hpp"
+#include "bench_suites.hpp"
+
+#include "event.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+wslmon::EventRecord make_record(std::uint64_t sequence) {
+    wslmon::EventRecord record;
+    record.source = "systemd.journal";
+    record.category = "Journal";
+    record.severity = wslmon::Severity::Info;
+    record.message = "Started \"Daily apt upgrade\" (unit apt-daily-upgrade.service)\tpid=" + std::to_string(sequence);
+    record.attributes.push_back({"unit", "apt-daily-upgrade.service"});
+    record.attributes.push_back({"transport", "journal"});
+    record.attributes.push_back({"priority", "6"});
+    record.attributes.push_back({"boot_id", "5b1a8d0c3f2e4e5c9a3b7d6e1f0a2b3c"});
+    record.attributes.push_back({"machine_id", "0f9e8d7c6b5a49382716051423324150"});
+    record.attributes.push_back({"hostname", "wsl-guest"});
+    record.timestamp = std::chrono::system_clock::now();
+    record.sequence = sequence;
+    return record;
+}
+}  // namespace
+
+namespace wslmon::bench {
+
+void BenchEventDeserialize(BenchRunner &runner) {
+    // Journal records with escapes and six attributes, cycled so the parser
+    // does not see one payload hot in cache.
+    std::vector<std::string> payloads;
+    payloads.reserve(64);
+    for (std::uint64_t i = 0; i < 64; ++i) {
+        payloads.push_back(SerializeEvent(make_record(i + 1)));
+    }
+    EventRecord record;
+    runner.Run("event/deserialize_journal", 1000,
+               [&](std::uint64_t i) { DeserializeEvent(payloads[i % payloads.size()], record); });
+}
+
+}  // namespace wslmon::bench
@@ -0,0 +1,54 @@
+#include "bench_harness.hpp"
+#include "bench_suites.hpp"
+
+#include "json_escape.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+const char *scanner_name(wslmon::JsonEscapeScanner scanner) {
+    switch (scanner) {
+        case wslmon::JsonEscapeScanner::Scalar:
+            return "scalar";
+        case wslmon::JsonEscapeScanner::Sse2:
+            return "sse2";
+        case wslmon::JsonEscapeScanner::Avx2:
+            return "avx2";
+        default:
+            return "auto";
+    }
+}
+}  // namespace
+
+namespace wslmon::bench {
+
+void BenchJsonEscape(BenchRunner &runner) {
+    // Journal and kmsg lines: mostly clean text, an occasional quote or tab,
+    // from short status messages up to multi-KB dumps.
+    std::mt19937 rng(7);
+    std::string out;
+    for (std::size_t length : {48, 160, 512, 4096}) {
+        std::string message;
+        for (std::size_t i = 0; i < length; ++i) {
+            const unsigned roll = rng() % 400;
+            message.push_back(roll == 0 ? '"' : roll == 1 ? '\t' : static_cast<char>('a' + rng() % 26));
+        }
+        // Unsupported scanners are skipped, so a run lists the ones this CPU
+        // can compare.
+        for (auto scanner : {JsonEscapeScanner::Scalar, JsonEscapeScanner::Sse2, JsonEscapeScanner::Avx2}) {
+            if (!JsonEscapeScannerSupported(scanner)) {
+                continue;
+            }
+            runner.Run("json_escape/" + std::string(scanner_name(scanner)) + "_" + std::to_string(length), 1000,
+                       [&](std::uint64_t) {
+                           out.clear();
+                           AppendJsonEscaped(out, message, scanner);
+                       });
+        }
+    }
+}
+
+}  // namespace wslmon::bench
@@ -0,0 +1,104 @@
+#include "bench_harness.hpp"
+#include "bench_suites.hpp"
+
+#include "crypto.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+const char *multi_backend_name(wslmon::Sha256MultiBackend backend) {
+    switch (backend) {
+        case wslmon::Sha256MultiBackend::Single:
+            return "single";
+        case wslmon::Sha256MultiBackend::Sse2:
+            return "sse2";
+        case wslmon::Sha256MultiBackend::Avx2:
+            return "avx2";
+        case wslmon::Sha256MultiBackend::Avx512:
+            return "avx512";
+        default:
+            return "auto";
+    }
+}
+
+const char *backend_name(wslmon::Sha256Backend backend) {
+    switch (backend) {
+        case wslmon::Sha256Backend::Scalar:
+            return "scalar";
+        case wslmon::Sha256Backend::Avx2:
+            return "avx2";
+        case wslmon::Sha256Backend::ShaNi:
+            return "sha-ni";
+        case wslmon::Sha256Backend::ArmV8:
+            return "armv8";
+        default:
+            return "auto";
+    }
+}
+}  // namespace
+
+namespace wslmon::bench {
+
+void BenchSha256(BenchRunner &runner) {
+    // Unsupported backends are skipped, so a run lists the ones this CPU can
+    // compare. Chain-hash inputs (64-char hash + payload) and IPC frames cluster at a
+    // few hundred bytes; 4 KB covers large journal payloads.
+    for (std::size_t size : {64, 320, 1024, 4096}) {
+        const std::vector<std::uint8_t> data(size, 0x61);
+        for (auto backend :
+             {Sha256Backend::Scalar, Sha256Backend::Avx2, Sha256Backend::ShaNi, Sha256Backend::ArmV8}) {
+            if (!Sha256BackendSupported(backend)) {
+                continue;
+            }
+            runner.Run("sha256/" + std::string(backend_name(backend)) + "_" + std::to_string(size), 1000,
+                       [&](std::uint64_t) { Sha256(data.data(), data.size(), backend); });
+        }
+    }
+
+    // Keying from raw bytes against a prepared HmacKey.
+    const std::vector<std::uint8_t> key(32, 0x5A);
+    const HmacKey prepared(key);
+    for (std::size_t size : {64, 256}) {
+        const std::vector<std::uint8_t> frame(size, 0x42);
+        const std::string suffix = "_" + std::to_string(size);
+        runner.Run("hmac_sha256/raw_key" + suffix, 1000,
+                   [&](std::uint64_t) { HmacSha256(key, frame.data(), frame.size()); });
+        runner.Run("hmac_sha256/hmac_key" + suffix, 1000,
+                   [&](std::uint64_t) { HmacSha256(prepared, frame.data(), frame.size()); });
+    }
+
+    // Bulk record verification: each op MACs 4096 log payloads of typical
+    // size.
+    for (std::size_t size : {96, 320, 1024}) {
+        const std::vector<std::string> payloads(4096, std::string(size, 'p'));
+        const std::vector<std::string_view> views(payloads.begin(), payloads.end());
+        std::vector<std::array<std::uint8_t, 32>> macs(views.size());
+        for (auto backend : {Sha256MultiBackend::Single, Sha256MultiBackend::Sse2, Sha256MultiBackend::Avx2,
+                             Sha256MultiBackend::Avx512}) {
+            if (!Sha256MultiBackendSupported(backend)) {
+                continue;
+            }
+            runner.Run("hmac_sha256_many/" + std::string(multi_backend_name(backend)) + "_" + std::to_string(size) +
+                           "_x4096",
+                       1, [&](std::uint64_t) {
+                           HmacSha256Many(prepared, views.data(), views.size(), macs.data(), backend);
+                       });
+        }
+    }
+
+    // Chain-hash candidates: a chain link is 64 hex characters plus the
+    // payload; 64 KB shows BLAKE3's chunk-parallel throughput.
+    for (std::size_t size : {320, 65536}) {
+        const std::vector<std::uint8_t> data(size, 0x63);
+        const std::string suffix = "_" + std::to_string(size);
+        const std::size_t batch = size > 4096 ? 10 : 1000;
+        runner.Run("chain_hash/sha256" + suffix, batch, [&](std::uint64_t) { Sha256(data.data(), data.size()); });
+        runner.Run("chain_hash/blake3" + suffix, batch, [&](std::uint64_t) { Blake3(data.data(), data.size()); });
+    }
+}
+
+}  // namespace wslmon::bench
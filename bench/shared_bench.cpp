@@ -0,0 +1,350 @@
+#include "bench_harness.hpp"
+#include "bench_suites.hpp"
+
+#include "black_box.hpp"
+#include "crypto.hpp"
+#include "event.hpp"
+#include "flight_recorder.hpp"
+#include "heuristic_analyzer.hpp"
+#include "ipc.hpp"
+#include "logger.hpp"
+#include "priority_ring.hpp"
+#include "ring_buffer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// One binary covering the shared library's hot paths, so a regression shows
+// up as a diff between two --json runs rather than a number to eyeball.
+//
+//   shared_bench [--json[=path]] [--filter=<text>] [--min-time-ms=<n>]
+
+namespace {
+wslmon::EventRecord make_record(std::uint64_t sequence) {
+    wslmon::EventRecord record{};
+    record.source = "bench";
+    record.category = "Journal";
+    record.severity = wslmon::Severity::Warning;
+    record.message = "systemd[1]: Stopping user@1000.service - User Manager for UID 1000...";
+    record.attributes.push_back({"unit", "user@1000.service"});
+    record.attributes.push_back({"pid", static_cast<std::uint64_t>(1234)});
+    record.attributes.push_back({"cursor", "s=4f1c;i=2a9;b=7e0;m=12ab;t=5f2;x=9c1"});
+    record.timestamp = std::chrono::system_clock::now();
+    record.sequence = sequence;
+    return record;
+}
+
+std::vector<wslmon::TimelineEvent> make_timeline(std::size_t count) {
+    const char *categories[] = {"Journal", "Journal", "Journal", "Resource", "Network", "ServiceHealth", "Process",
+                                "Kmsg"};
+    const wslmon::Symbol origins[] = {"host", "guest"};
+    std::mt19937 rng(42);
+    const auto base = std::chrono::system_clock::now() - std::chrono::hours(1);
+    std::vector<wslmon::TimelineEvent> timeline;
+    timeline.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        wslmon::EventRecord record{};
+        record.source = "bench";
+        record.category = categories[rng() % 8];
+        record.severity = static_cast<wslmon::Severity>(rng() % 6);
+        record.message = "Routine status line for unit " + std::to_string(rng() % 500);
+        record.attributes.push_back({"unit", "svc.service"});
+        record.timestamp = base + std::chrono::milliseconds(i * 50);
+        record.sequence = i;
+        timeline.push_back({origins[i % 2], std::move(record), std::string(64, 'a')});
+    }
+    return timeline;
+}
+
+// Worker threads that each run |work| once per Round(); Round() returns
+// when all of them have finished.
+class PushCrew {
+  public:
+    PushCrew(int workers, std::function<void()> work) : work_(std::move(work)) {
+        for (int i = 0; i < workers; ++i) {
+            threads_.emplace_back([this] { worker(); });
+        }
+    }
+
+    ~PushCrew() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        start_.notify_all();
+        for (auto &thread : threads_) {
+            thread.join();
+        }
+    }
+
+    void Round() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        remaining_ = threads_.size();
+        ++round_;
+        start_.notify_all();
+        done_.wait(lock, [this] { return remaining_ == 0; });
+    }
+
+  private:
+    void worker() {
+        std::uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_.wait(lock, [&] { return stopping_ || round_ != seen; });
+                if (stopping_) {
+                    return;
+                }
+                seen = round_;
+            }
+            work_();
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--remaining_ == 0) {
+                done_.notify_one();
+            }
+        }
+    }
+
+    std::function<void()> work_;
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    std::uint64_t round_ = 0;
+    std::size_t remaining_ = 0;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+};
+
+void bench_codec(wslmon::bench::BenchRunner &runner) {
+    const auto record = make_record(1);
+    std::string json;
+    runner.Run("event/serialize", 1000, [&](std::uint64_t) { wslmon::SerializeEvent(record, json); });
+
+    const std::string payload = wslmon::SerializeEvent(record);
+    wslmon::EventRecord parsed{};
+    runner.Run("event/deserialize", 1000, [&](std::uint64_t) { wslmon::DeserializeEvent(payload, parsed); });
+}
+
+void bench_crypto(wslmon::bench::BenchRunner &runner) {
+    const std::string small(64, 'x');
+    const std::string large(4096, 'x');
+    runner.Run("crypto/sha256_64", 1000, [&](std::uint64_t) { wslmon::Sha256(small); });
+    runner.Run("crypto/sha256_4k", 100, [&](std::uint64_t) { wslmon::Sha256(large); });
+
+    const std::vector<std::uint8_t> secret(32, 0x5A);
+    const wslmon::HmacKey key(secret);
+    const auto *bytes = reinterpret_cast<const std::uint8_t *>(small.data());
+    runner.Run("crypto/hmac_sha256_64", 1000,
+               [&](std::uint64_t) { wslmon::HmacSha256(key, bytes, small.size()); });
+
+    const auto digest = wslmon::Sha256(small);
+    std::string hex;
+    runner.Run("crypto/bytes_to_hex_32", 1000, [&](std::uint64_t) {
+        hex.clear();
+        wslmon::AppendHex(hex, digest.data(), digest.size());
+    });
+    runner.Run("crypto/bytes_to_hex_32_alloc", 1000,
+               [&](std::uint64_t) { wslmon::BytesToHex(digest.data(), digest.size()); });
+}
+
+void bench_ring_buffer(wslmon::bench::BenchRunner &runner) {
+    wslmon::RingBuffer<wslmon::EventRecord> uncontended(1024);
+    const auto record = make_record(1);
+    runner.Run("ring_buffer/push", 1000, [&](std::uint64_t) { uncontended.Push(record); });
+    runner.Run("ring_buffer/snapshot_1024", 10, [&](std::uint64_t) { uncontended.Snapshot(); });
+
+    // A poller that has seen all but the newest 16 entries.
+    const auto cursor = uncontended.SnapshotSince(0).next - 16;
+    runner.Run("ring_buffer/snapshot_since_16", 100, [&](std::uint64_t) { uncontended.SnapshotSince(cursor); });
+    std::size_t visited_bytes = 0;
+    runner.Run("ring_buffer/visit_since_16", 100, [&](std::uint64_t) {
+        uncontended.VisitSince(cursor, [&](std::uint64_t, const wslmon::EventRecord &entry) {
+            visited_bytes += entry.message.size();
+        });
+    });
+
+    // Each round has every producer push its share of 1024 records, so the
+    // reported time is the aggregate cost of 1024 pushes at that contention.
+    for (const int producers : {8, 16, 32}) {
+        wslmon::RingBuffer<wslmon::EventRecord> contended(1024);
+        PushCrew crew(producers, [&contended, per_producer = 1024 / producers] {
+            const auto local = make_record(2);
+            for (int i = 0; i < per_producer; ++i) {
+                contended.Push(local);
+            }
+        });
+        const std::string suffix = "_" + std::to_string(producers);
+        runner.Run("ring_buffer/push_x1024_contended" + suffix, 1, [&](std::uint64_t) { crew.Round(); });
+    }
+
+    // Pushers run for the duration of the measurement; the allocation count
+    // therefore includes their copies as well as the snapshots'.
+    wslmon::RingBuffer<wslmon::EventRecord> contended(1024);
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> pushers;
+    for (int t = 0; t < 8; ++t) {
+        pushers.emplace_back([&] {
+            const auto local = make_record(2);
+            while (!stop.load(std::memory_order_relaxed)) {
+                contended.Push(local);
+            }
+        });
+    }
+    runner.Run("ring_buffer/push_contended", 1000, [&](std::uint64_t) { contended.Push(record); });
+    runner.Run("ring_buffer/snapshot_contended", 10, [&](std::uint64_t) { contended.Snapshot(); });
+    stop = true;
+    for (auto &pusher : pushers) {
+        pusher.join();
+    }
+}
+
+void bench_priority_ring(wslmon::bench::BenchRunner &runner) {
+    wslmon::PriorityRing ring({512, 256, 256});
+    auto record = make_record(1);
+    const wslmon::Severity mix[] = {wslmon::Severity::Info, wslmon::Severity::Info, wslmon::Severity::Warning,
+                                    wslmon::Severity::Critical};
+    runner.Run("priority_ring/push", 1000, [&](std::uint64_t i) {
+        record.severity = mix[i % 4];
+        ring.Push(record);
+    });
+    runner.Run("priority_ring/snapshot_1024", 10, [&](std::uint64_t) { ring.Snapshot(); });
+}
+
+void bench_flight_recorder(wslmon::bench::BenchRunner &runner) {
+    // Steady state: every push also evicts the oldest record.
+    wslmon::FlightRecorderLimits limits;
+    limits.max_bytes = 1024 * wslmon::EventFootprint(make_record(1));
+    limits.budget_shares = {0, 1, 0};
+    wslmon::FlightRecorder recorder(limits);
+    const auto record = make_record(1);
+    runner.Run("flight_recorder/push", 1000, [&](std::uint64_t) { recorder.Push(record); });
+    runner.Run("flight_recorder/snapshot_1024", 10, [&](std::uint64_t) { recorder.Snapshot(); });
+}
+
+void bench_black_box(wslmon::bench::BenchRunner &runner) {
+    const auto path = std::filesystem::temp_directory_path() / "wslmon_shared_bench.ring";
+    wslmon::BlackBoxRing ring;
+    if (!ring.Open(path)) {
+        return;
+    }
+    const auto record = make_record(1);
+    runner.Run("black_box/append", 1000, [&](std::uint64_t) { ring.Append(record); });
+    ring.Close();
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
+
+void bench_logger(wslmon::bench::BenchRunner &runner) {
+    const auto log_dir = std::filesystem::temp_directory_path() / "wslmon_shared_bench";
+    std::error_code ec;
+    std::filesystem::remove_all(log_dir, ec);
+    std::filesystem::create_directories(log_dir, ec);
+    {
+        wslmon::JsonLogger logger(log_dir / "events.log", "bench");
+        runner.Run("logger/append", 100, [&](std::uint64_t i) { logger.Append(make_record(i)); });
+    }
+    std::filesystem::remove_all(log_dir, ec);
+    {
+        wslmon::LogCommitPolicy policy;
+        policy.group_commit = true;
+        wslmon::JsonLogger logger(log_dir / "events.log", "bench", policy);
+        // Producer-side cost only; the writer thread drains concurrently.
+        runner.Run("logger/append_group_commit", 100, [&](std::uint64_t i) { logger.Append(make_record(i)); });
+        logger.Flush();
+    }
+    std::filesystem::remove_all(log_dir, ec);
+    {
+        wslmon::LogCommitPolicy policy;
+        policy.preallocate_segments = true;
+        wslmon::JsonLogger logger(log_dir / "events.log", "bench", policy);
+        runner.Run("logger/append_preallocated", 100, [&](std::uint64_t i) { logger.Append(make_record(i)); });
+    }
+    std::filesystem::remove_all(log_dir, ec);
+}
+
+void bench_ipc(wslmon::bench::BenchRunner &runner) {
+#ifndef _WIN32
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        return;
+    }
+    const wslmon::IpcWriteFn write_fn = [&](const std::uint8_t *buffer, std::size_t bytes) {
+        while (bytes > 0) {
+            const ssize_t n = ::write(fds[0], buffer, bytes);
+            if (n <= 0) {
+                return false;
+            }
+            buffer += n;
+            bytes -= static_cast<std::size_t>(n);
+        }
+        return true;
+    };
+    const wslmon::IpcReadFn read_fn = [&](std::uint8_t *buffer, std::size_t bytes) {
+        while (bytes > 0) {
+            const ssize_t n = ::read(fds[1], buffer, bytes);
+            if (n <= 0) {
+                return false;
+            }
+            buffer += n;
+            bytes -= static_cast<std::size_t>(n);
+        }
+        return true;
+    };
+    const wslmon::HmacKey session(std::vector<std::uint8_t>(32, 0x5A));
+    const auto record = make_record(1);
+    wslmon::EventRecord received{};
+    // Send and receive alternate on one thread; a frame is far smaller than
+    // the socket buffer, so neither side blocks.
+    runner.Run("ipc/roundtrip_json", 100, [&](std::uint64_t) {
+        wslmon::IpcSendEvent(write_fn, session, record, wslmon::IpcPayloadEncoding::Json);
+        wslmon::IpcReceiveEvent(read_fn, session, received);
+    });
+    runner.Run("ipc/roundtrip_binary", 100, [&](std::uint64_t) {
+        wslmon::IpcSendEvent(write_fn, session, record, wslmon::IpcPayloadEncoding::Binary);
+        wslmon::IpcReceiveEvent(read_fn, session, received);
+    });
+    ::close(fds[0]);
+    ::close(fds[1]);
+#else
+    (void)runner;
+#endif
+}
+
+void bench_analyzer(wslmon::bench::BenchRunner &runner) {
+    const auto timeline = make_timeline(1000);
+    runner.Run("analyzer/timeline_1k", 1, [&](std::uint64_t) { wslmon::AnalyzeEventTimeline(timeline); });
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+    wslmon::bench::BenchRunner runner(argc, argv);
+    bench_codec(runner);
+    bench_crypto(runner);
+    bench_ring_buffer(runner);
+    bench_priority_ring(runner);
+    bench_flight_recorder(runner);
+    bench_black_box(runner);
+    bench_logger(runner);
+    bench_ipc(runner);
+    bench_analyzer(runner);
+    wslmon::bench::BenchEventDeserialize(runner);
+    wslmon::bench::BenchTimestamp(runner);
+    wslmon::bench::BenchJsonEscape(runner);
+    wslmon::bench::BenchEventBatch(runner);
+    wslmon::bench::BenchSha256(runner);
+    return runner.Finish();
+}
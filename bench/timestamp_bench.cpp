@@ -0,0 +1,88 @@
+#include "bench_harness.hpp"
+#include "bench_suites.hpp"
+
+#include "timestamp.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+using Clock = std::chrono::system_clock;
+
+// Stream-based implementations this module replaced, kept for comparison.
+std::string legacy_format(const Clock::time_point &tp) {
+    auto time_t_value = Clock::to_time_t(tp);
+    std::tm tm{};
+#ifdef _WIN32
+    gmtime_s(&tm, &time_t_value);
+#else
+    gmtime_r(&time_t_value, &tm);
+#endif
+    auto fractional = std::chrono::duration_cast<std::chrono::microseconds>(tp.time_since_epoch()).count() % 1000000;
+    std::ostringstream oss;
+    oss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%S");
+    oss << '.' << std::setw(6) << std::setfill('0') << fractional << "Z";
+    return oss.str();
+}
+
+bool legacy_parse(const std::string &ts, Clock::time_point &tp) {
+    std::tm parsed{};
+    std::istringstream ss(ts.substr(0, 19));
+    ss >> std::get_time(&parsed, "%Y-%m-%dT%H:%M:%S");
+    if (ss.fail()) {
+        return false;
+    }
+#ifdef _WIN32
+    std::time_t time_value = _mkgmtime(&parsed);
+#else
+    std::time_t time_value = timegm(&parsed);
+#endif
+    tp = Clock::from_time_t(time_value);
+    auto dot_pos = ts.find('.');
+    if (dot_pos != std::string::npos) {
+        auto frac = ts.substr(dot_pos + 1);
+        if (!frac.empty() && frac.back() == 'Z') {
+            frac.pop_back();
+        }
+        while (frac.size() < 6) {
+            frac.push_back('0');
+        }
+        tp += std::chrono::microseconds(std::stoll(frac.substr(0, 6)));
+    }
+    return true;
+}
+}  // namespace
+
+namespace wslmon::bench {
+
+void BenchTimestamp(BenchRunner &runner) {
+    // Timestamps 250us apart: a burst of events sharing each second, as the
+    // logger sees during a kmsg flood.
+    std::vector<Clock::time_point> points;
+    std::vector<std::string> texts;
+    points.reserve(4096);
+    texts.reserve(4096);
+    const auto base = Clock::time_point(std::chrono::microseconds(1700000000000000LL));
+    for (int i = 0; i < 4096; ++i) {
+        points.push_back(base + std::chrono::microseconds(250 * i));
+        texts.push_back(FormatTimestamp(points.back()));
+    }
+
+    std::string out;
+    runner.Run("timestamp/format_legacy", 1000,
+               [&](std::uint64_t i) { legacy_format(points[i % points.size()]); });
+    runner.Run("timestamp/format", 1000, [&](std::uint64_t i) {
+        out.clear();
+        AppendTimestamp(out, points[i % points.size()]);
+    });
+    Clock::time_point parsed;
+    runner.Run("timestamp/parse_legacy", 1000, [&](std::uint64_t i) { legacy_parse(texts[i % texts.size()], parsed); });
+    runner.Run("timestamp/parse", 1000, [&](std::uint64_t i) { ParseTimestamp(texts[i % texts.size()], parsed); });
+}
+
+}  // namespace wslmon::bench
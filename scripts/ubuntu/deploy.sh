@@ -53,7 +53,7 @@ prepare_directories() {
   echo "[deploy] Preparing log directory at ${LOG_DIR}"
   install -d -m 0750 -o root -g root "${LOG_DIR}"
 
-  echo "[deploy] Preparing chain state directory at ${CHAIN_STATE_DIR}"
+  echo "[deploy] Preparing chain state and black box directory at ${CHAIN_STATE_DIR}"
   install -d -m 0750 -o root -g root "${CHAIN_STATE_DIR}"
 
   echo "[deploy] Preparing IPC secret directory at ${SECRET_DIR}"
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+namespace wslmon {
+
+// Append-only file handle for the event log. Unlike std::ofstream it can
+// gather several buffers into one system call (writev on POSIX) and force
+// the data to stable storage (fdatasync / FlushFileBuffers).
+//
+// Opened with a preallocation size on POSIX, the file is instead reserved
+// with posix_fallocate and mapped, and writes are memory copies into the
+// mapping; the reservation grows by the same step when it runs out. Until
+// Close trims it, the file ends in NUL padding past size(), which readers
+// of a live segment must stop at. If the filesystem cannot reserve space
+// the file falls back to ordinary writes. Windows always uses writes.
+class AppendFile {
+  public:
+    AppendFile() = default;
+    ~AppendFile();
+    AppendFile(const AppendFile &) = delete;
+    AppendFile &operator=(const AppendFile &) = delete;
+
+    // Opens or creates |path| for appending; closes any open file first.
+    // The existing content must not end in padding from an earlier mapping.
+    bool Open(const std::filesystem::path &path, std::uint64_t preallocate = 0);
+    void Close();
+    [[nodiscard]] bool is_open() const;
+
+    // Appends |parts| in order. Returns false if the file is not open or a
+    // write failed; a partial write still advances size().
+    bool Write(const std::string_view *parts, std::size_t count);
+    bool Write(std::string_view data) { return Write(&data, 1); }
+
+    // Makes everything written so far durable.
+    bool Sync();
+
+    // Bytes written so far, excluding any preallocated padding.
+    [[nodiscard]] std::uint64_t size() const { return size_; }
+    [[nodiscard]] bool mapped() const;
+
+  private:
+#ifdef _WIN32
+    void *handle_ = nullptr;
+#else
+    bool map_capacity(std::uint64_t capacity);
+    // Unmaps and trims the padding; later writes go through writev.
+    void release_mapping();
+
+    int fd_ = -1;
+    unsigned char *map_ = nullptr;
+    std::uint64_t capacity_ = 0;
+    std::uint64_t preallocate_ = 0;
+    // Start of the mapped range not yet passed to msync.
+    std::uint64_t synced_ = 0;
+#endif
+    std::uint64_t size_ = 0;
+};
+
+}  // namespace wslmon
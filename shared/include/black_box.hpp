@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <vector>
+
+#include "event.hpp"
+
+namespace wslmon {
+
+class JsonLogger;
+
+// Crash-surviving flight recorder: a fixed-size file, memory-mapped, that
+// holds the most recent events in the binary event encoding. Append is a
+// memcpy into the mapping with no sync. When the daemon is killed, the
+// dirty pages stay in the page cache and reach the file anyway. Only
+// losing the whole guest kernel can lose them.
+//
+// Layout: a 4 KiB header page (magic, capacity, write cursor, and a flag
+// cleared by Close), then |capacity| bytes of records. Each record starts
+// with its total size, payload length, logical offset and a checksum. The
+// logical offset is the cursor value when the record was written, so a
+// stale record from an earlier lap never passes as current. After the
+// checksum comes the sequence the log gave the record, set by MarkLogged.
+// Records never straddle the end of the ring. The space left at the end
+// of a lap is covered by a padding record.
+//
+// If the previous process exited without Close, Open reads the records
+// that survived and never reached the log, in order, and then clears the
+// ring. TakeRecovered returns them.
+class BlackBoxRing {
+  public:
+    static constexpr std::size_t kDefaultCapacity = 1024 * 1024;
+    // Returned by Append when the record was not stored.
+    static constexpr std::uint64_t kNotRecorded = ~std::uint64_t{0};
+
+    // A record the log has written, by the offset Append returned.
+    struct LoggedRecord {
+        std::uint64_t offset;
+        std::uint64_t sequence;
+    };
+
+    BlackBoxRing() = default;
+    ~BlackBoxRing();
+    BlackBoxRing(const BlackBoxRing &) = delete;
+    BlackBoxRing &operator=(const BlackBoxRing &) = delete;
+
+    // Maps |path|, creating or resizing it as needed. A file in another
+    // format or with another capacity is reinitialized.
+    bool Open(const std::filesystem::path &path, std::size_t capacity = kDefaultCapacity);
+    // Unmaps the file and marks the shutdown as clean.
+    void Close();
+    [[nodiscard]] bool is_open() const { return view_ != nullptr; }
+
+    // Returns the record's logical offset, or kNotRecorded when the ring
+    // is not open or the encoding is larger than a quarter of the capacity.
+    std::uint64_t Append(const EventRecord &record);
+    // Stamps the given records with their log sequence so recovery skips
+    // them. Records already overwritten are left alone.
+    void MarkLogged(const LoggedRecord *records, std::size_t count);
+
+    // Events recovered by Open, oldest first; empties the list.
+    std::vector<EventRecord> TakeRecovered();
+
+  private:
+    void recover();
+    void reset(std::uint64_t head);
+    bool map(const std::filesystem::path &path, std::size_t file_size);
+    void unmap();
+
+    unsigned char *view_ = nullptr;
+    std::size_t view_size_ = 0;
+    std::uint64_t capacity_ = 0;
+    std::mutex mutex_;
+    std::vector<EventRecord> recovered_;
+};
+
+// Writes events recovered from a black box to |logger| as one batch: a
+// summary record followed by the events, each tagged with the attribute
+// recovered=blackbox. With the ring attached to the logger (see
+// JsonLogger::AttachBlackBox) these are only events the log never got.
+void LogRecoveredEvents(JsonLogger &logger, std::vector<EventRecord> events, Symbol source);
+
+}  // namespace wslmon
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+
+namespace wslmon {
+
+// Position of the hash chain in the live log segment.
+struct ChainState {
+    std::array<std::uint8_t, 32> chain{};
+    std::uint64_t next_sequence = 1;
+    std::uint64_t entries_since_rotation = 0;
+    // Log size the state accounts for; anything past it has to be replayed
+    // from the log.
+    std::uint64_t log_size = 0;
+    // ChainHashAlgorithm value.
+    std::uint8_t algorithm = 0;
+};
+
+// Memory-mapped page holding the latest ChainState. Two checksummed slots
+// are written alternately with increasing generations, so a torn update
+// leaves the previous one readable. Store touches only the mapping; the
+// kernel writes the page back on its own schedule, and callers treat the
+// log itself as the authority when the page lags.
+class ChainStateFile {
+  public:
+    ChainStateFile() = default;
+    ~ChainStateFile();
+    ChainStateFile(const ChainStateFile &) = delete;
+    ChainStateFile &operator=(const ChainStateFile &) = delete;
+
+    // Maps |path|, creating it or resizing it to one page. Content in any
+    // other format (such as the earlier text state) simply fails to Load.
+    bool Open(const std::filesystem::path &path);
+    void Close();
+    [[nodiscard]] bool is_open() const { return view_ != nullptr; }
+
+    // Reads the newest slot whose checksum verifies.
+    bool Load(ChainState &state);
+    // No-op when the file is not open.
+    void Store(const ChainState &state);
+
+  private:
+    unsigned char *view_ = nullptr;
+    std::uint64_t generation_ = 0;
+};
+
+}  // namespace wslmon
@@ -0,0 +1,21 @@
+#pragma once
+
+namespace wslmon {
+
+// Instruction-set extensions usable by runtime-dispatched code paths. A flag
+// is set only when both the CPU and the OS support it (e.g. AVX state saving
+// for avx2/avx512f).
+struct CpuFeatures {
+    bool sse41 = false;
+    bool ssse3 = false;
+    bool avx2 = false;
+    bool bmi2 = false;
+    bool avx512f = false;
+    bool sha = false;        // x86 SHA extensions (SHA-NI)
+    bool arm_sha2 = false;   // ARMv8 SHA-256 instructions
+};
+
+// Detected once on first use; later calls return the cached result.
+const CpuFeatures &GetCpuFeatures();
+
+}  // namespace wslmon
@@ -9,12 +9,177 @@
 
 namespace wslmon {
 
+// SHA-256 compression backends. Auto picks SHA-NI or the ARMv8 crypto
+// extension when the CPU has them and falls back to the portable scalar
+// code; the explicit values (including the vector-schedule Avx2 variant)
+// exist for tests and benchmarks.
+enum class Sha256Backend {
+    Auto,
+    Scalar,
+    Avx2,
+    ShaNi,
+    ArmV8,
+};
+
+Sha256Backend ActiveSha256Backend();
+// Whether |backend| is compiled in and usable on this CPU.
+bool Sha256BackendSupported(Sha256Backend backend);
+
+// Multi-buffer engines hash several independent messages at once, one per
+// SIMD lane (4 with SSE2, 8 with AVX2, 16 with AVX-512). Single runs the
+// messages one after another through the active Sha256Backend. Auto picks
+// AVX-512 when present, otherwise Single on CPUs with hardware SHA and the
+// widest lane engine elsewhere.
+enum class Sha256MultiBackend {
+    Auto,
+    Single,
+    Sse2,
+    Avx2,
+    Avx512,
+};
+
+Sha256MultiBackend ActiveSha256MultiBackend();
+bool Sha256MultiBackendSupported(Sha256MultiBackend backend);
+
 std::array<std::uint8_t, 32> Sha256(const std::uint8_t *data, std::size_t len);
+// Hashes with a specific backend; unsupported backends resolve to Auto.
+std::array<std::uint8_t, 32> Sha256(const std::uint8_t *data, std::size_t len, Sha256Backend backend);
 std::array<std::uint8_t, 32> Sha256(std::string_view data);
 std::vector<std::uint8_t> HmacSha256(const std::vector<std::uint8_t> &key,
                                      const std::uint8_t *data,
                                      std::size_t len);
+
+// Incremental SHA-256: feeding the input in pieces gives the same digest as
+// hashing the concatenation, without building it.
+class Sha256Context {
+  public:
+    Sha256Context();
+
+    void Update(const std::uint8_t *data, std::size_t len);
+    void Update(std::string_view data) {
+        Update(reinterpret_cast<const std::uint8_t *>(data.data()), data.size());
+    }
+    // Returns the digest and resets the context for reuse.
+    std::array<std::uint8_t, 32> Final();
+    void Reset();
+
+  private:
+    friend class HmacKey;
+    friend class HmacSha256Context;
+
+    // Resumes from a state reached after |consumed| bytes (a multiple of 64).
+    Sha256Context(const std::array<std::uint32_t, 8> &state, std::uint64_t consumed);
+
+    std::array<std::uint32_t, 8> state_;
+    std::array<std::uint8_t, 64> buffer_;
+    std::size_t buffer_len_ = 0;
+    std::uint64_t total_len_ = 0;
+};
+
+// HMAC key with the ipad/opad blocks already compressed, so a MAC under a
+// long-lived key (IPC session, log signing key) costs only its message
+// blocks. A default-constructed key is empty and must not be used to sign.
+class HmacKey {
+  public:
+    HmacKey() = default;
+    HmacKey(const std::uint8_t *key, std::size_t key_len);
+    explicit HmacKey(const std::vector<std::uint8_t> &key) : HmacKey(key.data(), key.size()) {}
+
+    [[nodiscard]] bool empty() const { return !valid_; }
+    void Clear();
+
+  private:
+    friend class HmacSha256Context;
+    friend struct HmacKeyAccess;
+
+    std::array<std::uint32_t, 8> inner_state_{};
+    std::array<std::uint32_t, 8> outer_state_{};
+    bool valid_ = false;
+};
+
+std::array<std::uint8_t, 32> HmacSha256(const HmacKey &key, const std::uint8_t *data, std::size_t len);
+
+// Writes the digest of messages[i] to digests[i]. Results are identical to
+// calling Sha256 / HmacSha256 on each message; unsupported backends resolve
+// to Auto.
+void Sha256Many(const std::string_view *messages,
+                std::size_t count,
+                std::array<std::uint8_t, 32> *digests,
+                Sha256MultiBackend backend = Sha256MultiBackend::Auto);
+void HmacSha256Many(const HmacKey &key,
+                    const std::string_view *messages,
+                    std::size_t count,
+                    std::array<std::uint8_t, 32> *macs,
+                    Sha256MultiBackend backend = Sha256MultiBackend::Auto);
+
+// Incremental HMAC-SHA256 over a message supplied in pieces.
+class HmacSha256Context {
+  public:
+    explicit HmacSha256Context(const HmacKey &key);
+    HmacSha256Context(const std::uint8_t *key, std::size_t key_len)
+        : HmacSha256Context(HmacKey(key, key_len)) {}
+    explicit HmacSha256Context(const std::vector<std::uint8_t> &key)
+        : HmacSha256Context(key.data(), key.size()) {}
+
+    void Update(const std::uint8_t *data, std::size_t len) { inner_.Update(data, len); }
+    void Update(std::string_view data) { inner_.Update(data); }
+    std::array<std::uint8_t, 32> Final();
+
+  private:
+    Sha256Context inner_;
+    Sha256Context outer_;
+};
+
+// BLAKE3 in plain hashing mode with a 32-byte output. Auto compresses
+// single blocks with SSE4.1 when available and hashes runs of whole 1 KiB
+// chunks in parallel lanes (4 with SSE2, 8 with AVX2, 16 with AVX-512);
+// the explicit values exist for tests and benchmarks.
+enum class Blake3Backend {
+    Auto,
+    Portable,
+    Sse41,
+    Avx2,
+    Avx512,
+};
+
+Blake3Backend ActiveBlake3Backend();
+bool Blake3BackendSupported(Blake3Backend backend);
+
+class Blake3Context {
+  public:
+    explicit Blake3Context(Blake3Backend backend = Blake3Backend::Auto);
+
+    void Update(const std::uint8_t *data, std::size_t len);
+    void Update(std::string_view data) {
+        Update(reinterpret_cast<const std::uint8_t *>(data.data()), data.size());
+    }
+    // Returns the digest and resets the context for reuse.
+    std::array<std::uint8_t, 32> Final();
+    void Reset();
+
+  private:
+    void update_chunk(const std::uint8_t *data, std::size_t len);
+    void push_chunk_cv(std::array<std::uint32_t, 8> cv, std::uint64_t total_chunks);
+    [[nodiscard]] std::size_t chunk_len() const { return blocks_compressed_ * 64 + block_len_; }
+
+    Blake3Backend backend_;
+    // Chaining values of completed subtrees, one per set bit of the chunk
+    // count; 54 levels cover the 2^64-byte input limit.
+    std::array<std::array<std::uint32_t, 8>, 54> cv_stack_;
+    std::size_t cv_stack_len_ = 0;
+    std::array<std::uint32_t, 8> chunk_cv_;
+    std::uint64_t chunk_counter_ = 0;
+    std::array<std::uint8_t, 64> block_;
+    std::size_t block_len_ = 0;
+    std::size_t blocks_compressed_ = 0;
+};
+
+std::array<std::uint8_t, 32> Blake3(const std::uint8_t *data, std::size_t len);
+std::array<std::uint8_t, 32> Blake3(std::string_view data);
+
 std::string BytesToHex(const std::uint8_t *data, std::size_t len);
+// Appends lowercase hex to |out| without a temporary string.
+void AppendHex(std::string &out, const std::uint8_t *data, std::size_t len);
 std::vector<std::uint8_t> HexToBytes(std::string_view hex);
 
 }  // namespace wslmon
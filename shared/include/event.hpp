@@ -2,29 +2,135 @@
 
 #include <chrono>
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
+#include "small_vector.hpp"
+#include "symbol.hpp"
+
 namespace wslmon {
 
+enum class Severity : std::uint8_t {
+    Unspecified,
+    Verbose,
+    Info,
+    Warning,
+    Error,
+    Critical,
+};
+
+// Serialized names ("Info", "Warning", ...); Unspecified maps to "".
+std::string_view SeverityName(Severity severity);
+// Unknown names map to Info, matching how analyzers bucket them.
+Severity ParseSeverity(std::string_view name);
+
+enum class AttributeType : std::uint8_t {
+    String,
+    Int64,
+    UInt64,
+    Double,
+};
+
+// Attribute payload: either text or a number kept in native form. Numbers
+// serialize exactly like std::to_string would have formatted them, so the
+// JSON schema is unchanged, but collectors skip the formatting and readers
+// skip the reparse. Decoded events always carry text; the as_* accessors
+// parse it on demand without throwing.
+class AttributeValue {
+  public:
+    AttributeValue() = default;
+    AttributeValue(std::string text) : text_(std::move(text)) {}
+    AttributeValue(std::string_view text) : text_(text) {}
+    AttributeValue(const char *text) : text_(text) {}
+    template <typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+                                               !std::is_same_v<T, char>,
+                                           int> = 0>
+    AttributeValue(T number) {
+        if constexpr (std::is_signed_v<T>) {
+            type_ = AttributeType::Int64;
+            number_.i64 = static_cast<std::int64_t>(number);
+        } else {
+            type_ = AttributeType::UInt64;
+            number_.u64 = static_cast<std::uint64_t>(number);
+        }
+    }
+    AttributeValue(double number) : type_(AttributeType::Double) { number_.f64 = number; }
+
+    [[nodiscard]] AttributeType type() const { return type_; }
+    [[nodiscard]] bool is_number() const { return type_ != AttributeType::String; }
+    // Numbers are never empty: they always format to at least one digit.
+    [[nodiscard]] bool empty() const { return !is_number() && text_.empty(); }
+
+    // Text payload; empty for numeric values.
+    [[nodiscard]] std::string_view text() const { return text_; }
+    // Switches the value to text and returns the buffer for in-place decoding.
+    std::string &assign_text();
+
+    [[nodiscard]] std::optional<std::int64_t> as_int64() const;
+    [[nodiscard]] std::optional<std::uint64_t> as_uint64() const;
+    [[nodiscard]] std::optional<double> as_double() const;
+
+    // Appends the serialized form (text, or the formatted number).
+    void AppendTo(std::string &out) const;
+    [[nodiscard]] std::string str() const;
+
+    // Equality is by serialized text, so 4 == "4" but 4 != "4.0".
+    [[nodiscard]] bool equals(std::string_view text) const;
+    [[nodiscard]] bool equals(const AttributeValue &other) const;
+
+    friend bool operator==(const AttributeValue &lhs, const AttributeValue &rhs) { return lhs.equals(rhs); }
+    friend bool operator!=(const AttributeValue &lhs, const AttributeValue &rhs) { return !lhs.equals(rhs); }
+    friend bool operator==(const AttributeValue &lhs, std::string_view rhs) { return lhs.equals(rhs); }
+    friend bool operator!=(const AttributeValue &lhs, std::string_view rhs) { return !lhs.equals(rhs); }
+    friend bool operator==(std::string_view lhs, const AttributeValue &rhs) { return rhs.equals(lhs); }
+    friend bool operator!=(std::string_view lhs, const AttributeValue &rhs) { return !rhs.equals(lhs); }
+    friend bool operator==(const AttributeValue &lhs, const char *rhs) { return lhs.equals(std::string_view(rhs)); }
+    friend bool operator!=(const AttributeValue &lhs, const char *rhs) { return !lhs.equals(std::string_view(rhs)); }
+    friend bool operator==(const char *lhs, const AttributeValue &rhs) { return rhs.equals(std::string_view(lhs)); }
+    friend bool operator!=(const char *lhs, const AttributeValue &rhs) { return !rhs.equals(std::string_view(lhs)); }
+    friend bool operator==(const AttributeValue &lhs, const std::string &rhs) { return lhs.equals(std::string_view(rhs)); }
+    friend bool operator!=(const AttributeValue &lhs, const std::string &rhs) { return !lhs.equals(std::string_view(rhs)); }
+    friend bool operator==(const std::string &lhs, const AttributeValue &rhs) { return rhs.equals(std::string_view(lhs)); }
+    friend bool operator!=(const std::string &lhs, const AttributeValue &rhs) { return !rhs.equals(std::string_view(lhs)); }
+
+  private:
+    AttributeType type_ = AttributeType::String;
+    union {
+        std::int64_t i64;
+        std::uint64_t u64;
+        double f64;
+    } number_{};
+    std::string text_;
+};
+
 struct EventAttribute {
-    std::string key;
-    std::string value;
+    Symbol key;
+    AttributeValue value;
 };
 
+// Collectors attach 3-8 attributes per event; keys are Symbols and most
+// values fit the std::string small-buffer, so typical records need no
+// attribute allocations at all.
+constexpr std::size_t kInlineEventAttributes = 8;
+using EventAttributeList = SmallVector<EventAttribute, kInlineEventAttributes>;
+
 struct EventRecord {
-    std::string source;
-    std::string category;
-    std::string severity;
+    Symbol source;
+    Symbol category;
+    Severity severity = Severity::Unspecified;
     std::string message;
-    std::vector<EventAttribute> attributes;
+    EventAttributeList attributes;
     std::chrono::system_clock::time_point timestamp;
     std::uint64_t sequence;
 };
 
 std::string SerializeEvent(const EventRecord &record);
+// Appends the JSON encoding of |record| to |out| without clearing it, so a
+// caller that reuses |out| serializes without heap allocations.
+void SerializeEvent(const EventRecord &record, std::string &out);
 bool DeserializeEvent(std::string_view json, EventRecord &record);
 
 }  // namespace wslmon
-
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "event.hpp"
+#include "event_view.hpp"
+
+namespace wslmon {
+
+// Column-oriented store for analysis passes. The fields every pass reads
+// (timestamp, origin, category, severity) live in their own contiguous
+// arrays; messages and attribute values sit in two text pools addressed by
+// offsets, so scanning a million events touches a few flat arrays instead
+// of a million EventRecords.
+class EventBatch {
+  public:
+    using TimePoint = std::chrono::system_clock::time_point;
+
+    void Reserve(std::size_t events, std::size_t attributes = 0);
+    void Clear();
+
+    void Append(Symbol origin, const EventRecord &record);
+    void Append(Symbol origin, const EventView &view);
+
+    [[nodiscard]] std::size_t size() const { return timestamps_.size(); }
+    [[nodiscard]] bool empty() const { return timestamps_.empty(); }
+
+    [[nodiscard]] const std::vector<TimePoint> &timestamps() const { return timestamps_; }
+    [[nodiscard]] const std::vector<Symbol> &origins() const { return origins_; }
+    [[nodiscard]] const std::vector<Symbol> &categories() const { return categories_; }
+    [[nodiscard]] const std::vector<Severity> &severities() const { return severities_; }
+
+    [[nodiscard]] Symbol source(std::size_t index) const { return sources_[index]; }
+    [[nodiscard]] std::uint64_t sequence(std::size_t index) const { return sequences_[index]; }
+    [[nodiscard]] std::string_view message(std::size_t index) const {
+        return slice(messages_, message_offsets_[index], message_offsets_[index + 1]);
+    }
+
+    // Attributes of event |index| occupy [attribute_begin, attribute_end) in
+    // the attribute pool.
+    [[nodiscard]] std::size_t attribute_begin(std::size_t index) const { return attribute_offsets_[index]; }
+    [[nodiscard]] std::size_t attribute_end(std::size_t index) const { return attribute_offsets_[index + 1]; }
+    [[nodiscard]] Symbol attribute_key(std::size_t attribute) const { return attribute_keys_[attribute]; }
+    [[nodiscard]] std::string_view attribute_value(std::size_t attribute) const {
+        return slice(values_, value_offsets_[attribute], value_offsets_[attribute + 1]);
+    }
+
+    void Materialize(std::size_t index, EventRecord &record) const;
+
+  private:
+    [[nodiscard]] static std::string_view slice(const std::string &pool, std::size_t begin, std::size_t end) {
+        return std::string_view(pool).substr(begin, end - begin);
+    }
+    void finish_event(Symbol origin, Symbol source, Symbol category, Severity severity, TimePoint timestamp,
+                      std::uint64_t sequence);
+
+    std::vector<TimePoint> timestamps_;
+    std::vector<Symbol> origins_;
+    std::vector<Symbol> categories_;
+    std::vector<Severity> severities_;
+    std::vector<Symbol> sources_;
+    std::vector<std::uint64_t> sequences_;
+    std::vector<std::size_t> message_offsets_{0};
+    std::vector<std::size_t> attribute_offsets_{0};
+    std::vector<Symbol> attribute_keys_;
+    std::vector<std::size_t> value_offsets_{0};
+    std::string messages_;
+    std::string values_;
+};
+
+}  // namespace wslmon
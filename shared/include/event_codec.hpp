@@ -0,0 +1,92 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include "event.hpp"
+
+namespace wslmon {
+
+// Compact binary encoding of EventRecord, used where the JSON schema is too
+// expensive (bridge frames, high-rate buffers). Layout, version 1:
+//
+//   u8     magic (0xEB)
+//   u8     version
+//   i64le  timestamp, microseconds since the Unix epoch
+//   varint sequence
+//   str    source, category, severity, message
+//   varint attribute count, followed by (str key, str value) pairs
+//
+// where str is a varint byte length followed by the raw UTF-8 bytes.
+constexpr std::uint8_t kEventCodecMagic = 0xEB;
+constexpr std::uint8_t kEventCodecVersion = 1;
+
+struct EventAttributeView {
+    std::string_view key;
+    std::string_view value;
+};
+
+// Read-only view over an encoded record. All string_views point into the
+// buffer passed to DecodeEventBinary, which must outlive the view.
+class EventRecordView {
+  public:
+    class AttributeIterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = EventAttributeView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const EventAttributeView *;
+        using reference = const EventAttributeView &;
+
+        AttributeIterator() = default;
+        AttributeIterator(std::string_view table, std::size_t remaining);
+
+        reference operator*() const { return current_; }
+        pointer operator->() const { return &current_; }
+        AttributeIterator &operator++();
+        AttributeIterator operator++(int) {
+            AttributeIterator copy = *this;
+            ++*this;
+            return copy;
+        }
+        bool operator==(const AttributeIterator &other) const { return remaining_ == other.remaining_; }
+        bool operator!=(const AttributeIterator &other) const { return remaining_ != other.remaining_; }
+
+      private:
+        void load();
+
+        std::string_view table_;
+        std::size_t remaining_ = 0;
+        EventAttributeView current_;
+    };
+
+    std::string_view source;
+    std::string_view category;
+    std::string_view severity;
+    std::string_view message;
+    std::chrono::system_clock::time_point timestamp{};
+    std::uint64_t sequence = 0;
+
+    [[nodiscard]] std::size_t attribute_count() const { return attribute_count_; }
+    [[nodiscard]] AttributeIterator begin() const { return AttributeIterator(attribute_table_, attribute_count_); }
+    [[nodiscard]] AttributeIterator end() const { return AttributeIterator(); }
+
+  private:
+    friend bool DecodeEventBinary(std::string_view data, EventRecordView &view);
+
+    std::string_view attribute_table_;
+    std::size_t attribute_count_ = 0;
+};
+
+// Appends the binary encoding of |record| to |out|.
+void EncodeEventBinary(const EventRecord &record, std::string &out);
+// Validates |data| and points |view| into it without copying.
+bool DecodeEventBinary(std::string_view data, EventRecordView &view);
+bool DecodeEventBinary(std::string_view data, EventRecord &record);
+void MaterializeEvent(const EventRecordView &view, EventRecord &record);
+
+}  // namespace wslmon
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "event.hpp"
+
+namespace wslmon {
+
+// Bump allocator backing EventViews. Memory is released only when the arena
+// is destroyed, so every view parsed from it stays valid for the arena's
+// lifetime. Not thread-safe.
+class EventArena {
+  public:
+    explicit EventArena(std::size_t chunk_size = 1 << 20);
+    EventArena(const EventArena &) = delete;
+    EventArena &operator=(const EventArena &) = delete;
+
+    // Copies |text| into the arena and returns a view of the copy.
+    std::string_view Store(std::string_view text);
+
+    template <typename T>
+    T *AllocateArray(std::size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "arena memory is never destroyed");
+        return static_cast<T *>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    [[nodiscard]] std::size_t bytes_used() const { return bytes_used_; }
+
+  private:
+    void *allocate(std::size_t size, std::size_t alignment);
+
+    std::size_t chunk_size_;
+    std::vector<std::unique_ptr<unsigned char[]>> chunks_;
+    unsigned char *cursor_ = nullptr;
+    std::size_t remaining_ = 0;
+    std::size_t bytes_used_ = 0;
+};
+
+// Body of a JSON string literal as it appears in the source text. Escape
+// sequences are decoded only when str() or AppendTo() is called.
+class JsonStringView {
+  public:
+    JsonStringView() = default;
+    JsonStringView(std::string_view raw, bool escaped) : raw_(raw), escaped_(escaped) {}
+
+    [[nodiscard]] std::string_view raw() const { return raw_; }
+    [[nodiscard]] bool has_escapes() const { return escaped_; }
+    [[nodiscard]] bool empty() const { return raw_.empty(); }
+
+    [[nodiscard]] std::string str() const;
+    void AppendTo(std::string &out) const;
+
+  private:
+    std::string_view raw_;
+    bool escaped_ = false;
+};
+
+struct EventViewAttribute {
+    Symbol key;
+    JsonStringView value;
+};
+
+// Read-only counterpart of EventRecord for bulk analysis. Vocabulary fields
+// are interned; message and attribute values point into the JSON passed to
+// ParseEventView, which must outlive the view.
+struct EventView {
+    std::string_view json;
+    Symbol source;
+    Symbol category;
+    Severity severity = Severity::Unspecified;
+    JsonStringView message;
+    const EventViewAttribute *attributes = nullptr;
+    std::size_t attribute_count = 0;
+    std::chrono::system_clock::time_point timestamp{};
+    std::uint64_t sequence = 0;
+
+    [[nodiscard]] const EventViewAttribute *begin() const { return attributes; }
+    [[nodiscard]] const EventViewAttribute *end() const { return attributes + attribute_count; }
+};
+
+// Parses the JSON produced by SerializeEvent without copying strings. The
+// attribute table is allocated from |arena|. Returns false on malformed
+// input or a missing timestamp, like DeserializeEvent.
+bool ParseEventView(std::string_view json, EventArena &arena, EventView &view);
+void MaterializeEvent(const EventView &view, EventRecord &record);
+
+}  // namespace wslmon
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "event.hpp"
+#include "priority_ring.hpp"
+
+namespace wslmon {
+
+// How much recent history a FlightRecorder keeps: everything that arrived
+// within |horizon|, but no more than |max_bytes| of record storage.
+// |budget_shares| splits max_bytes among the EventPriority partitions. By
+// default routine records get half and warnings and errors a quarter
+// each.
+struct FlightRecorderLimits {
+    std::chrono::milliseconds horizon{std::chrono::seconds(120)};
+    std::size_t max_bytes = 8 * 1024 * 1024;
+    std::array<std::size_t, kEventPriorityCount> budget_shares{2, 1, 1};
+};
+
+// Memory |record| accounts for in a FlightRecorder: the record itself plus
+// the heap storage owned by its message, attribute list and attribute
+// values. Strings short enough for the small-string buffer cost nothing
+// extra.
+std::size_t EventFootprint(const EventRecord &record);
+
+// In-memory history of the events leading up to now. Unlike a fixed-count
+// ring, a flood of small records cannot push the recent past out faster
+// than the byte budget allows, and on a quiet system nothing older than
+// the horizon is kept. Each EventPriority has its own share of the budget,
+// so a routine flood evicts only routine records. Each partition is kept
+// in arrival order and evicts from its front only, so eviction is O(1)
+// per evicted record.
+class FlightRecorder {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit FlightRecorder(FlightRecorderLimits limits = {});
+
+    void Push(EventRecord record) { Push(std::move(record), Clock::now()); }
+    void Push(EventRecord record, Clock::time_point arrived);
+
+    // Records still inside the horizon from all partitions, oldest first.
+    std::vector<EventRecord> Snapshot() const { return Snapshot(Clock::now()); }
+    std::vector<EventRecord> Snapshot(Clock::time_point now) const;
+
+    struct PartitionUsage {
+        EventPriority priority;
+        std::size_t entries;
+        std::size_t bytes;
+        std::size_t budget;
+    };
+
+    std::size_t size() const;
+    // Sum of EventFootprint over the records held.
+    std::size_t bytes() const;
+    std::array<PartitionUsage, kEventPriorityCount> usage() const;
+
+  private:
+    struct Entry {
+        Clock::time_point arrived;
+        std::uint64_t arrival_index;
+        std::size_t bytes;
+        EventRecord record;
+    };
+    struct Partition {
+        std::deque<Entry> entries;
+        std::size_t bytes = 0;
+        std::size_t budget = 0;
+    };
+
+    void evict_locked(Partition &pushed, Clock::time_point now);
+
+    FlightRecorderLimits limits_;
+    mutable std::mutex mutex_;
+    std::array<Partition, kEventPriorityCount> partitions_;
+    std::uint64_t next_arrival_ = 0;
+};
+
+}  // namespace wslmon
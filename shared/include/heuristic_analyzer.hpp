@@ -2,20 +2,31 @@
 
 #include <chrono>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "event.hpp"
+#include "event_batch.hpp"
+#include "event_view.hpp"
 
 namespace wslmon {
 
 struct TimelineEvent {
-    std::string origin;
+    Symbol origin;
     EventRecord record;
     std::string chain_hash;
 };
 
+// Zero-copy timeline entry for bulk analysis; the event and chain hash point
+// into storage owned by the caller (typically an EventArena).
+struct TimelineEventView {
+    Symbol origin;
+    EventView event;
+    std::string_view chain_hash;
+};
+
 struct HeuristicSupportingEvent {
-    std::string origin;
+    Symbol origin;
     EventRecord record;
 };
 
@@ -45,5 +56,15 @@ struct CrossChannelHealthSnapshot {
 std::vector<HeuristicInsight> AnalyzeEventTimeline(const std::vector<TimelineEvent> &events);
 CrossChannelHealthSnapshot ComputeCrossChannelSnapshot(const std::vector<TimelineEvent> &events);
 
+// View-based overloads with identical results. Only the events selected as
+// supporting evidence are materialized into EventRecords.
+std::vector<HeuristicInsight> AnalyzeEventTimeline(const std::vector<TimelineEventView> &events);
+CrossChannelHealthSnapshot ComputeCrossChannelSnapshot(const std::vector<TimelineEventView> &events);
+
+// Columnar overloads with identical results; |events| carries the origin of
+// each row in its origin column.
+std::vector<HeuristicInsight> AnalyzeEventTimeline(const EventBatch &events);
+CrossChannelHealthSnapshot ComputeCrossChannelSnapshot(const EventBatch &events);
+
 }  // namespace wslmon
 
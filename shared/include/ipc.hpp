@@ -7,6 +7,7 @@
 #include <string_view>
 #include <vector>
 
+#include "crypto.hpp"
 #include "event.hpp"
 
 namespace wslmon {
@@ -19,19 +20,27 @@ std::array<std::uint8_t, 32> GenerateNonce();
 bool IpcServerHandshake(const IpcWriteFn &write_fn,
                         const IpcReadFn &read_fn,
                         const std::vector<std::uint8_t> &shared_secret,
-                        std::vector<std::uint8_t> &session_key);
+                        HmacKey &session_key);
 
 bool IpcClientHandshake(const IpcWriteFn &write_fn,
                         const IpcReadFn &read_fn,
                         const std::vector<std::uint8_t> &shared_secret,
-                        std::vector<std::uint8_t> &session_key);
+                        HmacKey &session_key);
+
+// Event frames carry either the JSON schema or the binary codec from
+// event_codec.hpp; IpcReceiveEvent accepts both.
+enum class IpcPayloadEncoding : std::uint8_t {
+    Json = 1,
+    Binary = 2,
+};
 
 bool IpcSendEvent(const IpcWriteFn &write_fn,
-                  const std::vector<std::uint8_t> &session_key,
-                  const EventRecord &record);
+                  const HmacKey &session_key,
+                  const EventRecord &record,
+                  IpcPayloadEncoding encoding = IpcPayloadEncoding::Json);
 
 bool IpcReceiveEvent(const IpcReadFn &read_fn,
-                     const std::vector<std::uint8_t> &session_key,
+                     const HmacKey &session_key,
                      EventRecord &out_record);
 
 }  // namespace wslmon
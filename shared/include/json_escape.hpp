@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace wslmon {
+
+// Implementations of the scan for the next byte that needs escaping in a JSON
+// string ('"', '\\' or a control character). Auto picks the widest one the
+// CPU supports; the others exist so tests can compare them directly.
+enum class JsonEscapeScanner {
+    Auto,
+    Scalar,
+    Sse2,
+    Avx2,
+};
+
+// Returns the scanner Auto resolves to on this machine.
+JsonEscapeScanner ActiveJsonEscapeScanner();
+// Whether |scanner| can run on this machine. Scalar and Auto always can.
+bool JsonEscapeScannerSupported(JsonEscapeScanner scanner);
+
+// Index of the first byte at or after |from| that needs escaping, or
+// input.size() if there is none.
+std::size_t FindJsonEscape(std::string_view input, std::size_t from = 0,
+                           JsonEscapeScanner scanner = JsonEscapeScanner::Auto);
+
+// Appends |input| to |out| with JSON string escaping applied. Clean runs are
+// copied in bulk; '"', '\\', \n, \r and \t use short escapes and any other
+// control character is written as \u00XX.
+void AppendJsonEscaped(std::string &out, std::string_view input,
+                       JsonEscapeScanner scanner = JsonEscapeScanner::Auto);
+
+}  // namespace wslmon
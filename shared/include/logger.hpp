@@ -1,40 +1,179 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
-#include <fstream>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
+#include "append_file.hpp"
+#include "black_box.hpp"
+#include "chain_state_file.hpp"
+#include "crypto.hpp"
 #include "event.hpp"
 
 namespace wslmon {
 
+// Hash linking consecutive records. Each segment declares its algorithm in
+// the .chainstate file and the rotation manifest; files written before the
+// declaration existed are SHA-256, which stays the default. BLAKE3 is
+// several times faster on CPUs without SHA extensions and is selected with
+// WSLMON_LOG_CHAIN_HASH=blake3.
+enum class ChainHashAlgorithm : std::uint8_t {
+    Sha256,
+    Blake3,
+};
+
+const char *ChainHashAlgorithmName(ChainHashAlgorithm algorithm);
+// Accepts the names written by ChainHashAlgorithmName.
+bool ParseChainHashAlgorithm(std::string_view name, ChainHashAlgorithm &algorithm);
+
+// How JsonLogger gets records onto disk. Synchronous mode writes each
+// record inside Append. Group commit hands records to a writer thread that
+// assigns sequences, extends the chain and writes everything queued in one
+// gathered write, then persists the chain state once per batch. Data is
+// synced when |max_latency| has passed or |max_unsynced_bytes| have built up
+// since the last sync. Critical records are synced at once, and Append
+// returns only after they are durable.
+//
+// With preallocate_segments, each segment is reserved at its full size and
+// written through a memory mapping (see AppendFile), so appending a record
+// costs no system call. The chain state page holds the write cursor, and
+// the padding is trimmed at rotation, at shutdown, or by recovery after a
+// crash.
+struct LogCommitPolicy {
+    bool group_commit = false;
+    std::chrono::milliseconds max_latency{50};
+    std::size_t max_unsynced_bytes = 256 * 1024;
+    bool preallocate_segments = false;
+};
+
 class JsonLogger {
   public:
-    explicit JsonLogger(std::filesystem::path log_path, std::string default_source);
+    explicit JsonLogger(std::filesystem::path log_path,
+                        std::string default_source,
+                        LogCommitPolicy policy = {});
+    ~JsonLogger();
+    JsonLogger(const JsonLogger &) = delete;
+    JsonLogger &operator=(const JsonLogger &) = delete;
 
     void Append(const EventRecord &record);
     void Rotate();
-    [[nodiscard]] const std::string &CurrentChainHash() const { return current_chain_hash_; }
+    // Returns once every record appended before the call is on stable
+    // storage.
+    void Flush();
+    // Hex form of the running chain digest, as written to the log. Under
+    // group commit, this waits for queued records first.
+    [[nodiscard]] std::string CurrentChainHash();
+    // Algorithm of the current segment. A configuration change takes effect
+    // at the next rotation so a segment never mixes algorithms.
+    [[nodiscard]] ChainHashAlgorithm CurrentChainHashAlgorithm();
+    // Copies each record into |ring| as it is appended, and stamps it there
+    // with its sequence once its line has been synced. Recovery after a
+    // crash then returns only what the log never got. Null detaches; the ring must
+    // outlive the logger's use of it.
+    void AttachBlackBox(BlackBoxRing *ring);
 
   private:
-    void open_stream();
+    struct PendingEntry;
+    struct CommitWaiter;
+
+    void open_file();
+    // Restores the chain position from the state page, replaying log lines
+    // the page does not cover.
     void load_chain_state();
+    void recover_chain_state(const ChainState *state, std::string text);
+    // Copies |tail|, the bytes found at |log_offset| behind a zeroed gap,
+    // to <log>.gap-<timestamp> with a manifest sealing its SHA-256 (and HMAC
+    // when a key is set), and syncs both. Returns false if either could not
+    // be made durable.
+    bool seal_gap_segment(std::uint64_t log_offset, std::string_view tail);
     void persist_chain_state();
     void ensure_directory_hardening();
-    std::string format_timestamp_utc() const;
+    // Formats |record| as a complete log line in |line|, advancing the
+    // sequence and chain, and returns the record's sequence. Requires mutex_.
+    std::uint64_t format_line(const EventRecord &record, std::chrono::system_clock::time_point now, std::string &line);
+    void rotate_locked();
+    // Syncs the log, then stamps the black box records it now covers.
+    // Requires mutex_.
+    void sync_locked();
+    void enqueue(PendingEntry *entry);
+    void wait_for_writer(PendingEntry *entry);
+    void writer_loop();
 
     std::filesystem::path log_path_;
     std::filesystem::path chain_state_path_;
-    std::ofstream stream_;
+    AppendFile file_;
+    ChainStateFile state_file_;
     std::mutex mutex_;
-    std::string default_source_;
-    std::vector<std::uint8_t> hmac_key_;
-    std::string current_chain_hash_;
+    Symbol default_source_;
+    HmacKey hmac_key_;
+    ChainHashAlgorithm configured_chain_algorithm_;
+    ChainHashAlgorithm chain_algorithm_;
+    // Kept binary; converted to hex only when a line or the state file is
+    // written.
+    std::array<std::uint8_t, 32> current_chain_{};
+    std::string line_buffer_;
     std::uint64_t next_sequence_ = 1;
     std::uint64_t entries_since_rotation_ = 0;
+
+    LogCommitPolicy policy_;
+    std::atomic<BlackBoxRing *> black_box_{nullptr};
+    // Black box records whose lines are written but not yet synced. They
+    // are stamped only after the sync: a stamp reaching disk ahead of the
+    // line would hide the event from recovery after a VM kill.
+    std::vector<BlackBoxRing::LoggedRecord> unsynced_logged_;
+    // Producers push onto this list head without locking; the writer takes
+    // the whole list at once and reverses it into arrival order.
+    std::atomic<PendingEntry *> pending_{nullptr};
+    std::atomic<bool> stopping_{false};
+    // Only used to park the writer while the list is empty.
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    // Writer-owned line buffers, reused across batches.
+    std::vector<std::string> batch_lines_;
+    std::thread writer_;
 };
 
+// Outcome of checking the per-record "hmac" fields of a JsonLogger log.
+struct RecordHmacReport {
+    std::size_t records = 0;
+    // Zero-based line numbers whose MAC is missing, malformed or wrong.
+    std::vector<std::size_t> failed_lines;
+
+    [[nodiscard]] bool ok() const { return failed_lines.empty(); }
+};
+
+// Verifies every record in |log_text| (a live log or rotated segment)
+// against |key|. Record MACs are independent of each other, so they are
+// computed in batches on the multi-buffer SHA-256 engine.
+RecordHmacReport VerifyRecordHmacs(std::string_view log_text, const HmacKey &key);
+
+struct ChainReport {
+    std::size_t records = 0;
+    // First zero-based line whose chainHash does not follow from the line
+    // before it.
+    std::optional<std::size_t> first_broken_line;
+    // Recomputed hash after the last record, comparable with the manifest's
+    // finalChainHash.
+    std::string final_chain_hash;
+
+    [[nodiscard]] bool ok() const { return !first_broken_line; }
+};
+
+// Recomputes the hash chain of a log segment from the all-zero start.
+ChainReport VerifyChain(std::string_view log_text, ChainHashAlgorithm algorithm);
+// Reads the algorithm a rotation manifest declares; manifests without the
+// field are SHA-256. Returns false for an unknown algorithm.
+bool ReadManifestChainHashAlgorithm(std::string_view manifest_text, ChainHashAlgorithm &algorithm);
+
 }  // namespace wslmon
 
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace wslmon {
+
+// Read-only mapping of a whole file, for scanning log segments without
+// copying them through a stream. An empty file maps to an empty view.
+//
+// A file ending in NUL is taken for a live preallocated segment. Its
+// writer trims the padding when it rotates or stops, and touching a mapped
+// page past the new end raises SIGBUS. Such a file is read with pread
+// into a buffer instead, up to wherever it ends by then.
+class MappedFile {
+  public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool Open(const std::filesystem::path &path);
+    void Close();
+
+    // The file's bytes; a live preallocated log segment ends in NUL
+    // padding.
+    [[nodiscard]] std::string_view view() const { return {data_, size_}; }
+
+  private:
+#ifndef _WIN32
+    bool read_all(int fd, std::size_t size);
+#endif
+
+    const char *data_ = nullptr;
+    std::size_t size_ = 0;
+    // Holds the bytes of a file that was read rather than mapped.
+    std::string buffer_;
+};
+
+}  // namespace wslmon
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "event.hpp"
+#include "ring_buffer.hpp"
+
+namespace wslmon {
+
+// Eviction classes for in-memory event history. Each class gets its own
+// reservation, so a burst of routine records cannot evict the warnings,
+// errors and crashes that explain a shutdown.
+enum class EventPriority : std::uint8_t {
+    Routine,   // Unspecified, Verbose, Info
+    Elevated,  // Warning
+    Urgent,    // Error, Critical
+};
+constexpr std::size_t kEventPriorityCount = 3;
+
+EventPriority PriorityOf(Severity severity);
+const char *EventPriorityName(EventPriority priority);
+
+// Event ring split into one RingBuffer per EventPriority. Each partition
+// overwrites only its own oldest entries. Every push takes an arrival
+// stamp, and Snapshot returns all partitions together in arrival order.
+class PriorityRing {
+  public:
+    struct Occupancy {
+        EventPriority priority;
+        std::size_t size;
+        std::size_t capacity;
+    };
+
+    // Slots per partition, indexed by EventPriority.
+    explicit PriorityRing(const std::array<std::size_t, kEventPriorityCount> &capacities);
+
+    void Push(EventRecord record);
+    std::vector<EventRecord> Snapshot() const;
+    std::array<Occupancy, kEventPriorityCount> occupancy() const;
+
+  private:
+    struct Stamped {
+        std::uint64_t arrival = 0;
+        EventRecord record{};
+    };
+
+    std::array<std::size_t, kEventPriorityCount> capacities_;
+    std::array<std::unique_ptr<RingBuffer<Stamped>>, kEventPriorityCount> partitions_;
+    std::atomic<std::uint64_t> next_arrival_{0};
+};
+
+}  // namespace wslmon
@@ -1,53 +1,162 @@
 #pragma once
 
+#include <atomic>
 #include <cstddef>
-#include <mutex>
-#include <optional>
+#include <cstdint>
+#include <memory>
+#include <thread>
 #include <vector>
 
 namespace wslmon {
 
+// Bounded multi-producer ring that overwrites its oldest entry when full.
+//
+// Push claims a ticket with one fetch_add on the head counter. The slot for
+// ticket t is t % capacity, and the slot's sequence stamp says which ticket
+// it holds: 2 * (t + 1) once ticket t is committed, odd while a writer or
+// reader holds the slot. A writer waits only for the previous occupant of
+// its own slot, so producers never contend on a shared lock. Readers pin
+// one slot at a time while they copy, so they never stop writers as a
+// whole.
+//
+// Tickets double as sequence numbers, so a polling reader can keep a
+// cursor and fetch only what is new. Reads return entries in ticket order.
+// They skip entries that were overwritten while they ran, and they stop at
+// the first ticket whose writer has not committed yet. That way a read
+// never leaves a hole that a later read from the same cursor would fill.
 template <typename T>
 class RingBuffer {
   public:
     explicit RingBuffer(std::size_t capacity)
-        : capacity_(capacity), buffer_(capacity) {}
+        : capacity_(capacity), slots_(std::make_unique<Slot[]>(capacity)) {}
+
+    RingBuffer(const RingBuffer &) = delete;
+    RingBuffer &operator=(const RingBuffer &) = delete;
 
     void Push(T value) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        buffer_[write_index_] = std::move(value);
-        write_index_ = (write_index_ + 1) % capacity_;
-        if (size_ < capacity_) {
-            ++size_;
-        } else {
-            read_index_ = write_index_;
+        const std::uint64_t ticket = head_.fetch_add(1, std::memory_order_relaxed);
+        Slot &slot = slots_[ticket % capacity_];
+        const std::uint64_t previous = ticket >= capacity_ ? committed_stamp(ticket - capacity_) : 0;
+        unsigned spins = 0;
+        std::uint64_t expected = previous;
+        while (!slot.stamp.compare_exchange_weak(expected, committed_stamp(ticket) - 1, std::memory_order_acquire,
+                                                 std::memory_order_relaxed)) {
+            // The previous lap's writer, or a reader copying that entry, still
+            // holds the slot.
+            expected = previous;
+            backoff(spins);
         }
+        slot.value = std::move(value);
+        slot.stamp.store(committed_stamp(ticket), std::memory_order_release);
     }
 
-    std::vector<T> Snapshot() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        std::vector<T> out;
-        out.reserve(size_);
-        for (std::size_t i = 0; i < size_; ++i) {
-            std::size_t index = (read_index_ + i) % capacity_;
-            out.push_back(buffer_[index]);
+    // Result of reading from a cursor: pass |next| back on the following
+    // read. |gap| is set when entries the reader had not seen yet were
+    // overwritten first.
+    struct VisitResult {
+        std::uint64_t next = 0;
+        bool gap = false;
+    };
+
+    struct Slice {
+        std::vector<T> entries;
+        std::uint64_t next = 0;
+        bool gap = false;
+    };
+
+    std::vector<T> Snapshot() const { return SnapshotSince(0).entries; }
+
+    // Copies of the entries pushed since |cursor|; 0 reads everything held.
+    Slice SnapshotSince(std::uint64_t cursor) const {
+        Slice slice;
+        const std::uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head > cursor) {
+            slice.entries.reserve(head - cursor < capacity_ ? static_cast<std::size_t>(head - cursor) : capacity_);
         }
-        return out;
+        const VisitResult result =
+            VisitSince(cursor, [&](std::uint64_t, const T &value) { slice.entries.push_back(value); });
+        slice.next = result.next;
+        slice.gap = result.gap;
+        return slice;
     }
 
+    // Like SnapshotSince, but calls |visit(sequence, value)| on each entry
+    // in place instead of copying it. The slot stays pinned during the
+    // call, and a writer that laps the ring onto it waits. Keep the visitor
+    // short, and never Push to this ring from inside it.
+    template <typename Visit>
+    VisitResult VisitSince(std::uint64_t cursor, Visit &&visit) const {
+        const std::uint64_t head = head_.load(std::memory_order_acquire);
+        const std::uint64_t oldest = head > capacity_ ? head - capacity_ : 0;
+        VisitResult result;
+        result.gap = cursor < oldest;
+        std::uint64_t ticket = cursor < oldest ? oldest : cursor;
+        for (; ticket < head; ++ticket) {
+            const SlotRead read = read_slot(ticket, [&](const T &value) { visit(ticket, value); });
+            if (read == SlotRead::Pending) {
+                break;
+            }
+            if (read == SlotRead::Overwritten) {
+                result.gap = true;
+            }
+        }
+        result.next = ticket < cursor ? cursor : ticket;
+        return result;
+    }
+
+    // Entries currently held, counting any whose writer is mid-commit.
     std::size_t size() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return size_;
+        const std::uint64_t head = head_.load(std::memory_order_relaxed);
+        return head < capacity_ ? static_cast<std::size_t>(head) : capacity_;
     }
 
   private:
+    // One cache line per slot, so writers of neighbouring tickets do not
+    // share lines.
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> stamp{0};
+        T value{};
+    };
+
+    enum class SlotRead { Read, Overwritten, Pending };
+
+    static constexpr std::uint64_t committed_stamp(std::uint64_t ticket) { return 2 * (ticket + 1); }
+
+    static void backoff(unsigned &spins) {
+        if (++spins > 64) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Pins the slot holding |ticket| and calls |visit| on its value.
+    template <typename Visit>
+    SlotRead read_slot(std::uint64_t ticket, Visit &&visit) const {
+        Slot &slot = slots_[ticket % capacity_];
+        const std::uint64_t committed = committed_stamp(ticket);
+        unsigned spins = 0;
+        for (;;) {
+            std::uint64_t stamp = slot.stamp.load(std::memory_order_acquire);
+            if (stamp < committed) {
+                return SlotRead::Pending;
+            }
+            if (stamp > committed + 1) {
+                return SlotRead::Overwritten;
+            }
+            // committed + 1: another reader has it pinned.
+            if (stamp == committed &&
+                slot.stamp.compare_exchange_weak(stamp, committed + 1, std::memory_order_acquire,
+                                                 std::memory_order_relaxed)) {
+                visit(static_cast<const T &>(slot.value));
+                slot.stamp.store(committed, std::memory_order_release);
+                return SlotRead::Read;
+            }
+            backoff(spins);
+        }
+    }
+
     std::size_t capacity_;
-    mutable std::mutex mutex_;
-    std::vector<T> buffer_;
-    std::size_t write_index_ = 0;
-    std::size_t read_index_ = 0;
-    std::size_t size_ = 0;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<std::uint64_t> head_{0};
 };
 
 }  // namespace wslmon
-
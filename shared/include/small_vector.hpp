@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace wslmon {
+
+// Vector that keeps up to N elements in inline storage and only touches the
+// heap once it grows past that. Covers the subset of std::vector that the
+// event pipeline uses; iterators are raw pointers.
+template <typename T, std::size_t N>
+class SmallVector {
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    SmallVector() noexcept = default;
+
+    SmallVector(std::initializer_list<T> values) {
+        reserve(values.size());
+        for (const auto &value : values) {
+            push_back(value);
+        }
+    }
+
+    SmallVector(const SmallVector &other) {
+        reserve(other.size_);
+        std::uninitialized_copy(other.begin(), other.end(), data_);
+        size_ = other.size_;
+    }
+
+    SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>) { take(std::move(other)); }
+
+    ~SmallVector() {
+        clear();
+        release();
+    }
+
+    SmallVector &operator=(const SmallVector &other) {
+        if (this != &other) {
+            clear();
+            reserve(other.size_);
+            std::uninitialized_copy(other.begin(), other.end(), data_);
+            size_ = other.size_;
+        }
+        return *this;
+    }
+
+    SmallVector &operator=(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            release();
+            take(std::move(other));
+        }
+        return *this;
+    }
+
+    iterator begin() noexcept { return data_; }
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+
+    T *data() noexcept { return data_; }
+    const T *data() const noexcept { return data_; }
+    [[nodiscard]] size_type size() const noexcept { return size_; }
+    [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] bool is_inline() const noexcept { return data_ == inline_data(); }
+
+    reference operator[](size_type index) { return data_[index]; }
+    const_reference operator[](size_type index) const { return data_[index]; }
+    reference front() { return data_[0]; }
+    const_reference front() const { return data_[0]; }
+    reference back() { return data_[size_ - 1]; }
+    const_reference back() const { return data_[size_ - 1]; }
+
+    void reserve(size_type capacity) {
+        if (capacity > capacity_) {
+            grow(capacity);
+        }
+    }
+
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    template <typename... Args>
+    reference emplace_back(Args &&...args) {
+        if (size_ == capacity_) {
+            // Construct first: |args| may alias an element that grow() moves.
+            T value(std::forward<Args>(args)...);
+            grow(capacity_ * 2);
+            ::new (static_cast<void *>(data_ + size_)) T(std::move(value));
+        } else {
+            ::new (static_cast<void *>(data_ + size_)) T(std::forward<Args>(args)...);
+        }
+        return data_[size_++];
+    }
+
+    void pop_back() {
+        --size_;
+        data_[size_].~T();
+    }
+
+    iterator erase(const_iterator position) {
+        auto *target = data_ + (position - data_);
+        std::move(target + 1, end(), target);
+        pop_back();
+        return target;
+    }
+
+    void resize(size_type count) {
+        while (size_ > count) {
+            pop_back();
+        }
+        reserve(count);
+        while (size_ < count) {
+            emplace_back();
+        }
+    }
+
+    void clear() noexcept {
+        std::destroy(begin(), end());
+        size_ = 0;
+    }
+
+  private:
+    T *inline_data() noexcept { return std::launder(reinterpret_cast<T *>(inline_storage_)); }
+    const T *inline_data() const noexcept { return std::launder(reinterpret_cast<const T *>(inline_storage_)); }
+
+    void grow(size_type capacity) {
+        auto *fresh = static_cast<T *>(::operator new(capacity * sizeof(T), std::align_val_t(alignof(T))));
+        std::uninitialized_move(begin(), end(), fresh);
+        std::destroy(begin(), end());
+        release();
+        data_ = fresh;
+        capacity_ = capacity;
+    }
+
+    void release() noexcept {
+        if (!is_inline()) {
+            ::operator delete(data_, std::align_val_t(alignof(T)));
+            data_ = inline_data();
+            capacity_ = N;
+        }
+    }
+
+    void take(SmallVector &&other) {
+        if (other.is_inline()) {
+            std::uninitialized_move(other.begin(), other.end(), data_);
+            size_ = other.size_;
+            other.clear();
+        } else {
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_data();
+            other.size_ = 0;
+            other.capacity_ = N;
+        }
+    }
+
+    alignas(T) unsigned char inline_storage_[N * sizeof(T)];
+    T *data_ = inline_data();
+    size_type size_ = 0;
+    size_type capacity_ = N;
+};
+
+}  // namespace wslmon
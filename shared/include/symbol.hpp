@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace wslmon {
+
+// Handle to a string in the process-wide intern table. Event sources,
+// categories and attribute keys come from a small closed vocabulary, so
+// records carry a 32-bit id instead of their own heap copy and equality is an
+// integer compare. Interned strings live until process exit. Id 0 is the
+// empty string.
+class Symbol {
+  public:
+    constexpr Symbol() = default;
+    Symbol(std::string_view text) : id_(Intern(text)) {}
+    Symbol(const char *text) : Symbol(std::string_view(text)) {}
+    Symbol(const std::string &text) : Symbol(std::string_view(text)) {}
+
+    // For text decoded from outside the process (log lines, IPC frames),
+    // which could otherwise fill the table with junk until it runs out of
+    // ids. Such text is interned only while the table is below a fixed
+    // share of its capacity and the text is short. Otherwise it maps to
+    // kUnknownText unless it is interned already. Never throws for a full
+    // table.
+    static Symbol FromUntrusted(std::string_view text);
+    static constexpr std::string_view kUnknownText = "(unknown)";
+
+    [[nodiscard]] std::uint32_t id() const { return id_; }
+    [[nodiscard]] bool empty() const { return id_ == 0; }
+    [[nodiscard]] std::string_view view() const;
+    [[nodiscard]] std::string str() const { return std::string(view()); }
+    operator std::string_view() const { return view(); }
+
+    friend bool operator==(Symbol lhs, Symbol rhs) { return lhs.id_ == rhs.id_; }
+    friend bool operator!=(Symbol lhs, Symbol rhs) { return lhs.id_ != rhs.id_; }
+    friend bool operator==(Symbol lhs, std::string_view rhs) { return lhs.view() == rhs; }
+    friend bool operator!=(Symbol lhs, std::string_view rhs) { return lhs.view() != rhs; }
+    friend bool operator==(std::string_view lhs, Symbol rhs) { return lhs == rhs.view(); }
+    friend bool operator!=(std::string_view lhs, Symbol rhs) { return lhs != rhs.view(); }
+    friend bool operator==(Symbol lhs, const char *rhs) { return lhs.view() == rhs; }
+    friend bool operator!=(Symbol lhs, const char *rhs) { return lhs.view() != rhs; }
+    friend bool operator==(const char *lhs, Symbol rhs) { return lhs == rhs.view(); }
+    friend bool operator!=(const char *lhs, Symbol rhs) { return lhs != rhs.view(); }
+    friend bool operator==(Symbol lhs, const std::string &rhs) { return lhs.view() == rhs; }
+    friend bool operator!=(Symbol lhs, const std::string &rhs) { return lhs.view() != rhs; }
+    friend bool operator==(const std::string &lhs, Symbol rhs) { return lhs == rhs.view(); }
+    friend bool operator!=(const std::string &lhs, Symbol rhs) { return lhs != rhs.view(); }
+
+    friend std::ostream &operator<<(std::ostream &os, Symbol symbol) { return os << symbol.view(); }
+
+  private:
+    static std::uint32_t Intern(std::string_view text);
+
+    std::uint32_t id_ = 0;
+};
+
+}  // namespace wslmon
+
+template <>
+struct std::hash<wslmon::Symbol> {
+    std::size_t operator()(wslmon::Symbol symbol) const noexcept { return symbol.id(); }
+};
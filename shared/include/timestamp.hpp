@@ -0,0 +1,32 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+namespace wslmon {
+
+enum class TimestampFormat {
+    // 2024-05-01T12:34:56.123456Z, the EventRecord schema format.
+    Iso8601Micros,
+    // 2024-05-01T12:34:56Z
+    Iso8601Seconds,
+    // 20240501T123456Z, used for rotated log suffixes.
+    CompactSeconds,
+};
+
+// UTC formatting without gmtime, locale or stream machinery. The calendar
+// part is cached per thread for the last second formatted, so bursts of
+// events within one second only write the fractional suffix.
+void AppendTimestamp(std::string &out,
+                     std::chrono::system_clock::time_point tp,
+                     TimestampFormat format = TimestampFormat::Iso8601Micros);
+std::string FormatTimestamp(std::chrono::system_clock::time_point tp,
+                            TimestampFormat format = TimestampFormat::Iso8601Micros);
+
+// Parses YYYY-MM-DDTHH:MM:SS with an optional .fraction (microsecond
+// precision, extra digits ignored). Anything after that, such as the
+// trailing Z, is ignored.
+bool ParseTimestamp(std::string_view text, std::chrono::system_clock::time_point &tp);
+
+}  // namespace wslmon
@@ -0,0 +1,241 @@
+#include "append_file.hpp"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace wslmon {
+
+#ifdef _WIN32
+
+AppendFile::~AppendFile() {
+    Close();
+}
+
+bool AppendFile::Open(const std::filesystem::path &path, std::uint64_t preallocate) {
+    (void)preallocate;
+    Close();
+    HANDLE handle = CreateFileW(path.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size{};
+    GetFileSizeEx(handle, &size);
+    handle_ = handle;
+    size_ = static_cast<std::uint64_t>(size.QuadPart);
+    return true;
+}
+
+void AppendFile::Close() {
+    if (handle_) {
+        CloseHandle(static_cast<HANDLE>(handle_));
+        handle_ = nullptr;
+    }
+    size_ = 0;
+}
+
+bool AppendFile::is_open() const {
+    return handle_ != nullptr;
+}
+
+bool AppendFile::mapped() const {
+    return false;
+}
+
+bool AppendFile::Write(const std::string_view *parts, std::size_t count) {
+    if (!handle_) {
+        return false;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        const char *data = parts[i].data();
+        std::size_t remaining = parts[i].size();
+        while (remaining > 0) {
+            const DWORD chunk = static_cast<DWORD>(remaining < (1u << 30) ? remaining : (1u << 30));
+            DWORD written = 0;
+            if (!WriteFile(static_cast<HANDLE>(handle_), data, chunk, &written, nullptr) || written == 0) {
+                return false;
+            }
+            data += written;
+            remaining -= written;
+            size_ += written;
+        }
+    }
+    return true;
+}
+
+bool AppendFile::Sync() {
+    return handle_ && FlushFileBuffers(static_cast<HANDLE>(handle_));
+}
+
+#else
+
+AppendFile::~AppendFile() {
+    Close();
+}
+
+bool AppendFile::Open(const std::filesystem::path &path, std::uint64_t preallocate) {
+    Close();
+    const int flags = preallocate > 0 ? O_RDWR | O_CREAT | O_CLOEXEC : O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC;
+    const int fd = ::open(path.c_str(), flags, 0666);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info {};
+    fd_ = fd;
+    size_ = ::fstat(fd, &info) == 0 ? static_cast<std::uint64_t>(info.st_size) : 0;
+    if (preallocate > 0) {
+        preallocate_ = preallocate;
+        synced_ = size_;
+        if (!map_capacity(size_ + preallocate_)) {
+            release_mapping();
+        }
+    }
+    return true;
+}
+
+bool AppendFile::map_capacity(std::uint64_t capacity) {
+    // Reserving the blocks up front keeps a full disk from surfacing as
+    // SIGBUS on a store into the mapping.
+    if (::posix_fallocate(fd_, 0, static_cast<off_t>(capacity)) != 0) {
+        return false;
+    }
+    void *view = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    if (map_) {
+        ::munmap(map_, capacity_);
+    }
+    map_ = static_cast<unsigned char *>(view);
+    capacity_ = capacity;
+    return true;
+}
+
+void AppendFile::release_mapping() {
+    if (map_) {
+        ::munmap(map_, capacity_);
+        map_ = nullptr;
+    }
+    capacity_ = 0;
+    preallocate_ = 0;
+    if (fd_ >= 0) {
+        // If this fails the padding stays, and JsonLogger's recovery trims
+        // it at the next open.
+        const int trimmed = ::ftruncate(fd_, static_cast<off_t>(size_));
+        (void)trimmed;
+        ::lseek(fd_, 0, SEEK_END);
+    }
+}
+
+void AppendFile::Close() {
+    if (map_) {
+        release_mapping();
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    size_ = 0;
+}
+
+bool AppendFile::is_open() const {
+    return fd_ >= 0;
+}
+
+bool AppendFile::mapped() const {
+    return map_ != nullptr;
+}
+
+bool AppendFile::Write(const std::string_view *parts, std::size_t count) {
+    if (fd_ < 0) {
+        return false;
+    }
+    if (map_) {
+        std::uint64_t total = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            total += parts[i].size();
+        }
+        if (size_ + total > capacity_ && !map_capacity(size_ + total + preallocate_)) {
+            release_mapping();
+        }
+    }
+    if (map_) {
+        for (std::size_t i = 0; i < count; ++i) {
+            std::memcpy(map_ + size_, parts[i].data(), parts[i].size());
+            size_ += parts[i].size();
+        }
+        return true;
+    }
+    constexpr std::size_t kMaxIov = IOV_MAX < 1024 ? IOV_MAX : 1024;
+    iovec iov[kMaxIov];
+    std::size_t next = 0;
+    // Offset into parts[next] already written by a short writev.
+    std::size_t skip = 0;
+    while (next < count) {
+        std::size_t used = 0;
+        for (std::size_t i = next; i < count && used < kMaxIov; ++i) {
+            const std::size_t offset = i == next ? skip : 0;
+            if (parts[i].size() == offset) {
+                continue;
+            }
+            iov[used].iov_base = const_cast<char *>(parts[i].data() + offset);
+            iov[used].iov_len = parts[i].size() - offset;
+            ++used;
+        }
+        if (used == 0) {
+            return true;
+        }
+        const ssize_t written = ::writev(fd_, iov, static_cast<int>(used));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (written == 0) {
+            return false;
+        }
+        size_ += static_cast<std::uint64_t>(written);
+        std::size_t advanced = static_cast<std::size_t>(written);
+        while (next < count && advanced >= parts[next].size() - skip) {
+            advanced -= parts[next].size() - skip;
+            skip = 0;
+            ++next;
+        }
+        skip += advanced;
+    }
+    return true;
+}
+
+bool AppendFile::Sync() {
+    if (fd_ < 0) {
+        return false;
+    }
+    if (map_) {
+        if (synced_ >= size_) {
+            return true;
+        }
+        const auto page = static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+        const std::uint64_t start = synced_ - synced_ % page;
+        if (::msync(map_ + start, size_ - start, MS_SYNC) != 0) {
+            return false;
+        }
+        synced_ = size_;
+        return true;
+    }
+    return ::fdatasync(fd_) == 0;
+}
+
+#endif
+
+}  // namespace wslmon
@@ -0,0 +1,322 @@
+#include "black_box.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "event_codec.hpp"
+#include "logger.hpp"
+
+namespace wslmon {
+
+namespace {
+constexpr std::size_t kHeaderSize = 4096;
+constexpr char kMagic[8] = {'W', 'S', 'L', 'M', 'B', 'B', '0', '2'};
+
+struct Header {
+    char magic[8];
+    std::uint64_t capacity;
+    // Logical offset of the next record; grows without wrapping.
+    std::uint64_t head;
+    // Set while a process has the ring open; cleared by Close.
+    std::uint64_t open;
+};
+
+struct RecordHeader {
+    // Whole record including this header, a multiple of 8.
+    std::uint32_t size;
+    // Encoded event bytes; 0 for padding at the end of a lap.
+    std::uint32_t payload_length;
+    std::uint64_t offset;
+    // Checksum over the fields above and the payload.
+    std::uint64_t checksum;
+    // Log sequence once the logger has written the record, else 0. Written
+    // after the record, so it stays outside the checksum.
+    std::uint64_t logged_sequence;
+};
+static_assert(std::is_trivially_copyable_v<Header> && sizeof(Header) <= kHeaderSize);
+static_assert(std::is_trivially_copyable_v<RecordHeader> && sizeof(RecordHeader) % 8 == 0);
+
+// FNV-1a taken a 64-bit word at a time, then byte-wise for the tail. It
+// catches torn and stale records; eight bytes per multiply keeps it off
+// the Append profile.
+std::uint64_t fnv1a_words(std::uint64_t hash, const unsigned char *bytes, std::size_t length) {
+    constexpr std::uint64_t kPrime = 0x100000001b3ull;
+    std::size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * kPrime;
+    }
+    for (; i < length; ++i) {
+        hash = (hash ^ bytes[i]) * kPrime;
+    }
+    return hash;
+}
+
+std::uint64_t record_checksum(const RecordHeader &header, const unsigned char *payload) {
+    const std::uint64_t hash = fnv1a_words(0xcbf29ce484222325ull, reinterpret_cast<const unsigned char *>(&header),
+                                           offsetof(RecordHeader, checksum));
+    return fnv1a_words(hash, payload, header.payload_length);
+}
+
+std::uint64_t align8(std::uint64_t value) {
+    return (value + 7) & ~std::uint64_t{7};
+}
+}  // namespace
+
+BlackBoxRing::~BlackBoxRing() {
+    Close();
+}
+
+bool BlackBoxRing::Open(const std::filesystem::path &path, std::size_t capacity) {
+    Close();
+    capacity = static_cast<std::size_t>(align8(capacity));
+    if (capacity < 4 * sizeof(RecordHeader) || !map(path, kHeaderSize + capacity)) {
+        return false;
+    }
+    capacity_ = capacity;
+    Header header{};
+    std::memcpy(&header, view_, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.capacity != capacity_) {
+        reset(0);
+    } else if (header.open != 0) {
+        recover();
+    } else {
+        reset(header.head);
+    }
+    const std::uint64_t open = 1;
+    std::memcpy(view_ + offsetof(Header, open), &open, sizeof(open));
+    return true;
+}
+
+void BlackBoxRing::Close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!view_) {
+        return;
+    }
+    const std::uint64_t open = 0;
+    std::memcpy(view_ + offsetof(Header, open), &open, sizeof(open));
+    unmap();
+}
+
+std::uint64_t BlackBoxRing::Append(const EventRecord &record) {
+    thread_local std::string payload;
+    payload.clear();
+    EncodeEventBinary(record, payload);
+    const std::uint64_t size = align8(sizeof(RecordHeader) + payload.size());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!view_ || size > capacity_ / 4) {
+        return kNotRecorded;
+    }
+    unsigned char *data = view_ + kHeaderSize;
+    std::uint64_t head = 0;
+    std::memcpy(&head, view_ + offsetof(Header, head), sizeof(head));
+    std::uint64_t position = head % capacity_;
+    if (capacity_ - position < size) {
+        // Pad out the rest of the lap so the record starts at the front.
+        if (capacity_ - position >= sizeof(RecordHeader)) {
+            RecordHeader padding{static_cast<std::uint32_t>(capacity_ - position), 0, head, 0, 0};
+            padding.checksum = record_checksum(padding, nullptr);
+            std::memcpy(data + position, &padding, sizeof(padding));
+        }
+        head += capacity_ - position;
+        position = 0;
+    }
+    RecordHeader header{static_cast<std::uint32_t>(size), static_cast<std::uint32_t>(payload.size()), head, 0, 0};
+    const auto *bytes = reinterpret_cast<const unsigned char *>(payload.data());
+    header.checksum = record_checksum(header, bytes);
+    std::memcpy(data + position, &header, sizeof(header));
+    std::memcpy(data + position + sizeof(header), bytes, payload.size());
+    std::memset(data + position + sizeof(header) + payload.size(), 0, size - sizeof(header) - payload.size());
+    const std::uint64_t offset = head;
+    head += size;
+    // The cursor moves last; recovery also reads valid records past a stale
+    // cursor.
+    std::memcpy(view_ + offsetof(Header, head), &head, sizeof(head));
+    return offset;
+}
+
+void BlackBoxRing::MarkLogged(const LoggedRecord *records, std::size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!view_) {
+        return;
+    }
+    unsigned char *data = view_ + kHeaderSize;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::uint64_t position = records[i].offset % capacity_;
+        std::uint64_t offset = 0;
+        std::memcpy(&offset, data + position + offsetof(RecordHeader, offset), sizeof(offset));
+        // A later lap has written over the record.
+        if (offset != records[i].offset) {
+            continue;
+        }
+        std::memcpy(data + position + offsetof(RecordHeader, logged_sequence), &records[i].sequence,
+                    sizeof(records[i].sequence));
+    }
+}
+
+std::vector<EventRecord> BlackBoxRing::TakeRecovered() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::move(recovered_);
+}
+
+void BlackBoxRing::recover() {
+    const unsigned char *data = view_ + kHeaderSize;
+    std::uint64_t head = 0;
+    std::memcpy(&head, view_ + offsetof(Header, head), sizeof(head));
+
+    // Decodes the header of the record that should start at |offset|.
+    auto record_at = [&](std::uint64_t offset, RecordHeader &header) {
+        const std::uint64_t position = offset % capacity_;
+        if (capacity_ - position < sizeof(RecordHeader)) {
+            return false;
+        }
+        std::memcpy(&header, data + position, sizeof(header));
+        return header.offset == offset && header.size >= sizeof(RecordHeader) && header.size % 8 == 0 &&
+               header.size <= capacity_ - position && header.payload_length <= header.size - sizeof(RecordHeader) &&
+               header.checksum == record_checksum(header, data + position + sizeof(RecordHeader));
+    };
+    auto next_lap = [&](std::uint64_t offset) { return (offset / capacity_ + 1) * capacity_; };
+
+    // Everything older than one lap behind the cursor has been overwritten.
+    // Record boundaries in the partly overwritten lap are unknown, and a
+    // record may be damaged, so up to the cursor an invalid position is
+    // skipped in 8-byte steps until a record claims its own offset. Past
+    // the cursor, a record written just before the kill may still be
+    // intact, but the first invalid one ends the walk.
+    RecordHeader header{};
+    std::uint64_t offset = head > capacity_ ? head - capacity_ : 0;
+    while (offset < head + capacity_) {
+        if (capacity_ - offset % capacity_ < sizeof(RecordHeader)) {
+            offset = next_lap(offset);
+            continue;
+        }
+        if (!record_at(offset, header)) {
+            if (offset >= head) {
+                break;
+            }
+            offset += 8;
+            continue;
+        }
+        if (header.payload_length > 0 && header.logged_sequence == 0) {
+            EventRecord record;
+            const auto *payload = reinterpret_cast<const char *>(data + offset % capacity_ + sizeof(RecordHeader));
+            if (DecodeEventBinary(std::string_view(payload, header.payload_length), record)) {
+                recovered_.push_back(std::move(record));
+            }
+        }
+        offset += header.size;
+    }
+    // Starting on a fresh lap over zeroed data keeps old records from
+    // being recovered twice.
+    reset(next_lap(offset > head ? offset : head));
+}
+
+void BlackBoxRing::reset(std::uint64_t head) {
+    std::memset(view_ + kHeaderSize, 0, static_cast<std::size_t>(capacity_));
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.capacity = capacity_;
+    header.head = head;
+    std::memcpy(view_, &header, sizeof(header));
+}
+
+#ifdef _WIN32
+
+bool BlackBoxRing::map(const std::filesystem::path &path, std::size_t file_size) {
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    // Sizing the mapping extends the file; a larger file keeps its size.
+    const auto size = static_cast<std::uint64_t>(file_size);
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32),
+                                        static_cast<DWORD>(size & 0xFFFFFFFFu), nullptr);
+    CloseHandle(file);
+    if (!mapping) {
+        return false;
+    }
+    void *view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, file_size);
+    CloseHandle(mapping);
+    if (!view) {
+        return false;
+    }
+    view_ = static_cast<unsigned char *>(view);
+    view_size_ = file_size;
+    return true;
+}
+
+void BlackBoxRing::unmap() {
+    UnmapViewOfFile(view_);
+    view_ = nullptr;
+    view_size_ = 0;
+}
+
+#else
+
+bool BlackBoxRing::map(const std::filesystem::path &path, std::size_t file_size) {
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 ||
+        (static_cast<std::size_t>(info.st_size) != file_size && ::ftruncate(fd, static_cast<off_t>(file_size)) != 0)) {
+        ::close(fd);
+        return false;
+    }
+    void *view = ::mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    view_ = static_cast<unsigned char *>(view);
+    view_size_ = file_size;
+    return true;
+}
+
+void BlackBoxRing::unmap() {
+    ::munmap(view_, view_size_);
+    view_ = nullptr;
+    view_size_ = 0;
+}
+
+#endif
+
+void LogRecoveredEvents(JsonLogger &logger, std::vector<EventRecord> events, Symbol source) {
+    if (events.empty()) {
+        return;
+    }
+    EventRecord summary{};
+    summary.source = source;
+    summary.category = "Recovery";
+    summary.severity = Severity::Warning;
+    summary.message = "Recovered events from the black box of an unclean shutdown";
+    summary.attributes.push_back({"recovered_count", static_cast<std::uint64_t>(events.size())});
+    summary.timestamp = std::chrono::system_clock::now();
+    summary.sequence = 0;
+    logger.Append(summary);
+    for (auto &event : events) {
+        if (event.sequence != 0) {
+            event.attributes.push_back({"original_sequence", event.sequence});
+        }
+        event.attributes.push_back({"recovered", "blackbox"});
+        event.sequence = 0;
+        logger.Append(event);
+    }
+}
+
+}  // namespace wslmon
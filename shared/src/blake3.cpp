@@ -0,0 +1,504 @@
+#include "crypto.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define WSLMON_BLAKE3_X86 1
+#include <immintrin.h>
+#endif
+
+#include "cpu_features.hpp"
+
+namespace wslmon {
+namespace {
+
+constexpr std::size_t kBlockLen = 64;
+constexpr std::size_t kChunkLen = 1024;
+constexpr std::uint32_t kChunkStart = 1u << 0;
+constexpr std::uint32_t kChunkEnd = 1u << 1;
+constexpr std::uint32_t kParent = 1u << 2;
+constexpr std::uint32_t kRoot = 1u << 3;
+
+constexpr std::array<std::uint32_t, 8> kIv = {
+    0x6a09e667u, 0xbb67ae85u, 0x3c6ef372u, 0xa54ff53au,
+    0x510e527fu, 0x9b05688cu, 0x1f83d9abu, 0x5be0cd19u};
+
+// Message word order for each of the seven rounds: the BLAKE3 permutation
+// applied once more per round.
+constexpr std::uint8_t kMsgSchedule[7][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8},
+    {3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1},
+    {10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6},
+    {12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4},
+    {9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7},
+    {11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13},
+};
+
+inline std::uint32_t LoadLittleEndian32(const std::uint8_t *bytes) {
+    return static_cast<std::uint32_t>(bytes[0]) | static_cast<std::uint32_t>(bytes[1]) << 8 |
+           static_cast<std::uint32_t>(bytes[2]) << 16 | static_cast<std::uint32_t>(bytes[3]) << 24;
+}
+
+inline void LoadBlockWords(const std::uint8_t *block, std::uint32_t *words) {
+    for (std::size_t i = 0; i < 16; ++i) {
+        words[i] = LoadLittleEndian32(block + i * 4);
+    }
+}
+
+inline std::uint32_t RightRotate(std::uint32_t value, int bits) {
+    return (value >> bits) | (value << (32 - bits));
+}
+
+// Compresses one block and writes the chaining value (the first half of the
+// output XORed with the second), which is all a 32-byte digest needs.
+using CompressFn = void (*)(const std::uint32_t *cv,
+                            const std::uint32_t *message,
+                            std::uint32_t block_len,
+                            std::uint64_t counter,
+                            std::uint32_t flags,
+                            std::uint32_t *out);
+
+inline void G(std::uint32_t *v, int a, int b, int c, int d, std::uint32_t x, std::uint32_t y) {
+    v[a] = v[a] + v[b] + x;
+    v[d] = RightRotate(v[d] ^ v[a], 16);
+    v[c] = v[c] + v[d];
+    v[b] = RightRotate(v[b] ^ v[c], 12);
+    v[a] = v[a] + v[b] + y;
+    v[d] = RightRotate(v[d] ^ v[a], 8);
+    v[c] = v[c] + v[d];
+    v[b] = RightRotate(v[b] ^ v[c], 7);
+}
+
+void CompressPortable(const std::uint32_t *cv,
+                      const std::uint32_t *m,
+                      std::uint32_t block_len,
+                      std::uint64_t counter,
+                      std::uint32_t flags,
+                      std::uint32_t *out) {
+    std::uint32_t v[16] = {cv[0],  cv[1],  cv[2],  cv[3],
+                           cv[4],  cv[5],  cv[6],  cv[7],
+                           kIv[0], kIv[1], kIv[2], kIv[3],
+                           static_cast<std::uint32_t>(counter), static_cast<std::uint32_t>(counter >> 32),
+                           block_len, flags};
+    for (const auto &s : kMsgSchedule) {
+        G(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+        G(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+        G(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+        G(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+        G(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+        G(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+        G(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+        G(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+    }
+    for (std::size_t i = 0; i < 8; ++i) {
+        out[i] = v[i] ^ v[i + 8];
+    }
+}
+
+#if defined(WSLMON_BLAKE3_X86)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define WSLMON_TARGET_SSE41 __attribute__((target("sse4.1")))
+#else
+#define WSLMON_TARGET_SSE41
+#endif
+
+// Row-wise G: each register holds one row of the 4x4 state, so the column
+// step runs four G functions at once and the diagonal step follows a lane
+// rotation of rows 1-3.
+WSLMON_TARGET_SSE41 inline void G4(__m128i &a, __m128i &b, __m128i &c, __m128i &d, __m128i x, __m128i y) {
+    const __m128i rotate16 = _mm_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+    const __m128i rotate8 = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    a = _mm_add_epi32(_mm_add_epi32(a, b), x);
+    d = _mm_shuffle_epi8(_mm_xor_si128(d, a), rotate16);
+    c = _mm_add_epi32(c, d);
+    b = _mm_xor_si128(b, c);
+    b = _mm_or_si128(_mm_srli_epi32(b, 12), _mm_slli_epi32(b, 20));
+    a = _mm_add_epi32(_mm_add_epi32(a, b), y);
+    d = _mm_shuffle_epi8(_mm_xor_si128(d, a), rotate8);
+    c = _mm_add_epi32(c, d);
+    b = _mm_xor_si128(b, c);
+    b = _mm_or_si128(_mm_srli_epi32(b, 7), _mm_slli_epi32(b, 25));
+}
+
+WSLMON_TARGET_SSE41 void CompressSse41(const std::uint32_t *cv,
+                                       const std::uint32_t *m,
+                                       std::uint32_t block_len,
+                                       std::uint64_t counter,
+                                       std::uint32_t flags,
+                                       std::uint32_t *out) {
+    __m128i row0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cv));
+    __m128i row1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cv + 4));
+    __m128i row2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(kIv.data()));
+    __m128i row3 = _mm_setr_epi32(static_cast<int>(counter), static_cast<int>(counter >> 32),
+                                  static_cast<int>(block_len), static_cast<int>(flags));
+    for (const auto &s : kMsgSchedule) {
+        G4(row0, row1, row2, row3,
+           _mm_setr_epi32(static_cast<int>(m[s[0]]), static_cast<int>(m[s[2]]), static_cast<int>(m[s[4]]),
+                          static_cast<int>(m[s[6]])),
+           _mm_setr_epi32(static_cast<int>(m[s[1]]), static_cast<int>(m[s[3]]), static_cast<int>(m[s[5]]),
+                          static_cast<int>(m[s[7]])));
+        row1 = _mm_shuffle_epi32(row1, _MM_SHUFFLE(0, 3, 2, 1));
+        row2 = _mm_shuffle_epi32(row2, _MM_SHUFFLE(1, 0, 3, 2));
+        row3 = _mm_shuffle_epi32(row3, _MM_SHUFFLE(2, 1, 0, 3));
+        G4(row0, row1, row2, row3,
+           _mm_setr_epi32(static_cast<int>(m[s[8]]), static_cast<int>(m[s[10]]), static_cast<int>(m[s[12]]),
+                          static_cast<int>(m[s[14]])),
+           _mm_setr_epi32(static_cast<int>(m[s[9]]), static_cast<int>(m[s[11]]), static_cast<int>(m[s[13]]),
+                          static_cast<int>(m[s[15]])));
+        row1 = _mm_shuffle_epi32(row1, _MM_SHUFFLE(2, 1, 0, 3));
+        row2 = _mm_shuffle_epi32(row2, _MM_SHUFFLE(1, 0, 3, 2));
+        row3 = _mm_shuffle_epi32(row3, _MM_SHUFFLE(0, 3, 2, 1));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_xor_si128(row0, row2));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 4), _mm_xor_si128(row1, row3));
+}
+
+#endif  // WSLMON_BLAKE3_X86
+
+// Hashes |kLanes| consecutive whole chunks, none of them the root, and
+// writes one chaining value per chunk.
+using HashChunksFn = void (*)(const std::uint8_t *input, std::uint64_t counter, std::uint32_t (*cvs)[8]);
+
+#if defined(WSLMON_BLAKE3_X86) && (defined(__GNUC__) || defined(__clang__))
+#define WSLMON_BLAKE3_LANES 1
+
+// Same scheme as the multi-buffer SHA-256 engine: GCC vector extensions in
+// always_inline templates, instantiated inside per-ISA wrappers.
+typedef std::uint32_t LaneVector4 __attribute__((vector_size(16)));
+typedef std::uint32_t LaneVector8 __attribute__((vector_size(32)));
+typedef std::uint32_t LaneVector16 __attribute__((vector_size(64)));
+
+#define WSLMON_LANE_INLINE __attribute__((always_inline)) inline
+#define WSLMON_LANE_ROTR(value, bits) (((value) >> (bits)) | ((value) << (32 - (bits))))
+#define WSLMON_LANE_G(a, b, c, d, x, y)            \
+    do {                                           \
+        v[a] = v[a] + v[b] + (x);                  \
+        v[d] = WSLMON_LANE_ROTR(v[d] ^ v[a], 16);  \
+        v[c] = v[c] + v[d];                        \
+        v[b] = WSLMON_LANE_ROTR(v[b] ^ v[c], 12);  \
+        v[a] = v[a] + v[b] + (y);                  \
+        v[d] = WSLMON_LANE_ROTR(v[d] ^ v[a], 8);   \
+        v[c] = v[c] + v[d];                        \
+        v[b] = WSLMON_LANE_ROTR(v[b] ^ v[c], 7);   \
+    } while (false)
+
+template <typename V>
+WSLMON_LANE_INLINE void HashChunksLanes(const std::uint8_t *input, std::uint64_t counter, std::uint32_t (*cvs)[8]) {
+    constexpr std::size_t kLanes = sizeof(V) / sizeof(std::uint32_t);
+    alignas(64) std::uint32_t words[16][kLanes];
+    alignas(64) std::uint32_t counter_low[kLanes];
+    alignas(64) std::uint32_t counter_high[kLanes];
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+        counter_low[lane] = static_cast<std::uint32_t>(counter + lane);
+        counter_high[lane] = static_cast<std::uint32_t>((counter + lane) >> 32);
+    }
+    V h[8];
+    for (std::size_t i = 0; i < 8; ++i) {
+        h[i] = V{} + kIv[i];
+    }
+
+    for (std::size_t block = 0; block < kChunkLen / kBlockLen; ++block) {
+        for (std::size_t lane = 0; lane < kLanes; ++lane) {
+            const std::uint8_t *source = input + lane * kChunkLen + block * kBlockLen;
+            for (std::size_t t = 0; t < 16; ++t) {
+                words[t][lane] = LoadLittleEndian32(source + t * 4);
+            }
+        }
+        V m[16];
+        std::memcpy(m, words, sizeof(m));
+        std::uint32_t flags = 0;
+        if (block == 0) {
+            flags |= kChunkStart;
+        }
+        if (block + 1 == kChunkLen / kBlockLen) {
+            flags |= kChunkEnd;
+        }
+        V v[16]{};
+        for (std::size_t i = 0; i < 8; ++i) {
+            v[i] = h[i];
+        }
+        for (std::size_t i = 0; i < 4; ++i) {
+            v[8 + i] = V{} + kIv[i];
+        }
+        std::memcpy(&v[12], counter_low, sizeof(V));
+        std::memcpy(&v[13], counter_high, sizeof(V));
+        v[14] = V{} + static_cast<std::uint32_t>(kBlockLen);
+        v[15] = V{} + flags;
+#pragma GCC unroll 7
+        for (int round = 0; round < 7; ++round) {
+            const std::uint8_t *s = kMsgSchedule[round];
+            WSLMON_LANE_G(0, 4, 8, 12, m[s[0]], m[s[1]]);
+            WSLMON_LANE_G(1, 5, 9, 13, m[s[2]], m[s[3]]);
+            WSLMON_LANE_G(2, 6, 10, 14, m[s[4]], m[s[5]]);
+            WSLMON_LANE_G(3, 7, 11, 15, m[s[6]], m[s[7]]);
+            WSLMON_LANE_G(0, 5, 10, 15, m[s[8]], m[s[9]]);
+            WSLMON_LANE_G(1, 6, 11, 12, m[s[10]], m[s[11]]);
+            WSLMON_LANE_G(2, 7, 8, 13, m[s[12]], m[s[13]]);
+            WSLMON_LANE_G(3, 4, 9, 14, m[s[14]], m[s[15]]);
+        }
+        for (std::size_t i = 0; i < 8; ++i) {
+            h[i] = v[i] ^ v[i + 8];
+        }
+    }
+
+    for (std::size_t i = 0; i < 8; ++i) {
+        std::memcpy(words[i], &h[i], sizeof(V));
+    }
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+        for (std::size_t i = 0; i < 8; ++i) {
+            cvs[lane][i] = words[i][lane];
+        }
+    }
+}
+
+void HashChunksSse2(const std::uint8_t *input, std::uint64_t counter, std::uint32_t (*cvs)[8]) {
+    HashChunksLanes<LaneVector4>(input, counter, cvs);
+}
+
+__attribute__((target("avx2"))) void HashChunksAvx2(const std::uint8_t *input,
+                                                    std::uint64_t counter,
+                                                    std::uint32_t (*cvs)[8]) {
+    HashChunksLanes<LaneVector8>(input, counter, cvs);
+}
+
+__attribute__((target("avx512f"))) void HashChunksAvx512(const std::uint8_t *input,
+                                                         std::uint64_t counter,
+                                                         std::uint32_t (*cvs)[8]) {
+    HashChunksLanes<LaneVector16>(input, counter, cvs);
+}
+
+#undef WSLMON_LANE_G
+#undef WSLMON_LANE_ROTR
+#undef WSLMON_LANE_INLINE
+
+#endif  // WSLMON_BLAKE3_LANES
+
+struct Blake3Engine {
+    CompressFn compress;
+    HashChunksFn hash_chunks;
+    std::size_t lanes;
+};
+
+Blake3Backend DetectBackend() {
+#if defined(WSLMON_BLAKE3_X86)
+    const CpuFeatures &features = GetCpuFeatures();
+#if defined(WSLMON_BLAKE3_LANES)
+    if (features.avx512f && features.sse41 && features.ssse3) {
+        return Blake3Backend::Avx512;
+    }
+    if (features.avx2 && features.sse41 && features.ssse3) {
+        return Blake3Backend::Avx2;
+    }
+#endif
+    if (features.sse41 && features.ssse3) {
+        return Blake3Backend::Sse41;
+    }
+#endif
+    return Blake3Backend::Portable;
+}
+
+Blake3Backend ResolveBackend(Blake3Backend backend) {
+    static const Blake3Backend detected = DetectBackend();
+    if (backend == Blake3Backend::Auto || !Blake3BackendSupported(backend)) {
+        return detected;
+    }
+    return backend;
+}
+
+Blake3Engine EngineFor(Blake3Backend backend) {
+    switch (ResolveBackend(backend)) {
+#if defined(WSLMON_BLAKE3_LANES)
+        case Blake3Backend::Avx512:
+            return {CompressSse41, HashChunksAvx512, 16};
+        case Blake3Backend::Avx2:
+            return {CompressSse41, HashChunksAvx2, 8};
+        case Blake3Backend::Sse41:
+            return {CompressSse41, HashChunksSse2, 4};
+#elif defined(WSLMON_BLAKE3_X86)
+        case Blake3Backend::Sse41:
+            return {CompressSse41, nullptr, 0};
+#endif
+        default:
+            return {CompressPortable, nullptr, 0};
+    }
+}
+
+const Blake3Engine &Engine(Blake3Backend backend) {
+    static const Blake3Engine engines[] = {
+        EngineFor(Blake3Backend::Auto),  EngineFor(Blake3Backend::Portable), EngineFor(Blake3Backend::Sse41),
+        EngineFor(Blake3Backend::Avx2), EngineFor(Blake3Backend::Avx512),
+    };
+    return engines[static_cast<std::size_t>(backend)];
+}
+
+void ParentCv(const std::array<std::uint32_t, 8> &left,
+              const std::array<std::uint32_t, 8> &right,
+              CompressFn compress,
+              std::uint32_t flags,
+              std::uint32_t *out) {
+    std::uint32_t block[16];
+    std::copy(left.begin(), left.end(), block);
+    std::copy(right.begin(), right.end(), block + 8);
+    compress(kIv.data(), block, kBlockLen, 0, kParent | flags, out);
+}
+
+}  // namespace
+
+Blake3Backend ActiveBlake3Backend() {
+    return ResolveBackend(Blake3Backend::Auto);
+}
+
+bool Blake3BackendSupported(Blake3Backend backend) {
+    switch (backend) {
+        case Blake3Backend::Auto:
+        case Blake3Backend::Portable:
+            return true;
+#if defined(WSLMON_BLAKE3_X86)
+        case Blake3Backend::Sse41:
+            return GetCpuFeatures().sse41 && GetCpuFeatures().ssse3;
+#endif
+#if defined(WSLMON_BLAKE3_LANES)
+        case Blake3Backend::Avx2:
+            return GetCpuFeatures().avx2 && Blake3BackendSupported(Blake3Backend::Sse41);
+        case Blake3Backend::Avx512:
+            return GetCpuFeatures().avx512f && Blake3BackendSupported(Blake3Backend::Sse41);
+#endif
+        default:
+            return false;
+    }
+}
+
+Blake3Context::Blake3Context(Blake3Backend backend) : backend_(backend) {
+    Reset();
+}
+
+void Blake3Context::Reset() {
+    cv_stack_len_ = 0;
+    chunk_cv_ = kIv;
+    chunk_counter_ = 0;
+    block_.fill(0);
+    block_len_ = 0;
+    blocks_compressed_ = 0;
+}
+
+void Blake3Context::update_chunk(const std::uint8_t *data, std::size_t len) {
+    const CompressFn compress = Engine(backend_).compress;
+    std::uint32_t words[16];
+    while (len > 0) {
+        // A full buffered block is compressed only once more input arrives,
+        // since the chunk's last block needs the CHUNK_END flag.
+        if (block_len_ == kBlockLen) {
+            LoadBlockWords(block_.data(), words);
+            compress(chunk_cv_.data(), words, kBlockLen, chunk_counter_,
+                     blocks_compressed_ == 0 ? kChunkStart : 0, chunk_cv_.data());
+            ++blocks_compressed_;
+            block_.fill(0);
+            block_len_ = 0;
+        }
+        const std::size_t take = std::min(kBlockLen - block_len_, len);
+        std::memcpy(block_.data() + block_len_, data, take);
+        block_len_ += take;
+        data += take;
+        len -= take;
+    }
+}
+
+void Blake3Context::push_chunk_cv(std::array<std::uint32_t, 8> cv, std::uint64_t total_chunks) {
+    // Each trailing zero bit of the chunk count completes one subtree.
+    const CompressFn compress = Engine(backend_).compress;
+    while ((total_chunks & 1u) == 0) {
+        ParentCv(cv_stack_[--cv_stack_len_], cv, compress, 0, cv.data());
+        total_chunks >>= 1;
+    }
+    cv_stack_[cv_stack_len_++] = cv;
+}
+
+void Blake3Context::Update(const std::uint8_t *data, std::size_t len) {
+    const Blake3Engine &engine = Engine(backend_);
+    std::uint32_t words[16];
+    while (len > 0) {
+        if (chunk_len() == kChunkLen) {
+            std::array<std::uint32_t, 8> cv{};
+            LoadBlockWords(block_.data(), words);
+            engine.compress(chunk_cv_.data(), words, static_cast<std::uint32_t>(block_len_), chunk_counter_,
+                            kChunkEnd | (blocks_compressed_ == 0 ? kChunkStart : 0), cv.data());
+            push_chunk_cv(cv, chunk_counter_ + 1);
+            ++chunk_counter_;
+            chunk_cv_ = kIv;
+            block_.fill(0);
+            block_len_ = 0;
+            blocks_compressed_ = 0;
+            continue;
+        }
+        // Whole chunks with more input behind them can never be the root,
+        // so they go through the lane engine directly.
+        if (chunk_len() == 0 && engine.lanes > 0 && len > engine.lanes * kChunkLen) {
+            std::uint32_t cvs[16][8];
+            engine.hash_chunks(data, chunk_counter_, cvs);
+            for (std::size_t lane = 0; lane < engine.lanes; ++lane) {
+                std::array<std::uint32_t, 8> cv;
+                std::copy(cvs[lane], cvs[lane] + 8, cv.begin());
+                push_chunk_cv(cv, chunk_counter_ + 1);
+                ++chunk_counter_;
+            }
+            data += engine.lanes * kChunkLen;
+            len -= engine.lanes * kChunkLen;
+            continue;
+        }
+        const std::size_t take = std::min(kChunkLen - chunk_len(), len);
+        update_chunk(data, take);
+        data += take;
+        len -= take;
+    }
+}
+
+std::array<std::uint8_t, 32> Blake3Context::Final() {
+    const CompressFn compress = Engine(backend_).compress;
+    // The pending output node starts as the current chunk and is folded
+    // into each stacked subtree from the right.
+    std::array<std::uint32_t, 8> input_cv = chunk_cv_;
+    std::uint32_t block[16];
+    LoadBlockWords(block_.data(), block);
+    std::uint32_t block_len = static_cast<std::uint32_t>(block_len_);
+    std::uint64_t counter = chunk_counter_;
+    std::uint32_t flags = kChunkEnd | (blocks_compressed_ == 0 ? kChunkStart : 0);
+    while (cv_stack_len_ > 0) {
+        std::uint32_t right[8];
+        compress(input_cv.data(), block, block_len, counter, flags, right);
+        const auto &left = cv_stack_[--cv_stack_len_];
+        std::copy(left.begin(), left.end(), block);
+        std::copy(right, right + 8, block + 8);
+        input_cv = kIv;
+        block_len = kBlockLen;
+        counter = 0;
+        flags = kParent;
+    }
+    std::uint32_t root[8];
+    compress(input_cv.data(), block, block_len, 0, flags | kRoot, root);
+
+    std::array<std::uint8_t, 32> digest{};
+    for (std::size_t i = 0; i < 8; ++i) {
+        digest[i * 4] = static_cast<std::uint8_t>(root[i] & 0xFFu);
+        digest[i * 4 + 1] = static_cast<std::uint8_t>((root[i] >> 8) & 0xFFu);
+        digest[i * 4 + 2] = static_cast<std::uint8_t>((root[i] >> 16) & 0xFFu);
+        digest[i * 4 + 3] = static_cast<std::uint8_t>((root[i] >> 24) & 0xFFu);
+    }
+    Reset();
+    return digest;
+}
+
+std::array<std::uint8_t, 32> Blake3(const std::uint8_t *data, std::size_t len) {
+    Blake3Context context;
+    context.Update(data, len);
+    return context.Final();
+}
+
+std::array<std::uint8_t, 32> Blake3(std::string_view data) {
+    return Blake3(reinterpret_cast<const std::uint8_t *>(data.data()), data.size());
+}
+
+}  // namespace wslmon
@@ -0,0 +1,156 @@
+#include "chain_state_file.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace wslmon {
+
+namespace {
+constexpr std::size_t kPageSize = 4096;
+constexpr std::size_t kSlotStride = 128;
+constexpr char kMagic[8] = {'W', 'S', 'L', 'M', 'C', 'S', '0', '1'};
+
+struct Slot {
+    char magic[8];
+    std::uint64_t generation;
+    std::uint64_t next_sequence;
+    std::uint64_t entries_since_rotation;
+    std::uint64_t log_size;
+    std::uint8_t chain[32];
+    std::uint8_t algorithm;
+    std::uint8_t reserved[7];
+    // FNV-1a over every byte before this field.
+    std::uint64_t checksum;
+};
+static_assert(std::is_trivially_copyable_v<Slot> && sizeof(Slot) <= kSlotStride);
+
+std::uint64_t slot_checksum(const Slot &slot) {
+    const auto *bytes = reinterpret_cast<const unsigned char *>(&slot);
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    for (std::size_t i = 0; i < offsetof(Slot, checksum); ++i) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+bool read_slot(const unsigned char *view, std::size_t index, Slot &slot) {
+    std::memcpy(&slot, view + index * kSlotStride, sizeof(slot));
+    return std::memcmp(slot.magic, kMagic, sizeof(kMagic)) == 0 && slot.checksum == slot_checksum(slot);
+}
+}  // namespace
+
+ChainStateFile::~ChainStateFile() {
+    Close();
+}
+
+#ifdef _WIN32
+
+bool ChainStateFile::Open(const std::filesystem::path &path) {
+    Close();
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    // Sizing the mapping to a page also extends the file.
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE, 0, static_cast<DWORD>(kPageSize), nullptr);
+    CloseHandle(file);
+    if (!mapping) {
+        return false;
+    }
+    void *view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, kPageSize);
+    CloseHandle(mapping);
+    view_ = static_cast<unsigned char *>(view);
+    generation_ = 0;
+    return view_ != nullptr;
+}
+
+void ChainStateFile::Close() {
+    if (view_) {
+        UnmapViewOfFile(view_);
+        view_ = nullptr;
+    }
+}
+
+#else
+
+bool ChainStateFile::Open(const std::filesystem::path &path) {
+    Close();
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 ||
+        (static_cast<std::size_t>(info.st_size) != kPageSize && ::ftruncate(fd, kPageSize) != 0)) {
+        ::close(fd);
+        return false;
+    }
+    void *view = ::mmap(nullptr, kPageSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    view_ = static_cast<unsigned char *>(view);
+    generation_ = 0;
+    return true;
+}
+
+void ChainStateFile::Close() {
+    if (view_) {
+        ::munmap(view_, kPageSize);
+        view_ = nullptr;
+    }
+}
+
+#endif
+
+bool ChainStateFile::Load(ChainState &state) {
+    if (!view_) {
+        return false;
+    }
+    Slot slots[2];
+    const bool valid[2] = {read_slot(view_, 0, slots[0]), read_slot(view_, 1, slots[1])};
+    if (!valid[0] && !valid[1]) {
+        return false;
+    }
+    const Slot &newest =
+        !valid[1] || (valid[0] && slots[0].generation > slots[1].generation) ? slots[0] : slots[1];
+    std::memcpy(state.chain.data(), newest.chain, state.chain.size());
+    state.next_sequence = newest.next_sequence;
+    state.entries_since_rotation = newest.entries_since_rotation;
+    state.log_size = newest.log_size;
+    state.algorithm = newest.algorithm;
+    generation_ = newest.generation;
+    return true;
+}
+
+void ChainStateFile::Store(const ChainState &state) {
+    if (!view_) {
+        return;
+    }
+    Slot slot{};
+    std::memcpy(slot.magic, kMagic, sizeof(kMagic));
+    slot.generation = ++generation_;
+    slot.next_sequence = state.next_sequence;
+    slot.entries_since_rotation = state.entries_since_rotation;
+    slot.log_size = state.log_size;
+    std::memcpy(slot.chain, state.chain.data(), state.chain.size());
+    slot.algorithm = state.algorithm;
+    slot.checksum = slot_checksum(slot);
+    // Overwrite the older slot; the newer one stays intact until the next
+    // Store.
+    std::memcpy(view_ + (slot.generation & 1) * kSlotStride, &slot, sizeof(slot));
+}
+
+}  // namespace wslmon
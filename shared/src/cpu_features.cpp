@@ -0,0 +1,96 @@
+#include "cpu_features.hpp"
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define WSLMON_CPU_X86 1
+#if defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define WSLMON_CPU_ARM64 1
+#if defined(__linux__)
+#include <sys/auxv.h>
+#ifndef HWCAP_SHA2
+#define HWCAP_SHA2 (1 << 6)
+#endif
+#elif defined(_WIN32)
+#include <Windows.h>
+#endif
+#endif
+
+namespace wslmon {
+namespace {
+
+#if defined(WSLMON_CPU_X86)
+void cpuid(std::uint32_t leaf, std::uint32_t subleaf, std::uint32_t regs[4]) {
+#if defined(_MSC_VER)
+    int info[4] = {};
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i) {
+        regs[i] = static_cast<std::uint32_t>(info[i]);
+    }
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+std::uint64_t read_xcr0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    std::uint32_t eax = 0;
+    std::uint32_t edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<std::uint64_t>(edx) << 32) | eax;
+#endif
+}
+#endif
+
+CpuFeatures detect() {
+    CpuFeatures features;
+#if defined(WSLMON_CPU_X86)
+    std::uint32_t regs[4] = {};
+    cpuid(0, 0, regs);
+    const std::uint32_t max_leaf = regs[0];
+    if (max_leaf < 1) {
+        return features;
+    }
+    cpuid(1, 0, regs);
+    features.ssse3 = (regs[2] & (1u << 9)) != 0;
+    features.sse41 = (regs[2] & (1u << 19)) != 0;
+    const bool osxsave = (regs[2] & (1u << 27)) != 0;
+    const bool avx = (regs[2] & (1u << 28)) != 0;
+    const std::uint64_t xcr0 = osxsave ? read_xcr0() : 0;
+    const bool ymm_state = (xcr0 & 0x6) == 0x6;
+    const bool zmm_state = (xcr0 & 0xE6) == 0xE6;
+    if (max_leaf >= 7) {
+        cpuid(7, 0, regs);
+        features.avx2 = avx && ymm_state && (regs[1] & (1u << 5)) != 0;
+        features.bmi2 = (regs[1] & (1u << 8)) != 0;
+        features.avx512f = zmm_state && (regs[1] & (1u << 16)) != 0;
+        features.sha = (regs[1] & (1u << 29)) != 0;
+    }
+#elif defined(WSLMON_CPU_ARM64)
+#if defined(__linux__)
+    features.arm_sha2 = (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#elif defined(_WIN32)
+    features.arm_sha2 = IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE) != 0;
+#elif defined(__APPLE__)
+    features.arm_sha2 = true;
+#endif
+#endif
+    return features;
+}
+
+}  // namespace
+
+const CpuFeatures &GetCpuFeatures() {
+    static const CpuFeatures features = detect();
+    return features;
+}
+
+}  // namespace wslmon
@@ -7,6 +7,18 @@
 #include <stdexcept>
 #include <vector>
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WSLMON_SHA256_X86 1
+#include <immintrin.h>
+#elif (defined(__aarch64__) && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))) || defined(_M_ARM64)
+// The ARMv8 backend needs the crypto extension enabled at compile time
+// (e.g. -march=armv8-a+crypto); it is still gated on the runtime check.
+#define WSLMON_SHA256_ARM 1
+#include <arm_neon.h>
+#endif
+
+#include "cpu_features.hpp"
+
 namespace wslmon {
 namespace {
 
@@ -57,145 +69,396 @@ inline std::uint32_t Gamma1(std::uint32_t x) {
     return RightRotate(x, 17) ^ RightRotate(x, 19) ^ (x >> 10);
 }
 
-std::array<std::uint8_t, 32> Sha256Internal(const std::uint8_t *data, std::size_t len) {
-    std::array<std::uint32_t, 64> message_schedule{};
-    std::array<std::uint32_t, 8> hash = kInitHash;
+inline std::uint32_t LoadBigEndian32(const std::uint8_t *bytes) {
+    return static_cast<std::uint32_t>(bytes[0]) << 24 | static_cast<std::uint32_t>(bytes[1]) << 16 |
+           static_cast<std::uint32_t>(bytes[2]) << 8 | static_cast<std::uint32_t>(bytes[3]);
+}
 
-    const std::size_t block_size = 64;
-    std::size_t processed = 0;
+// Runs the 64 rounds. |schedule| holds W[i], or W[i] + K[i] when
+// |constants_added| is set.
+template <bool constants_added>
+inline void CompressRounds(std::uint32_t *state, const std::uint32_t *schedule) {
+    std::uint32_t a = state[0];
+    std::uint32_t b = state[1];
+    std::uint32_t c = state[2];
+    std::uint32_t d = state[3];
+    std::uint32_t e = state[4];
+    std::uint32_t f = state[5];
+    std::uint32_t g = state[6];
+    std::uint32_t h = state[7];
+
+    for (std::size_t i = 0; i < 64; ++i) {
+        std::uint32_t t1 = h + Sigma1(e) + Ch(e, f, g) + schedule[i];
+        if constexpr (!constants_added) {
+            t1 += kRoundConstants[i];
+        }
+        std::uint32_t t2 = Sigma0(a) + Maj(a, b, c);
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
 
-    while (processed + block_size <= len) {
-        std::memcpy(message_schedule.data(), data + processed, block_size);
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+// Compression functions consume |count| consecutive 64-byte blocks and
+// update the eight-word state in place.
+using CompressFn = void (*)(std::uint32_t *state, const std::uint8_t *blocks, std::size_t count);
+
+void CompressScalar(std::uint32_t *state, const std::uint8_t *blocks, std::size_t count) {
+    std::array<std::uint32_t, 64> message_schedule{};
+    for (; count > 0; --count, blocks += 64) {
         for (std::size_t i = 0; i < 16; ++i) {
-            message_schedule[i] =
-                (message_schedule[i] & 0x000000FFu) << 24 | (message_schedule[i] & 0x0000FF00u) << 8 |
-                (message_schedule[i] & 0x00FF0000u) >> 8 | (message_schedule[i] & 0xFF000000u) >> 24;
+            message_schedule[i] = LoadBigEndian32(blocks + i * 4);
         }
         for (std::size_t i = 16; i < 64; ++i) {
             message_schedule[i] = Gamma1(message_schedule[i - 2]) + message_schedule[i - 7] +
                                   Gamma0(message_schedule[i - 15]) + message_schedule[i - 16];
         }
+        CompressRounds<false>(state, message_schedule.data());
+    }
+}
 
-        std::uint32_t a = hash[0];
-        std::uint32_t b = hash[1];
-        std::uint32_t c = hash[2];
-        std::uint32_t d = hash[3];
-        std::uint32_t e = hash[4];
-        std::uint32_t f = hash[5];
-        std::uint32_t g = hash[6];
-        std::uint32_t h = hash[7];
-
-        for (std::size_t i = 0; i < 64; ++i) {
-            std::uint32_t t1 = h + Sigma1(e) + Ch(e, f, g) + kRoundConstants[i] + message_schedule[i];
-            std::uint32_t t2 = Sigma0(a) + Maj(a, b, c);
-            h = g;
-            g = f;
-            f = e;
-            e = d + t1;
-            d = c;
-            c = b;
-            b = a;
-            a = t1 + t2;
-        }
-
-        hash[0] += a;
-        hash[1] += b;
-        hash[2] += c;
-        hash[3] += d;
-        hash[4] += e;
-        hash[5] += f;
-        hash[6] += g;
-        hash[7] += h;
+#if defined(WSLMON_SHA256_X86)
 
-        processed += block_size;
-    }
+#if defined(__GNUC__) || defined(__clang__)
+#define WSLMON_TARGET_AVX2_BMI2 __attribute__((target("avx2,bmi2")))
+#define WSLMON_TARGET_SHA __attribute__((target("sha,sse4.1")))
+#else
+#define WSLMON_TARGET_AVX2_BMI2
+#define WSLMON_TARGET_SHA
+#endif
 
-    std::array<std::uint8_t, 64> buffer{};
-    std::size_t buffer_len = len - processed;
-    std::memcpy(buffer.data(), data + processed, buffer_len);
+WSLMON_TARGET_AVX2_BMI2 inline __m128i RotateRight128(__m128i value, int bits) {
+    return _mm_or_si128(_mm_srli_epi32(value, bits), _mm_slli_epi32(value, 32 - bits));
+}
 
-    buffer[buffer_len++] = 0x80u;
+WSLMON_TARGET_AVX2_BMI2 inline __m128i SmallSigma0x4(__m128i value) {
+    return _mm_xor_si128(_mm_xor_si128(RotateRight128(value, 7), RotateRight128(value, 18)), _mm_srli_epi32(value, 3));
+}
 
-    if (buffer_len > 56) {
-        std::fill(buffer.begin() + buffer_len, buffer.end(), 0);
+WSLMON_TARGET_AVX2_BMI2 inline __m128i SmallSigma1x4(__m128i value) {
+    return _mm_xor_si128(_mm_xor_si128(RotateRight128(value, 17), RotateRight128(value, 19)),
+                         _mm_srli_epi32(value, 10));
+}
 
-        message_schedule.fill(0);
-        std::memcpy(message_schedule.data(), buffer.data(), block_size);
-        for (std::size_t i = 0; i < 16; ++i) {
-            message_schedule[i] =
-                (message_schedule[i] & 0x000000FFu) << 24 | (message_schedule[i] & 0x0000FF00u) << 8 |
-                (message_schedule[i] & 0x00FF0000u) >> 8 | (message_schedule[i] & 0xFF000000u) >> 24;
+// Expands the message schedule four words at a time with vector shifts.
+// W[t+2] and W[t+3] depend on W[t] and W[t+1], so sigma1 is applied in two
+// halves. The rounds stay scalar; this target lets them use BMI2 rorx.
+WSLMON_TARGET_AVX2_BMI2 void CompressAvx2(std::uint32_t *state, const std::uint8_t *blocks, std::size_t count) {
+    alignas(16) std::uint32_t message_schedule[64];
+    alignas(16) std::uint32_t scheduled[64];
+    const __m128i byte_swap = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    for (; count > 0; --count, blocks += 64) {
+        for (std::size_t i = 0; i < 16; i += 4) {
+            const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i *>(blocks + i * 4));
+            _mm_store_si128(reinterpret_cast<__m128i *>(message_schedule + i), _mm_shuffle_epi8(words, byte_swap));
         }
-        for (std::size_t i = 16; i < 64; ++i) {
-            message_schedule[i] = Gamma1(message_schedule[i - 2]) + message_schedule[i - 7] +
-                                  Gamma0(message_schedule[i - 15]) + message_schedule[i - 16];
+        for (std::size_t t = 16; t < 64; t += 4) {
+            const __m128i w16 = _mm_load_si128(reinterpret_cast<const __m128i *>(message_schedule + t - 16));
+            const __m128i w15 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(message_schedule + t - 15));
+            const __m128i w7 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(message_schedule + t - 7));
+            const __m128i w2 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(message_schedule + t - 2));
+            __m128i words = _mm_add_epi32(_mm_add_epi32(w16, SmallSigma0x4(w15)), w7);
+            words = _mm_add_epi32(words, SmallSigma1x4(w2));
+            words = _mm_add_epi32(words, SmallSigma1x4(_mm_slli_si128(words, 8)));
+            _mm_store_si128(reinterpret_cast<__m128i *>(message_schedule + t), words);
+        }
+        for (std::size_t t = 0; t < 64; t += 4) {
+            const __m128i words = _mm_load_si128(reinterpret_cast<const __m128i *>(message_schedule + t));
+            const __m128i constants = _mm_loadu_si128(reinterpret_cast<const __m128i *>(kRoundConstants.data() + t));
+            _mm_store_si128(reinterpret_cast<__m128i *>(scheduled + t), _mm_add_epi32(words, constants));
+        }
+        CompressRounds<true>(state, scheduled);
+    }
+}
+
+// SHA-NI keeps the state as ABEF/CDGH register pairs. Each group of four
+// rounds derives the next schedule words with sha256msg1/msg2 and runs two
+// sha256rnds2 steps.
+WSLMON_TARGET_SHA void CompressShaNi(std::uint32_t *state, const std::uint8_t *blocks, std::size_t count) {
+    const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state));
+    __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state + 4));
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);
+    state1 = _mm_shuffle_epi32(state1, 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    for (; count > 0; --count, blocks += 64) {
+        const __m128i abef_save = state0;
+        const __m128i cdgh_save = state1;
+        __m128i words[4];
+        for (int group = 0; group < 16; ++group) {
+            __m128i &current = words[group & 3];
+            if (group < 4) {
+                current = _mm_shuffle_epi8(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(blocks + group * 16)), byte_swap);
+            } else {
+                const __m128i &prev1 = words[(group - 1) & 3];
+                const __m128i &prev2 = words[(group - 2) & 3];
+                const __m128i &prev3 = words[(group - 3) & 3];
+                current = _mm_sha256msg2_epu32(
+                    _mm_add_epi32(_mm_sha256msg1_epu32(current, prev3), _mm_alignr_epi8(prev1, prev2, 4)), prev1);
+            }
+            __m128i message = _mm_add_epi32(
+                current, _mm_loadu_si128(reinterpret_cast<const __m128i *>(kRoundConstants.data() + group * 4)));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, message);
+            message = _mm_shuffle_epi32(message, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, message);
         }
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state + 4), state1);
+}
 
-        std::uint32_t a = hash[0];
-        std::uint32_t b = hash[1];
-        std::uint32_t c = hash[2];
-        std::uint32_t d = hash[3];
-        std::uint32_t e = hash[4];
-        std::uint32_t f = hash[5];
-        std::uint32_t g = hash[6];
-        std::uint32_t h = hash[7];
-
-        for (std::size_t i = 0; i < 64; ++i) {
-            std::uint32_t t1 = h + Sigma1(e) + Ch(e, f, g) + kRoundConstants[i] + message_schedule[i];
-            std::uint32_t t2 = Sigma0(a) + Maj(a, b, c);
-            h = g;
-            g = f;
-            f = e;
-            e = d + t1;
-            d = c;
-            c = b;
-            b = a;
-            a = t1 + t2;
+#endif  // WSLMON_SHA256_X86
+
+#if defined(WSLMON_SHA256_ARM)
+
+// ARMv8 keeps the state as plain ABCD/EFGH vectors; sha256su0/su1 extend
+// the schedule and sha256h/h2 run four rounds per step.
+void CompressArmV8(std::uint32_t *state, const std::uint8_t *blocks, std::size_t count) {
+    uint32x4_t state0 = vld1q_u32(state);
+    uint32x4_t state1 = vld1q_u32(state + 4);
+
+    for (; count > 0; --count, blocks += 64) {
+        const uint32x4_t abcd_save = state0;
+        const uint32x4_t efgh_save = state1;
+        uint32x4_t words[4];
+        for (int group = 0; group < 16; ++group) {
+            uint32x4_t &current = words[group & 3];
+            if (group < 4) {
+                current = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + group * 16)));
+            } else {
+                current = vsha256su1q_u32(vsha256su0q_u32(current, words[(group - 3) & 3]), words[(group - 2) & 3],
+                                          words[(group - 1) & 3]);
+            }
+            const uint32x4_t message = vaddq_u32(current, vld1q_u32(kRoundConstants.data() + group * 4));
+            const uint32x4_t abcd = state0;
+            state0 = vsha256hq_u32(state0, state1, message);
+            state1 = vsha256h2q_u32(state1, abcd, message);
         }
+        state0 = vaddq_u32(state0, abcd_save);
+        state1 = vaddq_u32(state1, efgh_save);
+    }
+
+    vst1q_u32(state, state0);
+    vst1q_u32(state + 4, state1);
+}
 
-        hash[0] += a;
-        hash[1] += b;
-        hash[2] += c;
-        hash[3] += d;
-        hash[4] += e;
-        hash[5] += f;
-        hash[6] += g;
-        hash[7] += h;
+#endif  // WSLMON_SHA256_ARM
 
-        buffer.fill(0);
-        buffer_len = 0;
+Sha256Backend DetectBackend() {
+    const CpuFeatures &features = GetCpuFeatures();
+#if defined(WSLMON_SHA256_X86)
+    // The AVX2 schedule variant is not picked automatically: the rounds stay
+    // serial, and it measured no faster than the scalar code.
+    if (features.sha && features.sse41 && features.ssse3) {
+        return Sha256Backend::ShaNi;
     }
+#endif
+#if defined(WSLMON_SHA256_ARM)
+    if (features.arm_sha2) {
+        return Sha256Backend::ArmV8;
+    }
+#endif
+    (void)features;
+    return Sha256Backend::Scalar;
+}
+
+Sha256Backend ResolveBackend(Sha256Backend backend) {
+    static const Sha256Backend detected = DetectBackend();
+    if (backend == Sha256Backend::Auto || !Sha256BackendSupported(backend)) {
+        return detected;
+    }
+    return backend;
+}
+
+CompressFn BackendFunction(Sha256Backend backend) {
+    switch (ResolveBackend(backend)) {
+#if defined(WSLMON_SHA256_X86)
+        case Sha256Backend::ShaNi:
+            return CompressShaNi;
+        case Sha256Backend::Avx2:
+            return CompressAvx2;
+#endif
+#if defined(WSLMON_SHA256_ARM)
+        case Sha256Backend::ArmV8:
+            return CompressArmV8;
+#endif
+        default:
+            return CompressScalar;
+    }
+}
+
+CompressFn ActiveCompress() {
+    static const CompressFn active = BackendFunction(Sha256Backend::Auto);
+    return active;
+}
+
+std::array<std::uint8_t, 32> Sha256Internal(const std::uint8_t *data, std::size_t len, CompressFn compress) {
+    std::array<std::uint32_t, 8> hash = kInitHash;
 
-    std::fill(buffer.begin() + buffer_len, buffer.begin() + 56, 0);
+    const std::size_t block_size = 64;
+    const std::size_t full_blocks = len / block_size;
+    if (full_blocks > 0) {
+        compress(hash.data(), data, full_blocks);
+    }
+    const std::size_t processed = full_blocks * block_size;
+
+    // Padding: 0x80, zeros, then the 64-bit big-endian bit length, spilling
+    // into a second block when fewer than 9 bytes remain.
+    std::array<std::uint8_t, 128> buffer{};
+    std::size_t buffer_len = len - processed;
+    std::memcpy(buffer.data(), data + processed, buffer_len);
+    buffer[buffer_len++] = 0x80u;
+    const std::size_t tail_blocks = buffer_len > 56 ? 2 : 1;
     const std::uint64_t bit_len = static_cast<std::uint64_t>(len) * 8u;
     for (int i = 0; i < 8; ++i) {
-        buffer[63 - i] = static_cast<std::uint8_t>((bit_len >> (8 * i)) & 0xFFu);
+        buffer[tail_blocks * block_size - 1 - i] = static_cast<std::uint8_t>((bit_len >> (8 * i)) & 0xFFu);
+    }
+    compress(hash.data(), buffer.data(), tail_blocks);
+
+    std::array<std::uint8_t, 32> digest{};
+    for (std::size_t i = 0; i < 8; ++i) {
+        digest[i * 4] = static_cast<std::uint8_t>((hash[i] >> 24) & 0xFFu);
+        digest[i * 4 + 1] = static_cast<std::uint8_t>((hash[i] >> 16) & 0xFFu);
+        digest[i * 4 + 2] = static_cast<std::uint8_t>((hash[i] >> 8) & 0xFFu);
+        digest[i * 4 + 3] = static_cast<std::uint8_t>(hash[i] & 0xFFu);
+    }
+
+    return digest;
+}
+
+void StoreDigest(const std::array<std::uint32_t, 8> &state, std::array<std::uint8_t, 32> &digest) {
+    for (std::size_t i = 0; i < 8; ++i) {
+        digest[i * 4] = static_cast<std::uint8_t>((state[i] >> 24) & 0xFFu);
+        digest[i * 4 + 1] = static_cast<std::uint8_t>((state[i] >> 16) & 0xFFu);
+        digest[i * 4 + 2] = static_cast<std::uint8_t>((state[i] >> 8) & 0xFFu);
+        digest[i * 4 + 3] = static_cast<std::uint8_t>(state[i] & 0xFFu);
+    }
+}
+
+// One message for the multi-buffer engines: the full blocks still in the
+// caller's buffer followed by a padded tail of one or two blocks.
+struct LaneJob {
+    const std::uint8_t *data;
+    std::size_t data_blocks;
+    std::size_t tail_blocks;
+    std::array<std::uint32_t, 8> state;
+    std::array<std::uint8_t, 128> tail;
+};
+
+// |prefix_len| counts bytes already absorbed into |state|, e.g. the 64-byte
+// key block behind an HMAC midstate.
+void PrepareLaneJob(LaneJob &job,
+                    const std::uint8_t *data,
+                    std::size_t len,
+                    const std::array<std::uint32_t, 8> &state,
+                    std::uint64_t prefix_len) {
+    job.data = data;
+    job.data_blocks = len / 64;
+    job.state = state;
+    const std::size_t processed = job.data_blocks * 64;
+    std::size_t tail_len = len - processed;
+    job.tail.fill(0);
+    if (tail_len > 0) {
+        std::memcpy(job.tail.data(), data + processed, tail_len);
+    }
+    job.tail[tail_len++] = 0x80u;
+    job.tail_blocks = tail_len > 56 ? 2 : 1;
+    const std::uint64_t bit_len = (prefix_len + len) * 8u;
+    for (int i = 0; i < 8; ++i) {
+        job.tail[job.tail_blocks * 64 - 1 - i] = static_cast<std::uint8_t>((bit_len >> (8 * i)) & 0xFFu);
     }
+}
+
+inline const std::uint8_t *LaneJobBlock(const LaneJob &job, std::size_t index) {
+    return index < job.data_blocks ? job.data + index * 64 : job.tail.data() + (index - job.data_blocks) * 64;
+}
 
-    message_schedule.fill(0);
-    std::memcpy(message_schedule.data(), buffer.data(), block_size);
-    for (std::size_t i = 0; i < 16; ++i) {
-        message_schedule[i] =
-            (message_schedule[i] & 0x000000FFu) << 24 | (message_schedule[i] & 0x0000FF00u) << 8 |
-            (message_schedule[i] & 0x00FF0000u) >> 8 | (message_schedule[i] & 0xFF000000u) >> 24;
+// Finishes |job| from block |index| with the single-buffer backend.
+void FinishLaneJob(LaneJob &job, std::size_t index, CompressFn compress) {
+    if (index < job.data_blocks) {
+        compress(job.state.data(), job.data + index * 64, job.data_blocks - index);
+        index = job.data_blocks;
     }
-    for (std::size_t i = 16; i < 64; ++i) {
-        message_schedule[i] = Gamma1(message_schedule[i - 2]) + message_schedule[i - 7] +
-                              Gamma0(message_schedule[i - 15]) + message_schedule[i - 16];
+    const std::size_t tail_index = index - job.data_blocks;
+    if (tail_index < job.tail_blocks) {
+        compress(job.state.data(), job.tail.data() + tail_index * 64, job.tail_blocks - tail_index);
     }
+}
 
-    std::uint32_t a = hash[0];
-    std::uint32_t b = hash[1];
-    std::uint32_t c = hash[2];
-    std::uint32_t d = hash[3];
-    std::uint32_t e = hash[4];
-    std::uint32_t f = hash[5];
-    std::uint32_t g = hash[6];
-    std::uint32_t h = hash[7];
+using RunJobsFn = void (*)(LaneJob *jobs, std::size_t count);
 
-    for (std::size_t i = 0; i < 64; ++i) {
-        std::uint32_t t1 = h + Sigma1(e) + Ch(e, f, g) + kRoundConstants[i] + message_schedule[i];
-        std::uint32_t t2 = Sigma0(a) + Maj(a, b, c);
+void RunJobsSingle(LaneJob *jobs, std::size_t count) {
+    const CompressFn compress = ActiveCompress();
+    for (std::size_t i = 0; i < count; ++i) {
+        FinishLaneJob(jobs[i], 0, compress);
+    }
+}
+
+#if defined(WSLMON_SHA256_X86) && (defined(__GNUC__) || defined(__clang__))
+#define WSLMON_SHA256_LANES 1
+
+// The lane kernels use GCC vector extensions rather than intrinsics so one
+// template serves every width; the always_inline bodies pick up the target
+// ISA of the wrapper they are inlined into. MSVC builds use Single.
+typedef std::uint32_t LaneVector4 __attribute__((vector_size(16)));
+typedef std::uint32_t LaneVector8 __attribute__((vector_size(32)));
+typedef std::uint32_t LaneVector16 __attribute__((vector_size(64)));
+
+#define WSLMON_LANE_INLINE __attribute__((always_inline)) inline
+
+// A macro rather than a function: passing wide vectors by value outside
+// their target ISA changes the calling convention.
+#define WSLMON_LANE_ROTR(value, bits) (((value) >> (bits)) | ((value) << (32 - (bits))))
+
+// One compression per lane. |w| holds the lanes' sixteen message words and
+// is extended in place.
+template <typename V>
+WSLMON_LANE_INLINE void CompressLanes(V *state, V *w) {
+    V a = state[0];
+    V b = state[1];
+    V c = state[2];
+    V d = state[3];
+    V e = state[4];
+    V f = state[5];
+    V g = state[6];
+    V h = state[7];
+
+#pragma GCC unroll 64
+    for (int i = 0; i < 64; ++i) {
+        if (i >= 16) {
+            const V w15 = w[(i - 15) & 15];
+            const V w2 = w[(i - 2) & 15];
+            w[i & 15] += (WSLMON_LANE_ROTR(w15, 7) ^ WSLMON_LANE_ROTR(w15, 18) ^ (w15 >> 3)) + w[(i - 7) & 15] +
+                         (WSLMON_LANE_ROTR(w2, 17) ^ WSLMON_LANE_ROTR(w2, 19) ^ (w2 >> 10));
+        }
+        const V sigma1 = WSLMON_LANE_ROTR(e, 6) ^ WSLMON_LANE_ROTR(e, 11) ^ WSLMON_LANE_ROTR(e, 25);
+        const V sigma0 = WSLMON_LANE_ROTR(a, 2) ^ WSLMON_LANE_ROTR(a, 13) ^ WSLMON_LANE_ROTR(a, 22);
+        const V t1 = h + sigma1 + ((e & f) ^ (~e & g)) + kRoundConstants[i] + w[i & 15];
+        const V t2 = sigma0 + ((a & b) ^ (a & c) ^ (b & c));
         h = g;
         g = f;
         f = e;
@@ -206,26 +469,144 @@ std::array<std::uint8_t, 32> Sha256Internal(const std::uint8_t *data, std::size_
         a = t1 + t2;
     }
 
-    hash[0] += a;
-    hash[1] += b;
-    hash[2] += c;
-    hash[3] += d;
-    hash[4] += e;
-    hash[5] += f;
-    hash[6] += g;
-    hash[7] += h;
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+// Keeps every lane busy: when a lane's message ends its state is written
+// back and the next job takes the lane over. Once the queue is empty and
+// only a few lanes are still running, they finish on the single-buffer
+// backend instead of paying for a mostly idle vector pass.
+template <typename V>
+WSLMON_LANE_INLINE void RunJobsLanes(LaneJob *jobs, std::size_t count) {
+    constexpr std::size_t kLanes = sizeof(V) / sizeof(std::uint32_t);
+    static const std::uint8_t kIdleBlock[64] = {};
+    V state[8] = {};
+    V w[16];
+    // Transposed through plain memory: per-element vector inserts are slow.
+    alignas(64) std::uint32_t words[16][kLanes];
+    LaneJob *lane_job[kLanes] = {};
+    std::size_t lane_block[kLanes] = {};
+    std::size_t next = 0;
+    std::size_t active = 0;
+
+    for (std::size_t lane = 0; lane < kLanes && next < count; ++lane, ++active) {
+        lane_job[lane] = &jobs[next++];
+        for (std::size_t j = 0; j < 8; ++j) {
+            state[j][lane] = lane_job[lane]->state[j];
+        }
+    }
+
+    while (active > 0 && (next < count || active * 4 > kLanes)) {
+        for (std::size_t lane = 0; lane < kLanes; ++lane) {
+            const std::uint8_t *block =
+                lane_job[lane] ? LaneJobBlock(*lane_job[lane], lane_block[lane]) : kIdleBlock;
+            for (std::size_t t = 0; t < 16; ++t) {
+                words[t][lane] = LoadBigEndian32(block + t * 4);
+            }
+        }
+        std::memcpy(w, words, sizeof(w));
+        CompressLanes(state, w);
+        for (std::size_t lane = 0; lane < kLanes; ++lane) {
+            LaneJob *job = lane_job[lane];
+            if (!job || ++lane_block[lane] < job->data_blocks + job->tail_blocks) {
+                continue;
+            }
+            for (std::size_t j = 0; j < 8; ++j) {
+                job->state[j] = state[j][lane];
+            }
+            lane_job[lane] = nullptr;
+            lane_block[lane] = 0;
+            --active;
+            if (next < count) {
+                lane_job[lane] = &jobs[next++];
+                for (std::size_t j = 0; j < 8; ++j) {
+                    state[j][lane] = lane_job[lane]->state[j];
+                }
+                ++active;
+            }
+        }
+    }
 
-    std::array<std::uint8_t, 32> digest{};
-    for (std::size_t i = 0; i < 8; ++i) {
-        digest[i * 4] = static_cast<std::uint8_t>((hash[i] >> 24) & 0xFFu);
-        digest[i * 4 + 1] = static_cast<std::uint8_t>((hash[i] >> 16) & 0xFFu);
-        digest[i * 4 + 2] = static_cast<std::uint8_t>((hash[i] >> 8) & 0xFFu);
-        digest[i * 4 + 3] = static_cast<std::uint8_t>(hash[i] & 0xFFu);
+    const CompressFn compress = ActiveCompress();
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+        if (LaneJob *job = lane_job[lane]) {
+            for (std::size_t j = 0; j < 8; ++j) {
+                job->state[j] = state[j][lane];
+            }
+            FinishLaneJob(*job, lane_block[lane], compress);
+        }
     }
+}
 
-    return digest;
+void RunJobsSse2(LaneJob *jobs, std::size_t count) {
+    RunJobsLanes<LaneVector4>(jobs, count);
+}
+
+__attribute__((target("avx2"))) void RunJobsAvx2(LaneJob *jobs, std::size_t count) {
+    RunJobsLanes<LaneVector8>(jobs, count);
+}
+
+__attribute__((target("avx512f"))) void RunJobsAvx512(LaneJob *jobs, std::size_t count) {
+    RunJobsLanes<LaneVector16>(jobs, count);
+}
+
+#undef WSLMON_LANE_ROTR
+#undef WSLMON_LANE_INLINE
+
+#endif  // WSLMON_SHA256_LANES
+
+Sha256MultiBackend DetectMultiBackend() {
+#if defined(WSLMON_SHA256_LANES)
+    // Measured with shared_bench's hmac_sha256_many benchmarks on 320-byte
+    // HMACs: sixteen AVX-512 lanes beat one SHA-NI stream by ~1.4x, while
+    // AVX2 and SSE2 lanes only beat the scalar code, so hardware SHA wins
+    // over those.
+    const CpuFeatures &features = GetCpuFeatures();
+    if (features.avx512f) {
+        return Sha256MultiBackend::Avx512;
+    }
+    if (ResolveBackend(Sha256Backend::Auto) != Sha256Backend::Scalar) {
+        return Sha256MultiBackend::Single;
+    }
+    if (features.avx2) {
+        return Sha256MultiBackend::Avx2;
+    }
+    return Sha256MultiBackend::Sse2;
+#else
+    return Sha256MultiBackend::Single;
+#endif
+}
+
+RunJobsFn MultiBackendFunction(Sha256MultiBackend backend) {
+    static const Sha256MultiBackend detected = DetectMultiBackend();
+    if (backend == Sha256MultiBackend::Auto || !Sha256MultiBackendSupported(backend)) {
+        backend = detected;
+    }
+    switch (backend) {
+#if defined(WSLMON_SHA256_LANES)
+        case Sha256MultiBackend::Sse2:
+            return RunJobsSse2;
+        case Sha256MultiBackend::Avx2:
+            return RunJobsAvx2;
+        case Sha256MultiBackend::Avx512:
+            return RunJobsAvx512;
+#endif
+        default:
+            return RunJobsSingle;
+    }
 }
 
+// Jobs carry a copy of their tail, so large batches are processed in
+// slices to bound the scratch memory.
+constexpr std::size_t kLaneJobSlice = 256;
+
 inline int HexNibble(char c) {
     if ('0' <= c && c <= '9') {
         return c - '0';
@@ -245,7 +626,40 @@ std::array<std::uint8_t, 32> Sha256(const std::uint8_t *data, std::size_t len) {
     if (!data && len != 0) {
         throw std::invalid_argument("Sha256 called with null data and non-zero length");
     }
-    return Sha256Internal(data ? data : reinterpret_cast<const std::uint8_t *>(""), len);
+    return Sha256Internal(data ? data : reinterpret_cast<const std::uint8_t *>(""), len, ActiveCompress());
+}
+
+std::array<std::uint8_t, 32> Sha256(const std::uint8_t *data, std::size_t len, Sha256Backend backend) {
+    if (!data && len != 0) {
+        throw std::invalid_argument("Sha256 called with null data and non-zero length");
+    }
+    return Sha256Internal(data ? data : reinterpret_cast<const std::uint8_t *>(""), len, BackendFunction(backend));
+}
+
+Sha256Backend ActiveSha256Backend() {
+    return ResolveBackend(Sha256Backend::Auto);
+}
+
+bool Sha256BackendSupported(Sha256Backend backend) {
+    const CpuFeatures &features = GetCpuFeatures();
+    switch (backend) {
+        case Sha256Backend::Auto:
+        case Sha256Backend::Scalar:
+            return true;
+#if defined(WSLMON_SHA256_X86)
+        case Sha256Backend::Avx2:
+            return features.avx2 && features.bmi2;
+        case Sha256Backend::ShaNi:
+            return features.sha && features.sse41 && features.ssse3;
+#endif
+#if defined(WSLMON_SHA256_ARM)
+        case Sha256Backend::ArmV8:
+            return features.arm_sha2;
+#endif
+        default:
+            (void)features;
+            return false;
+    }
 }
 
 std::array<std::uint8_t, 32> Sha256(std::string_view data) {
@@ -255,13 +669,162 @@ std::array<std::uint8_t, 32> Sha256(std::string_view data) {
 std::vector<std::uint8_t> HmacSha256(const std::vector<std::uint8_t> &key,
                                      const std::uint8_t *data,
                                      std::size_t len) {
+    HmacSha256Context context(key);
+    context.Update(data, len);
+    const auto result = context.Final();
+    return std::vector<std::uint8_t>(result.begin(), result.end());
+}
+
+Sha256MultiBackend ActiveSha256MultiBackend() {
+    static const Sha256MultiBackend detected = DetectMultiBackend();
+    return detected;
+}
+
+bool Sha256MultiBackendSupported(Sha256MultiBackend backend) {
+    switch (backend) {
+        case Sha256MultiBackend::Auto:
+        case Sha256MultiBackend::Single:
+            return true;
+#if defined(WSLMON_SHA256_LANES)
+        case Sha256MultiBackend::Sse2:
+            return true;
+        case Sha256MultiBackend::Avx2:
+            return GetCpuFeatures().avx2;
+        case Sha256MultiBackend::Avx512:
+            return GetCpuFeatures().avx512f;
+#endif
+        default:
+            return false;
+    }
+}
+
+void Sha256Many(const std::string_view *messages,
+                std::size_t count,
+                std::array<std::uint8_t, 32> *digests,
+                Sha256MultiBackend backend) {
+    const RunJobsFn run = MultiBackendFunction(backend);
+    std::vector<LaneJob> jobs(std::min(count, kLaneJobSlice));
+    for (std::size_t base = 0; base < count; base += kLaneJobSlice) {
+        const std::size_t slice = std::min(count - base, kLaneJobSlice);
+        for (std::size_t i = 0; i < slice; ++i) {
+            const std::string_view message = messages[base + i];
+            PrepareLaneJob(jobs[i], reinterpret_cast<const std::uint8_t *>(message.data()), message.size(),
+                           kInitHash, 0);
+        }
+        run(jobs.data(), slice);
+        for (std::size_t i = 0; i < slice; ++i) {
+            StoreDigest(jobs[i].state, digests[base + i]);
+        }
+    }
+}
+
+struct HmacKeyAccess {
+    static const std::array<std::uint32_t, 8> &inner(const HmacKey &key) { return key.inner_state_; }
+    static const std::array<std::uint32_t, 8> &outer(const HmacKey &key) { return key.outer_state_; }
+};
+
+void HmacSha256Many(const HmacKey &key,
+                    const std::string_view *messages,
+                    std::size_t count,
+                    std::array<std::uint8_t, 32> *macs,
+                    Sha256MultiBackend backend) {
+    const RunJobsFn run = MultiBackendFunction(backend);
+    std::vector<LaneJob> jobs(std::min(count, kLaneJobSlice));
+    for (std::size_t base = 0; base < count; base += kLaneJobSlice) {
+        const std::size_t slice = std::min(count - base, kLaneJobSlice);
+        for (std::size_t i = 0; i < slice; ++i) {
+            const std::string_view message = messages[base + i];
+            PrepareLaneJob(jobs[i], reinterpret_cast<const std::uint8_t *>(message.data()), message.size(),
+                           HmacKeyAccess::inner(key), 64);
+        }
+        run(jobs.data(), slice);
+        // The outer hash covers the 32-byte inner digest: one padded block.
+        for (std::size_t i = 0; i < slice; ++i) {
+            StoreDigest(jobs[i].state, macs[base + i]);
+            PrepareLaneJob(jobs[i], macs[base + i].data(), macs[base + i].size(), HmacKeyAccess::outer(key), 64);
+        }
+        run(jobs.data(), slice);
+        for (std::size_t i = 0; i < slice; ++i) {
+            StoreDigest(jobs[i].state, macs[base + i]);
+        }
+    }
+}
+
+Sha256Context::Sha256Context() {
+    Reset();
+}
+
+void Sha256Context::Reset() {
+    state_ = kInitHash;
+    buffer_len_ = 0;
+    total_len_ = 0;
+}
+
+void Sha256Context::Update(const std::uint8_t *data, std::size_t len) {
+    if (len == 0) {
+        return;
+    }
+    const CompressFn compress = ActiveCompress();
+    total_len_ += len;
+    if (buffer_len_ > 0) {
+        const std::size_t take = std::min(len, buffer_.size() - buffer_len_);
+        std::memcpy(buffer_.data() + buffer_len_, data, take);
+        buffer_len_ += take;
+        data += take;
+        len -= take;
+        if (buffer_len_ < buffer_.size()) {
+            return;
+        }
+        compress(state_.data(), buffer_.data(), 1);
+        buffer_len_ = 0;
+    }
+    const std::size_t full_blocks = len / buffer_.size();
+    if (full_blocks > 0) {
+        compress(state_.data(), data, full_blocks);
+        data += full_blocks * buffer_.size();
+        len -= full_blocks * buffer_.size();
+    }
+    if (len > 0) {
+        std::memcpy(buffer_.data(), data, len);
+        buffer_len_ = len;
+    }
+}
+
+std::array<std::uint8_t, 32> Sha256Context::Final() {
+    std::array<std::uint8_t, 128> tail{};
+    std::memcpy(tail.data(), buffer_.data(), buffer_len_);
+    std::size_t tail_len = buffer_len_;
+    tail[tail_len++] = 0x80u;
+    const std::size_t tail_blocks = tail_len > 56 ? 2 : 1;
+    const std::uint64_t bit_len = total_len_ * 8u;
+    for (int i = 0; i < 8; ++i) {
+        tail[tail_blocks * 64 - 1 - i] = static_cast<std::uint8_t>((bit_len >> (8 * i)) & 0xFFu);
+    }
+    ActiveCompress()(state_.data(), tail.data(), tail_blocks);
+
+    std::array<std::uint8_t, 32> digest{};
+    for (std::size_t i = 0; i < 8; ++i) {
+        digest[i * 4] = static_cast<std::uint8_t>((state_[i] >> 24) & 0xFFu);
+        digest[i * 4 + 1] = static_cast<std::uint8_t>((state_[i] >> 16) & 0xFFu);
+        digest[i * 4 + 2] = static_cast<std::uint8_t>((state_[i] >> 8) & 0xFFu);
+        digest[i * 4 + 3] = static_cast<std::uint8_t>(state_[i] & 0xFFu);
+    }
+    Reset();
+    return digest;
+}
+
+Sha256Context::Sha256Context(const std::array<std::uint32_t, 8> &state, std::uint64_t consumed)
+    : state_(state), total_len_(consumed) {}
+
+HmacKey::HmacKey(const std::uint8_t *key, std::size_t key_len) {
     constexpr std::size_t block_size = 64;
-    std::vector<std::uint8_t> normalized_key = key;
-    if (normalized_key.size() > block_size) {
-        auto hashed = Sha256(normalized_key.data(), normalized_key.size());
-        normalized_key.assign(hashed.begin(), hashed.end());
+    std::array<std::uint8_t, block_size> normalized_key{};
+    if (key_len > block_size) {
+        const auto hashed = Sha256(key, key_len);
+        std::memcpy(normalized_key.data(), hashed.data(), hashed.size());
+    } else if (key_len > 0) {
+        std::memcpy(normalized_key.data(), key, key_len);
     }
-    normalized_key.resize(block_size, 0);
 
     std::array<std::uint8_t, block_size> o_key_pad{};
     std::array<std::uint8_t, block_size> i_key_pad{};
@@ -269,31 +832,48 @@ std::vector<std::uint8_t> HmacSha256(const std::vector<std::uint8_t> &key,
         o_key_pad[i] = normalized_key[i] ^ 0x5cu;
         i_key_pad[i] = normalized_key[i] ^ 0x36u;
     }
+    const CompressFn compress = ActiveCompress();
+    inner_state_ = kInitHash;
+    outer_state_ = kInitHash;
+    compress(inner_state_.data(), i_key_pad.data(), 1);
+    compress(outer_state_.data(), o_key_pad.data(), 1);
+    valid_ = true;
+}
 
-    std::vector<std::uint8_t> inner(block_size + len);
-    std::memcpy(inner.data(), i_key_pad.data(), block_size);
-    if (len > 0) {
-        std::memcpy(inner.data() + block_size, data, len);
-    }
-    auto inner_hash = Sha256(inner.data(), inner.size());
+void HmacKey::Clear() {
+    inner_state_.fill(0);
+    outer_state_.fill(0);
+    valid_ = false;
+}
 
-    std::vector<std::uint8_t> outer(block_size + inner_hash.size());
-    std::memcpy(outer.data(), o_key_pad.data(), block_size);
-    std::memcpy(outer.data() + block_size, inner_hash.data(), inner_hash.size());
+std::array<std::uint8_t, 32> HmacSha256(const HmacKey &key, const std::uint8_t *data, std::size_t len) {
+    HmacSha256Context context(key);
+    context.Update(data, len);
+    return context.Final();
+}
 
-    auto result = Sha256(outer.data(), outer.size());
-    return std::vector<std::uint8_t>(result.begin(), result.end());
+HmacSha256Context::HmacSha256Context(const HmacKey &key)
+    : inner_(key.inner_state_, 64), outer_(key.outer_state_, 64) {}
+
+std::array<std::uint8_t, 32> HmacSha256Context::Final() {
+    const auto inner_hash = inner_.Final();
+    outer_.Update(inner_hash.data(), inner_hash.size());
+    return outer_.Final();
 }
 
 std::string BytesToHex(const std::uint8_t *data, std::size_t len) {
-    static const char *kHex = "0123456789abcdef";
     std::string out;
     out.reserve(len * 2);
+    AppendHex(out, data, len);
+    return out;
+}
+
+void AppendHex(std::string &out, const std::uint8_t *data, std::size_t len) {
+    static const char *kHex = "0123456789abcdef";
     for (std::size_t i = 0; i < len; ++i) {
         out.push_back(kHex[(data[i] >> 4) & 0x0Fu]);
         out.push_back(kHex[data[i] & 0x0Fu]);
     }
-    return out;
 }
 
 std::vector<std::uint8_t> HexToBytes(std::string_view hex) {
@@ -2,66 +2,42 @@
 
 #include <algorithm>
 #include <cctype>
-#include <iomanip>
-#include <sstream>
+#include <charconv>
+#include <cmath>
+#include <limits>
 #include <string>
 #include <vector>
 
+#include "event_view.hpp"
+#include "json_escape.hpp"
+#include "timestamp.hpp"
+
 namespace wslmon {
 namespace {
-std::string format_timestamp(const std::chrono::system_clock::time_point &tp) {
-    using namespace std::chrono;
-    auto time_t_value = system_clock::to_time_t(tp);
-    std::tm tm{};
-#ifdef _WIN32
-    gmtime_s(&tm, &time_t_value);
-#else
-    gmtime_r(&time_t_value, &tm);
-#endif
-    auto fractional = duration_cast<microseconds>(tp.time_since_epoch()).count() % 1000000;
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%S");
-    oss << '.' << std::setw(6) << std::setfill('0') << fractional << "Z";
-    return oss.str();
+void append_digits(std::string &out, std::uint64_t value, int width) {
+    char digits[20];
+    int count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0 && count < 20);
+    for (int i = count; i < width; ++i) {
+        out.push_back('0');
+    }
+    while (count > 0) {
+        out.push_back(digits[--count]);
+    }
 }
 
-std::string escape(std::string_view input) {
-    std::string out;
-    out.reserve(input.size() + 2);
-    for (char c : input) {
-        switch (c) {
-            case '\\':
-                out += "\\\\";
-                break;
-            case '"':
-                out += "\\\"";
-                break;
-            case '\n':
-                out += "\\n";
-                break;
-            case '\r':
-                out += "\\r";
-                break;
-            case '\t':
-                out += "\\t";
-                break;
-            default:
-                if (static_cast<unsigned char>(c) < 0x20) {
-                    std::ostringstream oss;
-                    oss << "\\u" << std::hex << std::uppercase << std::setw(4) << std::setfill('0')
-                        << static_cast<int>(static_cast<unsigned char>(c));
-                    out += oss.str();
-                } else {
-                    out += c;
-                }
-        }
-    }
-    return out;
+void append_string_field(std::string &out, std::string_view name, std::string_view value) {
+    out.push_back('"');
+    out.append(name.data(), name.size());
+    out += "\":\"";
+    AppendJsonEscaped(out, value);
+    out += "\",";
 }
 
-std::string json_unescape(std::string_view input) {
-    std::string out;
-    out.reserve(input.size());
+void append_unescaped(std::string_view input, std::string &out) {
     for (std::size_t i = 0; i < input.size(); ++i) {
         char c = input[i];
         if (c != '\\') {
@@ -122,185 +98,657 @@ std::string json_unescape(std::string_view input) {
                 break;
         }
     }
-    return out;
 }
 
-bool extract_string(std::string_view json, std::string_view key, std::string &value) {
-    const std::string pattern = std::string("\"") + std::string(key) + "\":\"";
-    auto pos = json.find(pattern);
-    if (pos == std::string_view::npos) {
+// Forward-only cursor over a single JSON document. Every accessor advances
+// past the token it reads, so a record is decoded in one linear scan and
+// string values are unescaped straight into their destination.
+class JsonCursor {
+  public:
+    explicit JsonCursor(std::string_view json) : json_(json) {}
+
+    bool consume(char expected) {
+        skip_whitespace();
+        if (pos_ < json_.size() && json_[pos_] == expected) {
+            ++pos_;
+            return true;
+        }
         return false;
     }
-    pos += pattern.size();
-    std::string raw;
-    bool escaping = false;
-    for (std::size_t i = pos; i < json.size(); ++i) {
-        char c = json[i];
-        if (!escaping) {
-            if (c == '\\') {
-                escaping = true;
-            } else if (c == '"') {
-                value = json_unescape(raw);
+
+    // Returns the raw (still escaped) contents of the next string token.
+    bool read_raw_string(std::string_view &raw, bool &escaped) {
+        if (!consume('"')) {
+            return false;
+        }
+        const std::size_t begin = pos_;
+        escaped = false;
+        while (pos_ < json_.size()) {
+            char c = json_[pos_];
+            if (c == '"') {
+                raw = json_.substr(begin, pos_ - begin);
+                ++pos_;
                 return true;
-            } else {
-                raw.push_back(c);
             }
-        } else {
-            raw.push_back('\\');
-            raw.push_back(c);
-            escaping = false;
+            if (c == '\\') {
+                escaped = true;
+                ++pos_;
+            }
+            ++pos_;
         }
+        return false;
     }
-    return false;
-}
 
-bool extract_uint64(std::string_view json, std::string_view key, std::uint64_t &value) {
-    const std::string pattern = std::string("\"") + std::string(key) + "\":";
-    auto pos = json.find(pattern);
-    if (pos == std::string_view::npos) {
-        return false;
+    bool read_string(std::string &out) {
+        std::string_view raw;
+        bool escaped = false;
+        if (!read_raw_string(raw, escaped)) {
+            return false;
+        }
+        if (escaped) {
+            out.clear();
+            append_unescaped(raw, out);
+        } else {
+            out.assign(raw.data(), raw.size());
+        }
+        return true;
     }
-    pos += pattern.size();
-    std::size_t end = pos;
-    while (end < json.size() && std::isdigit(static_cast<unsigned char>(json[end]))) {
-        ++end;
+
+    bool read_symbol(Symbol &out) {
+        std::string_view raw;
+        bool escaped = false;
+        if (!read_raw_string(raw, escaped)) {
+            return false;
+        }
+        if (escaped) {
+            thread_local std::string scratch;
+            scratch.clear();
+            append_unescaped(raw, scratch);
+            out = Symbol::FromUntrusted(scratch);
+        } else {
+            out = Symbol::FromUntrusted(raw);
+        }
+        return true;
     }
-    if (end == pos) {
-        return false;
+
+    bool read_key(std::string_view &key) {
+        bool escaped = false;
+        return read_raw_string(key, escaped) && consume(':');
     }
-    try {
-        value = std::stoull(std::string(json.substr(pos, end - pos)));
+
+    // Reads a number token that fits in uint64. Anything else (a sign,
+    // fraction, exponent, or overflow) leaves the cursor at the start of
+    // the token, so the caller can still skip_value() past it.
+    bool read_uint64(std::uint64_t &value) {
+        skip_whitespace();
+        const std::size_t begin = pos_;
+        std::uint64_t result = 0;
+        while (pos_ < json_.size() && json_[pos_] >= '0' && json_[pos_] <= '9') {
+            const auto digit = static_cast<std::uint64_t>(json_[pos_] - '0');
+            if (result > (std::numeric_limits<std::uint64_t>::max() - digit) / 10) {
+                pos_ = begin;
+                return false;
+            }
+            result = result * 10 + digit;
+            ++pos_;
+        }
+        const bool fraction = pos_ < json_.size() && (json_[pos_] == '.' || json_[pos_] == 'e' || json_[pos_] == 'E');
+        if (pos_ == begin || fraction) {
+            pos_ = begin;
+            return false;
+        }
+        value = result;
         return true;
-    } catch (const std::exception &) {
-        return false;
     }
-}
 
-bool parse_timestamp(std::string_view json,
-                     std::string_view key,
-                     std::chrono::system_clock::time_point &tp) {
-    std::string ts;
-    if (!extract_string(json, key, ts)) {
-        return false;
+    bool skip_value() {
+        skip_whitespace();
+        if (pos_ >= json_.size()) {
+            return false;
+        }
+        const char c = json_[pos_];
+        if (c == '"') {
+            std::string_view ignored;
+            bool escaped = false;
+            return read_raw_string(ignored, escaped);
+        }
+        if (c == '{' || c == '[') {
+            const char close = c == '{' ? '}' : ']';
+            ++pos_;
+            if (consume(close)) {
+                return true;
+            }
+            do {
+                if (c == '{') {
+                    std::string_view ignored;
+                    if (!read_key(ignored)) {
+                        return false;
+                    }
+                }
+                if (!skip_value()) {
+                    return false;
+                }
+            } while (consume(','));
+            return consume(close);
+        }
+        const std::size_t begin = pos_;
+        while (pos_ < json_.size() && json_[pos_] != ',' && json_[pos_] != '}' && json_[pos_] != ']' &&
+               !std::isspace(static_cast<unsigned char>(json_[pos_]))) {
+            ++pos_;
+        }
+        return pos_ != begin;
     }
-    if (ts.size() < 19) {
-        return false;
+
+  private:
+    void skip_whitespace() {
+        while (pos_ < json_.size() && std::isspace(static_cast<unsigned char>(json_[pos_]))) {
+            ++pos_;
+        }
     }
-    std::tm parsed{};
-    std::istringstream ss(ts.substr(0, 19));
-    ss >> std::get_time(&parsed, "%Y-%m-%dT%H:%M:%S");
-    if (ss.fail()) {
+
+    std::string_view json_;
+    std::size_t pos_ = 0;
+};
+
+bool read_attribute(JsonCursor &cursor, EventAttribute &attribute) {
+    attribute.key = Symbol();
+    std::string &value = attribute.value.assign_text();
+    if (!cursor.consume('{')) {
         return false;
     }
-#ifdef _WIN32
-    std::time_t time_value = _mkgmtime(&parsed);
-#else
-    std::time_t time_value = timegm(&parsed);
-#endif
-    if (time_value == static_cast<std::time_t>(-1)) {
-        return false;
+    if (cursor.consume('}')) {
+        return true;
     }
-    tp = std::chrono::system_clock::from_time_t(time_value);
-    auto dot_pos = ts.find('.');
-    if (dot_pos != std::string::npos) {
-        auto frac = ts.substr(dot_pos + 1);
-        if (!frac.empty() && frac.back() == 'Z') {
-            frac.pop_back();
+    do {
+        std::string_view key;
+        if (!cursor.read_key(key)) {
+            return false;
+        }
+        bool ok = false;
+        if (key == "key") {
+            ok = cursor.read_symbol(attribute.key);
+        } else if (key == "value") {
+            ok = cursor.read_string(value);
+        } else {
+            ok = cursor.skip_value();
         }
-        while (frac.size() < 6) {
-            frac.push_back('0');
+        if (!ok) {
+            return false;
         }
-        try {
-            auto micros = std::stoll(frac.substr(0, 6));
-            tp += std::chrono::microseconds(micros);
-        } catch (const std::exception &) {
+    } while (cursor.consume(','));
+    return cursor.consume('}');
+}
+
+bool read_attributes(JsonCursor &cursor, EventAttributeList &attributes) {
+    // Decode into the existing elements first so a reused record keeps the
+    // capacity of its attribute strings across calls.
+    std::size_t count = 0;
+    if (!cursor.consume('[')) {
+        return false;
+    }
+    if (!cursor.consume(']')) {
+        do {
+            if (count == attributes.size()) {
+                attributes.emplace_back();
+            }
+            if (!read_attribute(cursor, attributes[count])) {
+                return false;
+            }
+            if (!attributes[count].key.empty() || !attributes[count].value.empty()) {
+                ++count;
+            }
+        } while (cursor.consume(','));
+        if (!cursor.consume(']')) {
+            return false;
         }
     }
+    attributes.resize(count);
     return true;
 }
 
-bool extract_attributes(std::string_view json, std::vector<EventAttribute> &attributes) {
-    const std::string pattern = "\"attributes\":[";
-    auto pos = json.find(pattern);
-    if (pos == std::string_view::npos) {
+bool read_attribute_view(JsonCursor &cursor, EventViewAttribute &attribute) {
+    attribute = EventViewAttribute{};
+    if (!cursor.consume('{')) {
         return false;
     }
-    pos += pattern.size();
-    auto end = json.find(']', pos);
-    if (end == std::string_view::npos) {
-        return false;
+    if (cursor.consume('}')) {
+        return true;
     }
-    std::string_view array_view = json.substr(pos, end - pos);
-    std::size_t index = 0;
-    attributes.clear();
-    while (index < array_view.size()) {
-        auto start = array_view.find('{', index);
-        if (start == std::string_view::npos) {
-            break;
+    do {
+        std::string_view key;
+        if (!cursor.read_key(key)) {
+            return false;
+        }
+        bool ok = false;
+        if (key == "key") {
+            ok = cursor.read_symbol(attribute.key);
+        } else if (key == "value") {
+            std::string_view raw;
+            bool escaped = false;
+            ok = cursor.read_raw_string(raw, escaped);
+            attribute.value = JsonStringView(raw, escaped);
+        } else {
+            ok = cursor.skip_value();
         }
-        auto close = array_view.find('}', start);
-        if (close == std::string_view::npos) {
+        if (!ok) {
             return false;
         }
-        std::string_view item = array_view.substr(start, close - start + 1);
-        EventAttribute attribute;
-        extract_string(item, "key", attribute.key);
-        extract_string(item, "value", attribute.value);
-        if (!attribute.key.empty() || !attribute.value.empty()) {
-            attributes.push_back(std::move(attribute));
+    } while (cursor.consume(','));
+    return cursor.consume('}');
+}
+
+bool read_attribute_views(JsonCursor &cursor, EventArena &arena, EventView &view) {
+    // Attributes are collected in a per-thread scratch table and copied to
+    // the arena once the count is known, so the arena holds no slack.
+    thread_local std::vector<EventViewAttribute> scratch;
+    scratch.clear();
+    if (!cursor.consume('[')) {
+        return false;
+    }
+    if (!cursor.consume(']')) {
+        do {
+            EventViewAttribute attribute;
+            if (!read_attribute_view(cursor, attribute)) {
+                return false;
+            }
+            if (!attribute.key.empty() || !attribute.value.empty()) {
+                scratch.push_back(attribute);
+            }
+        } while (cursor.consume(','));
+        if (!cursor.consume(']')) {
+            return false;
         }
-        index = close + 1;
     }
+    view.attribute_count = scratch.size();
+    if (scratch.empty()) {
+        view.attributes = nullptr;
+        return true;
+    }
+    auto *table = arena.AllocateArray<EventViewAttribute>(scratch.size());
+    std::copy(scratch.begin(), scratch.end(), table);
+    view.attributes = table;
     return true;
 }
 
+template <typename Integer>
+void append_integer(std::string &out, Integer value) {
+    char buffer[24];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, static_cast<std::size_t>(result.ptr - buffer));
+}
+
+// std::to_string formats doubles as "%f"; fixed notation with precision 6
+// through to_chars produces the same text without locale or allocation.
+void append_double(std::string &out, double value) {
+    char buffer[400];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 6);
+    out.append(buffer, static_cast<std::size_t>(result.ptr - buffer));
+}
+
+// Text values are parsed like std::stoull/stod read a leading number, but
+// failures are reported through the optional rather than an exception.
+template <typename T>
+std::optional<T> parse_leading_number(std::string_view text) {
+    T value{};
+    const auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (result.ec != std::errc()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+template <typename T>
+std::optional<T> integral_from_double(double value) {
+    if (!std::isfinite(value) || value < static_cast<double>(std::numeric_limits<T>::min()) ||
+        value >= static_cast<double>(std::numeric_limits<T>::max())) {
+        return std::nullopt;
+    }
+    return static_cast<T>(value);
+}
+
+bool value_less(const AttributeValue &left, const AttributeValue &right) {
+    if (!left.is_number() && !right.is_number()) {
+        return left.text() < right.text();
+    }
+    thread_local std::string left_text;
+    thread_local std::string right_text;
+    left_text.clear();
+    right_text.clear();
+    left.AppendTo(left_text);
+    right.AppendTo(right_text);
+    return left_text < right_text;
+}
+
 }  // namespace
 
+std::string_view SeverityName(Severity severity) {
+    switch (severity) {
+        case Severity::Verbose:
+            return "Verbose";
+        case Severity::Info:
+            return "Info";
+        case Severity::Warning:
+            return "Warning";
+        case Severity::Error:
+            return "Error";
+        case Severity::Critical:
+            return "Critical";
+        case Severity::Unspecified:
+        default:
+            return {};
+    }
+}
+
+Severity ParseSeverity(std::string_view name) {
+    if (name.empty()) {
+        return Severity::Unspecified;
+    }
+    if (name == "Warning") {
+        return Severity::Warning;
+    }
+    if (name == "Error") {
+        return Severity::Error;
+    }
+    if (name == "Critical") {
+        return Severity::Critical;
+    }
+    if (name == "Verbose") {
+        return Severity::Verbose;
+    }
+    return Severity::Info;
+}
+
+std::string &AttributeValue::assign_text() {
+    type_ = AttributeType::String;
+    text_.clear();
+    return text_;
+}
+
+std::optional<std::int64_t> AttributeValue::as_int64() const {
+    switch (type_) {
+        case AttributeType::Int64:
+            return number_.i64;
+        case AttributeType::UInt64:
+            if (number_.u64 > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+                return std::nullopt;
+            }
+            return static_cast<std::int64_t>(number_.u64);
+        case AttributeType::Double:
+            return integral_from_double<std::int64_t>(number_.f64);
+        case AttributeType::String:
+        default:
+            return parse_leading_number<std::int64_t>(text_);
+    }
+}
+
+std::optional<std::uint64_t> AttributeValue::as_uint64() const {
+    switch (type_) {
+        case AttributeType::Int64:
+            if (number_.i64 < 0) {
+                return std::nullopt;
+            }
+            return static_cast<std::uint64_t>(number_.i64);
+        case AttributeType::UInt64:
+            return number_.u64;
+        case AttributeType::Double:
+            return integral_from_double<std::uint64_t>(number_.f64);
+        case AttributeType::String:
+        default:
+            return parse_leading_number<std::uint64_t>(text_);
+    }
+}
+
+std::optional<double> AttributeValue::as_double() const {
+    switch (type_) {
+        case AttributeType::Int64:
+            return static_cast<double>(number_.i64);
+        case AttributeType::UInt64:
+            return static_cast<double>(number_.u64);
+        case AttributeType::Double:
+            return number_.f64;
+        case AttributeType::String:
+        default:
+            return parse_leading_number<double>(text_);
+    }
+}
+
+void AttributeValue::AppendTo(std::string &out) const {
+    switch (type_) {
+        case AttributeType::Int64:
+            append_integer(out, number_.i64);
+            break;
+        case AttributeType::UInt64:
+            append_integer(out, number_.u64);
+            break;
+        case AttributeType::Double:
+            append_double(out, number_.f64);
+            break;
+        case AttributeType::String:
+        default:
+            out.append(text_);
+            break;
+    }
+}
+
+std::string AttributeValue::str() const {
+    if (type_ == AttributeType::String) {
+        return text_;
+    }
+    std::string out;
+    AppendTo(out);
+    return out;
+}
+
+bool AttributeValue::equals(std::string_view text) const {
+    if (type_ == AttributeType::String) {
+        return text_ == text;
+    }
+    thread_local std::string formatted;
+    formatted.clear();
+    AppendTo(formatted);
+    return formatted == text;
+}
+
+bool AttributeValue::equals(const AttributeValue &other) const {
+    if (other.type_ == AttributeType::String) {
+        return equals(std::string_view(other.text_));
+    }
+    if (type_ == other.type_) {
+        return str() == other.str();
+    }
+    return equals(std::string_view(other.str()));
+}
+
 std::string SerializeEvent(const EventRecord &record) {
-    std::ostringstream oss;
-    oss << '{';
-    oss << "\"timestamp\":\"" << escape(format_timestamp(record.timestamp)) << "\",";
-    oss << "\"sequence\":" << record.sequence << ',';
-    oss << "\"source\":\"" << escape(record.source) << "\",";
-    oss << "\"category\":\"" << escape(record.category) << "\",";
-    oss << "\"severity\":\"" << escape(record.severity) << "\",";
-    oss << "\"message\":\"" << escape(record.message) << "\",";
-
-    std::vector<EventAttribute> attributes = record.attributes;
-    std::sort(attributes.begin(), attributes.end(), [](const auto &lhs, const auto &rhs) {
-        if (lhs.key == rhs.key) {
-            return lhs.value < rhs.value;
+    std::string out;
+    SerializeEvent(record, out);
+    return out;
+}
+
+void SerializeEvent(const EventRecord &record, std::string &out) {
+    out += "{\"timestamp\":\"";
+    AppendTimestamp(out, record.timestamp);
+    out += "\",\"sequence\":";
+    append_digits(out, record.sequence, 1);
+    out.push_back(',');
+    append_string_field(out, "source", record.source);
+    append_string_field(out, "category", record.category);
+    append_string_field(out, "severity", SeverityName(record.severity));
+    append_string_field(out, "message", record.message);
+
+    // Attributes are emitted in (key, value) order. Sorting indices into a
+    // per-thread scratch vector keeps the steady state allocation-free.
+    thread_local std::vector<std::uint32_t> order;
+    order.resize(record.attributes.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        order[i] = static_cast<std::uint32_t>(i);
+    }
+    const auto &attributes = record.attributes;
+    std::sort(order.begin(), order.end(), [&attributes](std::uint32_t lhs, std::uint32_t rhs) {
+        const auto &left = attributes[lhs];
+        const auto &right = attributes[rhs];
+        if (left.key == right.key) {
+            return value_less(left.value, right.value);
         }
-        return lhs.key < rhs.key;
+        return left.key.view() < right.key.view();
     });
 
-    oss << "\"attributes\":[";
-    for (std::size_t i = 0; i < attributes.size(); ++i) {
-        const auto &attr = attributes[i];
-        oss << "{\"key\":\"" << escape(attr.key) << "\",\"value\":\"" << escape(attr.value) << "\"}";
-        if (i + 1 < attributes.size()) {
-            oss << ',';
+    out += "\"attributes\":[";
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        const auto &attr = attributes[order[i]];
+        out += "{\"key\":\"";
+        AppendJsonEscaped(out, attr.key);
+        out += "\",\"value\":\"";
+        if (attr.value.is_number()) {
+            // Formatted numbers never contain characters that need escaping.
+            attr.value.AppendTo(out);
+        } else {
+            AppendJsonEscaped(out, attr.value.text());
+        }
+        out += "\"}";
+        if (i + 1 < order.size()) {
+            out.push_back(',');
         }
     }
-    oss << "]}";
-    return oss.str();
+    out += "]}";
 }
 
 bool DeserializeEvent(std::string_view json, EventRecord &record) {
-    record = EventRecord{};
-    if (!parse_timestamp(json, "timestamp", record.timestamp)) {
+    record.source = Symbol();
+    record.category = Symbol();
+    record.severity = Severity::Unspecified;
+    record.message.clear();
+    record.timestamp = {};
+    record.sequence = 0;
+
+    JsonCursor cursor(json);
+    if (!cursor.consume('{')) {
         return false;
     }
-    if (!extract_uint64(json, "sequence", record.sequence)) {
-        record.sequence = 0;
+    bool has_timestamp = false;
+    bool has_attributes = false;
+    if (!cursor.consume('}')) {
+        do {
+            std::string_view key;
+            if (!cursor.read_key(key)) {
+                return false;
+            }
+            bool ok = false;
+            if (key == "timestamp") {
+                std::string_view raw;
+                bool escaped = false;
+                ok = cursor.read_raw_string(raw, escaped);
+                has_timestamp = ok && !escaped && ParseTimestamp(raw, record.timestamp);
+            } else if (key == "sequence") {
+                ok = cursor.read_uint64(record.sequence) || cursor.skip_value();
+            } else if (key == "source") {
+                ok = cursor.read_symbol(record.source);
+            } else if (key == "category") {
+                ok = cursor.read_symbol(record.category);
+            } else if (key == "severity") {
+                // Known severity names never contain escapes.
+                std::string_view raw;
+                bool escaped = false;
+                ok = cursor.read_raw_string(raw, escaped);
+                record.severity = ParseSeverity(raw);
+            } else if (key == "message") {
+                ok = cursor.read_string(record.message);
+            } else if (key == "attributes") {
+                ok = read_attributes(cursor, record.attributes);
+                has_attributes = ok;
+            } else {
+                ok = cursor.skip_value();
+            }
+            if (!ok) {
+                return false;
+            }
+        } while (cursor.consume(','));
+        if (!cursor.consume('}')) {
+            return false;
+        }
     }
-    extract_string(json, "source", record.source);
-    extract_string(json, "category", record.category);
-    extract_string(json, "severity", record.severity);
-    extract_string(json, "message", record.message);
-    extract_attributes(json, record.attributes);
-    return true;
+    if (!has_attributes) {
+        record.attributes.clear();
+    }
+    return has_timestamp;
 }
 
-}  // namespace wslmon
+std::string JsonStringView::str() const {
+    std::string out;
+    AppendTo(out);
+    return out;
+}
+
+void JsonStringView::AppendTo(std::string &out) const {
+    if (escaped_) {
+        append_unescaped(raw_, out);
+    } else {
+        out.append(raw_.data(), raw_.size());
+    }
+}
+
+bool ParseEventView(std::string_view json, EventArena &arena, EventView &view) {
+    view = EventView{};
+    view.json = json;
+
+    JsonCursor cursor(json);
+    if (!cursor.consume('{')) {
+        return false;
+    }
+    bool has_timestamp = false;
+    if (!cursor.consume('}')) {
+        do {
+            std::string_view key;
+            if (!cursor.read_key(key)) {
+                return false;
+            }
+            bool ok = false;
+            std::string_view raw;
+            bool escaped = false;
+            if (key == "timestamp") {
+                ok = cursor.read_raw_string(raw, escaped);
+                has_timestamp = ok && !escaped && ParseTimestamp(raw, view.timestamp);
+            } else if (key == "sequence") {
+                ok = cursor.read_uint64(view.sequence) || cursor.skip_value();
+            } else if (key == "source") {
+                ok = cursor.read_symbol(view.source);
+            } else if (key == "category") {
+                ok = cursor.read_symbol(view.category);
+            } else if (key == "severity") {
+                ok = cursor.read_raw_string(raw, escaped);
+                view.severity = ParseSeverity(raw);
+            } else if (key == "message") {
+                ok = cursor.read_raw_string(raw, escaped);
+                view.message = JsonStringView(raw, escaped);
+            } else if (key == "attributes") {
+                ok = read_attribute_views(cursor, arena, view);
+            } else {
+                ok = cursor.skip_value();
+            }
+            if (!ok) {
+                return false;
+            }
+        } while (cursor.consume(','));
+        if (!cursor.consume('}')) {
+            return false;
+        }
+    }
+    return has_timestamp;
+}
+
+void MaterializeEvent(const EventView &view, EventRecord &record) {
+    record.source = view.source;
+    record.category = view.category;
+    record.severity = view.severity;
+    record.message.clear();
+    view.message.AppendTo(record.message);
+    record.timestamp = view.timestamp;
+    record.sequence = view.sequence;
+    record.attributes.resize(view.attribute_count);
+    for (std::size_t i = 0; i < view.attribute_count; ++i) {
+        record.attributes[i].key = view.attributes[i].key;
+        view.attributes[i].value.AppendTo(record.attributes[i].value.assign_text());
+    }
+}
 
+}  // namespace wslmon
@@ -0,0 +1,83 @@
+#include "event_batch.hpp"
+
+namespace wslmon {
+
+void EventBatch::Reserve(std::size_t events, std::size_t attributes) {
+    timestamps_.reserve(events);
+    origins_.reserve(events);
+    categories_.reserve(events);
+    severities_.reserve(events);
+    sources_.reserve(events);
+    sequences_.reserve(events);
+    message_offsets_.reserve(events + 1);
+    attribute_offsets_.reserve(events + 1);
+    attribute_keys_.reserve(attributes);
+    value_offsets_.reserve(attributes + 1);
+}
+
+void EventBatch::Clear() {
+    timestamps_.clear();
+    origins_.clear();
+    categories_.clear();
+    severities_.clear();
+    sources_.clear();
+    sequences_.clear();
+    message_offsets_.assign(1, 0);
+    attribute_offsets_.assign(1, 0);
+    attribute_keys_.clear();
+    value_offsets_.assign(1, 0);
+    messages_.clear();
+    values_.clear();
+}
+
+void EventBatch::Append(Symbol origin, const EventRecord &record) {
+    messages_.append(record.message);
+    message_offsets_.push_back(messages_.size());
+    for (const auto &attr : record.attributes) {
+        attribute_keys_.push_back(attr.key);
+        attr.value.AppendTo(values_);
+        value_offsets_.push_back(values_.size());
+    }
+    finish_event(origin, record.source, record.category, record.severity, record.timestamp, record.sequence);
+}
+
+void EventBatch::Append(Symbol origin, const EventView &view) {
+    view.message.AppendTo(messages_);
+    message_offsets_.push_back(messages_.size());
+    for (const auto &attr : view) {
+        attribute_keys_.push_back(attr.key);
+        attr.value.AppendTo(values_);
+        value_offsets_.push_back(values_.size());
+    }
+    finish_event(origin, view.source, view.category, view.severity, view.timestamp, view.sequence);
+}
+
+void EventBatch::finish_event(Symbol origin, Symbol source, Symbol category, Severity severity, TimePoint timestamp,
+                              std::uint64_t sequence) {
+    attribute_offsets_.push_back(attribute_keys_.size());
+    timestamps_.push_back(timestamp);
+    origins_.push_back(origin);
+    categories_.push_back(category);
+    severities_.push_back(severity);
+    sources_.push_back(source);
+    sequences_.push_back(sequence);
+}
+
+void EventBatch::Materialize(std::size_t index, EventRecord &record) const {
+    record.source = sources_[index];
+    record.category = categories_[index];
+    record.severity = severities_[index];
+    record.message.assign(message(index));
+    record.timestamp = timestamps_[index];
+    record.sequence = sequences_[index];
+    const std::size_t begin = attribute_begin(index);
+    const std::size_t end = attribute_end(index);
+    record.attributes.resize(end - begin);
+    for (std::size_t i = begin; i < end; ++i) {
+        auto &attr = record.attributes[i - begin];
+        attr.key = attribute_keys_[i];
+        attr.value.assign_text().assign(attribute_value(i));
+    }
+}
+
+}  // namespace wslmon
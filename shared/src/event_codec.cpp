@@ -0,0 +1,194 @@
+#include "event_codec.hpp"
+
+namespace wslmon {
+namespace {
+constexpr std::size_t kMaxVarintBytes = 10;
+
+void put_varint(std::string &out, std::uint64_t value) {
+    while (value >= 0x80u) {
+        out.push_back(static_cast<char>((value & 0x7Fu) | 0x80u));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void put_string(std::string &out, std::string_view value) {
+    put_varint(out, value.size());
+    out.append(value.data(), value.size());
+}
+
+class ByteReader {
+  public:
+    explicit ByteReader(std::string_view data) : data_(data) {}
+
+    bool read_u8(std::uint8_t &value) {
+        if (pos_ >= data_.size()) {
+            return false;
+        }
+        value = static_cast<std::uint8_t>(data_[pos_++]);
+        return true;
+    }
+
+    bool read_i64(std::int64_t &value) {
+        if (data_.size() - pos_ < 8) {
+            return false;
+        }
+        std::uint64_t raw = 0;
+        for (int i = 0; i < 8; ++i) {
+            raw |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(data_[pos_ + i])) << (8 * i);
+        }
+        pos_ += 8;
+        value = static_cast<std::int64_t>(raw);
+        return true;
+    }
+
+    bool read_varint(std::uint64_t &value) {
+        std::uint64_t result = 0;
+        for (std::size_t i = 0; i < kMaxVarintBytes; ++i) {
+            if (pos_ >= data_.size()) {
+                return false;
+            }
+            const auto byte = static_cast<std::uint8_t>(data_[pos_++]);
+            result |= static_cast<std::uint64_t>(byte & 0x7Fu) << (7 * i);
+            if ((byte & 0x80u) == 0) {
+                value = result;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool read_string(std::string_view &value) {
+        std::uint64_t length = 0;
+        if (!read_varint(length) || length > data_.size() - pos_) {
+            return false;
+        }
+        value = data_.substr(pos_, static_cast<std::size_t>(length));
+        pos_ += static_cast<std::size_t>(length);
+        return true;
+    }
+
+    [[nodiscard]] std::size_t position() const { return pos_; }
+    [[nodiscard]] bool at_end() const { return pos_ == data_.size(); }
+
+  private:
+    std::string_view data_;
+    std::size_t pos_ = 0;
+};
+
+}  // namespace
+
+EventRecordView::AttributeIterator::AttributeIterator(std::string_view table, std::size_t remaining)
+    : table_(table), remaining_(remaining) {
+    load();
+}
+
+EventRecordView::AttributeIterator &EventRecordView::AttributeIterator::operator++() {
+    --remaining_;
+    load();
+    return *this;
+}
+
+void EventRecordView::AttributeIterator::load() {
+    if (remaining_ == 0) {
+        return;
+    }
+    // The table was validated by DecodeEventBinary, so these reads succeed.
+    ByteReader reader(table_);
+    reader.read_string(current_.key);
+    reader.read_string(current_.value);
+    table_.remove_prefix(reader.position());
+}
+
+void EncodeEventBinary(const EventRecord &record, std::string &out) {
+    out.push_back(static_cast<char>(kEventCodecMagic));
+    out.push_back(static_cast<char>(kEventCodecVersion));
+    const auto micros = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(record.timestamp.time_since_epoch()).count());
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<char>((micros >> (8 * i)) & 0xFFu));
+    }
+    put_varint(out, record.sequence);
+    put_string(out, record.source);
+    put_string(out, record.category);
+    put_string(out, SeverityName(record.severity));
+    put_string(out, record.message);
+    put_varint(out, record.attributes.size());
+    for (const auto &attr : record.attributes) {
+        put_string(out, attr.key);
+        if (attr.value.is_number()) {
+            thread_local std::string number;
+            number.clear();
+            attr.value.AppendTo(number);
+            put_string(out, number);
+        } else {
+            put_string(out, attr.value.text());
+        }
+    }
+}
+
+bool DecodeEventBinary(std::string_view data, EventRecordView &view) {
+    ByteReader reader(data);
+    std::uint8_t magic = 0;
+    std::uint8_t version = 0;
+    if (!reader.read_u8(magic) || magic != kEventCodecMagic) {
+        return false;
+    }
+    if (!reader.read_u8(version) || version != kEventCodecVersion) {
+        return false;
+    }
+    std::int64_t micros = 0;
+    if (!reader.read_i64(micros)) {
+        return false;
+    }
+    view.timestamp = std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::microseconds(micros)));
+    if (!reader.read_varint(view.sequence) || !reader.read_string(view.source) ||
+        !reader.read_string(view.category) || !reader.read_string(view.severity) ||
+        !reader.read_string(view.message)) {
+        return false;
+    }
+    std::uint64_t count = 0;
+    if (!reader.read_varint(count)) {
+        return false;
+    }
+    const std::size_t table_start = reader.position();
+    for (std::uint64_t i = 0; i < count; ++i) {
+        std::string_view key;
+        std::string_view value;
+        if (!reader.read_string(key) || !reader.read_string(value)) {
+            return false;
+        }
+    }
+    if (!reader.at_end()) {
+        return false;
+    }
+    view.attribute_table_ = data.substr(table_start);
+    view.attribute_count_ = static_cast<std::size_t>(count);
+    return true;
+}
+
+bool DecodeEventBinary(std::string_view data, EventRecord &record) {
+    EventRecordView view;
+    if (!DecodeEventBinary(data, view)) {
+        return false;
+    }
+    MaterializeEvent(view, record);
+    return true;
+}
+
+void MaterializeEvent(const EventRecordView &view, EventRecord &record) {
+    record.source = Symbol::FromUntrusted(view.source);
+    record.category = Symbol::FromUntrusted(view.category);
+    record.severity = ParseSeverity(view.severity);
+    record.message.assign(view.message.data(), view.message.size());
+    record.timestamp = view.timestamp;
+    record.sequence = view.sequence;
+    record.attributes.clear();
+    record.attributes.reserve(view.attribute_count());
+    for (const auto &attr : view) {
+        record.attributes.push_back({Symbol::FromUntrusted(attr.key), attr.value});
+    }
+}
+
+}  // namespace wslmon
@@ -0,0 +1,47 @@
+#include "event_view.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace wslmon {
+
+EventArena::EventArena(std::size_t chunk_size) : chunk_size_(std::max<std::size_t>(chunk_size, 64)) {}
+
+std::string_view EventArena::Store(std::string_view text) {
+    if (text.empty()) {
+        return {};
+    }
+    auto *copy = static_cast<char *>(allocate(text.size(), 1));
+    std::memcpy(copy, text.data(), text.size());
+    return {copy, text.size()};
+}
+
+void *EventArena::allocate(std::size_t size, std::size_t alignment) {
+    auto address = reinterpret_cast<std::uintptr_t>(cursor_);
+    std::size_t padding = (alignment - address % alignment) % alignment;
+    if (cursor_ == nullptr || padding + size > remaining_) {
+        // Oversized requests get a dedicated chunk so a single long line
+        // does not waste the tail of the current one.
+        const std::size_t capacity = std::max(chunk_size_, size + alignment);
+        chunks_.push_back(std::make_unique<unsigned char[]>(capacity));
+        unsigned char *chunk = chunks_.back().get();
+        if (capacity > chunk_size_) {
+            address = reinterpret_cast<std::uintptr_t>(chunk);
+            padding = (alignment - address % alignment) % alignment;
+            bytes_used_ += size;
+            return chunk + padding;
+        }
+        cursor_ = chunk;
+        remaining_ = capacity;
+        address = reinterpret_cast<std::uintptr_t>(cursor_);
+        padding = (alignment - address % alignment) % alignment;
+    }
+    unsigned char *result = cursor_ + padding;
+    cursor_ = result + size;
+    remaining_ -= padding + size;
+    bytes_used_ += size;
+    return result;
+}
+
+}  // namespace wslmon
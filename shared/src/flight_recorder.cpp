@@ -0,0 +1,123 @@
+#include "flight_recorder.hpp"
+
+#include <string>
+
+namespace wslmon {
+
+namespace {
+// Heap bytes behind a string of |capacity|: none while it fits the small
+// buffer, else the buffer plus its terminator.
+std::size_t string_heap_bytes(std::size_t capacity) {
+    static const std::size_t inline_capacity = std::string().capacity();
+    return capacity > inline_capacity ? capacity + 1 : 0;
+}
+}  // namespace
+
+std::size_t EventFootprint(const EventRecord &record) {
+    std::size_t bytes = sizeof(EventRecord) + string_heap_bytes(record.message.capacity());
+    if (!record.attributes.is_inline()) {
+        bytes += record.attributes.capacity() * sizeof(EventAttribute);
+    }
+    for (const auto &attribute : record.attributes) {
+        // AttributeValue exposes only the text, so its length stands in for
+        // the capacity.
+        bytes += string_heap_bytes(attribute.value.text().size());
+    }
+    return bytes;
+}
+
+FlightRecorder::FlightRecorder(FlightRecorderLimits limits) : limits_(limits) {
+    std::size_t shares = 0;
+    for (const auto share : limits_.budget_shares) {
+        shares += share;
+    }
+    for (std::size_t i = 0; i < kEventPriorityCount && shares > 0; ++i) {
+        partitions_[i].budget = limits_.max_bytes / shares * limits_.budget_shares[i];
+    }
+}
+
+void FlightRecorder::Push(EventRecord record, Clock::time_point arrived) {
+    const std::size_t bytes = EventFootprint(record);
+    Partition &partition = partitions_[static_cast<std::size_t>(PriorityOf(record.severity))];
+    std::lock_guard<std::mutex> lock(mutex_);
+    partition.entries.push_back({arrived, next_arrival_++, bytes, std::move(record)});
+    partition.bytes += bytes;
+    evict_locked(partition, arrived);
+}
+
+void FlightRecorder::evict_locked(Partition &pushed, Clock::time_point now) {
+    // Only the pushed partition can have gone over budget. Its newest
+    // record stays even if it alone exceeds the budget.
+    while (pushed.entries.size() > 1 && pushed.bytes > pushed.budget) {
+        pushed.bytes -= pushed.entries.front().bytes;
+        pushed.entries.pop_front();
+    }
+    for (auto &partition : partitions_) {
+        while (!partition.entries.empty() && now - partition.entries.front().arrived > limits_.horizon) {
+            partition.bytes -= partition.entries.front().bytes;
+            partition.entries.pop_front();
+        }
+    }
+}
+
+std::vector<EventRecord> FlightRecorder::Snapshot(Clock::time_point now) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::array<std::deque<Entry>::const_iterator, kEventPriorityCount> next;
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < kEventPriorityCount; ++i) {
+        const auto &entries = partitions_[i].entries;
+        next[i] = entries.begin();
+        while (next[i] != entries.end() && now - next[i]->arrived > limits_.horizon) {
+            ++next[i];
+        }
+        total += static_cast<std::size_t>(entries.end() - next[i]);
+    }
+    // Merge the partitions by arrival; each is already in arrival order.
+    std::vector<EventRecord> out;
+    out.reserve(total);
+    for (;;) {
+        std::size_t oldest = kEventPriorityCount;
+        for (std::size_t i = 0; i < kEventPriorityCount; ++i) {
+            if (next[i] != partitions_[i].entries.end() &&
+                (oldest == kEventPriorityCount || next[i]->arrival_index < next[oldest]->arrival_index)) {
+                oldest = i;
+            }
+        }
+        if (oldest == kEventPriorityCount) {
+            break;
+        }
+        out.push_back(next[oldest]->record);
+        ++next[oldest];
+    }
+    return out;
+}
+
+std::size_t FlightRecorder::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t entries = 0;
+    for (const auto &partition : partitions_) {
+        entries += partition.entries.size();
+    }
+    return entries;
+}
+
+std::size_t FlightRecorder::bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t bytes = 0;
+    for (const auto &partition : partitions_) {
+        bytes += partition.bytes;
+    }
+    return bytes;
+}
+
+std::array<FlightRecorder::PartitionUsage, kEventPriorityCount> FlightRecorder::usage() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::array<PartitionUsage, kEventPriorityCount> result{};
+    for (std::size_t i = 0; i < kEventPriorityCount; ++i) {
+        const auto &partition = partitions_[i];
+        result[i] = {static_cast<EventPriority>(i), partition.entries.size(), partition.bytes, partition.budget};
+    }
+    return result;
+}
+
+}  // namespace wslmon
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <map>
 #include <numeric>
 #include <optional>
@@ -10,15 +11,66 @@
 
 namespace wslmon {
 namespace {
-std::optional<std::string> find_attribute(const EventRecord &record, std::string_view key) {
+const Symbol kHostOrigin("host");
+const Symbol kGuestOrigin("guest");
+const Symbol kServiceHealthCategory("ServiceHealth");
+const Symbol kSecurityCategory("Security");
+const Symbol kProcessCategory("Process");
+const Symbol kResourceCategory("Resource");
+const Symbol kKernelCategory("Kernel");
+const Symbol kKmsgCategory("Kmsg");
+const Symbol kStateKey("state");
+const Symbol kRestartCountKey("restartCount");
+const Symbol kStateTextKey("stateText");
+const Symbol kNameKey("name");
+const Symbol kSuiteKey("suite");
+
+std::optional<std::string> find_attribute(const EventRecord &record, Symbol key) {
+    for (const auto &attr : record.attributes) {
+        if (attr.key == key) {
+            return attr.value.str();
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<std::uint64_t> find_count(const EventRecord &record, Symbol key) {
     for (const auto &attr : record.attributes) {
         if (attr.key == key) {
-            return attr.value;
+            return attr.value.as_uint64();
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<std::string> find_attribute(const EventView &view, Symbol key) {
+    for (const auto &attr : view) {
+        if (attr.key == key) {
+            return attr.value.str();
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<std::uint64_t> find_count(const EventView &view, Symbol key) {
+    for (const auto &attr : view) {
+        if (attr.key == key) {
+            const AttributeValue value =
+                attr.value.has_escapes() ? AttributeValue(attr.value.str()) : AttributeValue(attr.value.raw());
+            return value.as_uint64();
         }
     }
     return std::nullopt;
 }
 
+const EventRecord &event_of(const TimelineEvent &timeline_event) {
+    return timeline_event.record;
+}
+
+const EventView &event_of(const TimelineEventView &timeline_event) {
+    return timeline_event.event;
+}
+
 bool contains_case_insensitive(std::string_view haystack, std::string_view needle) {
     if (needle.empty()) {
         return true;
@@ -29,15 +81,29 @@ bool contains_case_insensitive(std::string_view haystack, std::string_view needl
     return it != haystack.end();
 }
 
-bool is_recent(const EventRecord &reference, const EventRecord &candidate,
+bool message_contains(const EventRecord &record, std::string_view needle) {
+    return contains_case_insensitive(record.message, needle);
+}
+
+bool message_contains(const EventView &view, std::string_view needle) {
+    if (!view.message.has_escapes()) {
+        return contains_case_insensitive(view.message.raw(), needle);
+    }
+    thread_local std::string scratch;
+    scratch.clear();
+    view.message.AppendTo(scratch);
+    return contains_case_insensitive(scratch, needle);
+}
+
+bool is_recent(std::chrono::system_clock::time_point reference, std::chrono::system_clock::time_point candidate,
                std::chrono::minutes window = std::chrono::minutes(10)) {
-    if (candidate.timestamp == std::chrono::system_clock::time_point{}) {
+    if (candidate == std::chrono::system_clock::time_point{}) {
         return false;
     }
-    if (reference.timestamp == std::chrono::system_clock::time_point{}) {
+    if (reference == std::chrono::system_clock::time_point{}) {
         return true;
     }
-    auto delta = reference.timestamp - candidate.timestamp;
+    auto delta = reference - candidate;
     return delta >= std::chrono::minutes(0) && delta <= window;
 }
 
@@ -45,6 +111,12 @@ void add_supporting_event(std::vector<HeuristicSupportingEvent> &events, const T
     events.push_back({timeline_event.origin, timeline_event.record});
 }
 
+void add_supporting_event(std::vector<HeuristicSupportingEvent> &events, const TimelineEventView &timeline_event) {
+    HeuristicSupportingEvent supporting{timeline_event.origin, {}};
+    MaterializeEvent(timeline_event.event, supporting.record);
+    events.push_back(std::move(supporting));
+}
+
 std::string compute_confidence(std::size_t weight) {
     if (weight >= 5) {
         return "High";
@@ -55,47 +127,126 @@ std::string compute_confidence(std::size_t weight) {
     return "Low";
 }
 
-}  // namespace
+// The passes below address events by index through a source adapter, so
+// the row-oriented timelines and the columnar EventBatch share one
+// implementation while the batch adapter reads straight from its columns.
+template <typename Timeline>
+class TimelineSource {
+  public:
+    explicit TimelineSource(const std::vector<Timeline> &events) : events_(events) {}
 
-std::vector<HeuristicInsight> AnalyzeEventTimeline(const std::vector<TimelineEvent> &events) {
+    std::size_t size() const { return events_.size(); }
+    Symbol origin(std::size_t i) const { return events_[i].origin; }
+    Symbol category(std::size_t i) const { return event_of(events_[i]).category; }
+    Severity severity(std::size_t i) const { return event_of(events_[i]).severity; }
+    std::chrono::system_clock::time_point timestamp(std::size_t i) const { return event_of(events_[i]).timestamp; }
+    bool message_contains(std::size_t i, std::string_view needle) const {
+        return wslmon::message_contains(event_of(events_[i]), needle);
+    }
+    std::optional<std::string> attribute(std::size_t i, Symbol key) const {
+        return find_attribute(event_of(events_[i]), key);
+    }
+    std::optional<std::uint64_t> count(std::size_t i, Symbol key) const {
+        return find_count(event_of(events_[i]), key);
+    }
+    void add_supporting(std::vector<HeuristicSupportingEvent> &out, std::size_t i) const {
+        add_supporting_event(out, events_[i]);
+    }
+
+  private:
+    const std::vector<Timeline> &events_;
+};
+
+class BatchSource {
+  public:
+    explicit BatchSource(const EventBatch &batch)
+        : batch_(batch),
+          origins_(batch.origins().data()),
+          categories_(batch.categories().data()),
+          severities_(batch.severities().data()),
+          timestamps_(batch.timestamps().data()) {}
+
+    std::size_t size() const { return batch_.size(); }
+    Symbol origin(std::size_t i) const { return origins_[i]; }
+    Symbol category(std::size_t i) const { return categories_[i]; }
+    Severity severity(std::size_t i) const { return severities_[i]; }
+    std::chrono::system_clock::time_point timestamp(std::size_t i) const { return timestamps_[i]; }
+    bool message_contains(std::size_t i, std::string_view needle) const {
+        return contains_case_insensitive(batch_.message(i), needle);
+    }
+    std::optional<std::string> attribute(std::size_t i, Symbol key) const {
+        const std::size_t attr = find(i, key);
+        if (attr == kMissing) {
+            return std::nullopt;
+        }
+        return std::string(batch_.attribute_value(attr));
+    }
+    std::optional<std::uint64_t> count(std::size_t i, Symbol key) const {
+        const std::size_t attr = find(i, key);
+        if (attr == kMissing) {
+            return std::nullopt;
+        }
+        return AttributeValue(batch_.attribute_value(attr)).as_uint64();
+    }
+    void add_supporting(std::vector<HeuristicSupportingEvent> &out, std::size_t i) const {
+        HeuristicSupportingEvent supporting{origins_[i], {}};
+        batch_.Materialize(i, supporting.record);
+        out.push_back(std::move(supporting));
+    }
+
+  private:
+    static constexpr std::size_t kMissing = static_cast<std::size_t>(-1);
+
+    std::size_t find(std::size_t i, Symbol key) const {
+        for (std::size_t attr = batch_.attribute_begin(i); attr < batch_.attribute_end(i); ++attr) {
+            if (batch_.attribute_key(attr) == key) {
+                return attr;
+            }
+        }
+        return kMissing;
+    }
+
+    const EventBatch &batch_;
+    const Symbol *origins_;
+    const Symbol *categories_;
+    const Severity *severities_;
+    const std::chrono::system_clock::time_point *timestamps_;
+};
+
+template <typename Source>
+std::vector<HeuristicInsight> analyze_timeline(const Source &events) {
     std::vector<HeuristicInsight> insights;
-    if (events.empty()) {
+    const std::size_t count = events.size();
+    if (count == 0) {
         return insights;
     }
 
-    const EventRecord &last_event = events.back().record;
+    const auto last_timestamp = events.timestamp(count - 1);
 
     // Track aggregated signals for heuristics.
-    std::map<std::string, std::size_t> restart_bursts;
+    std::map<std::string_view, std::size_t> restart_bursts;
     std::size_t security_disabled = 0;
-    std::vector<const TimelineEvent *> security_events;
-    std::vector<const TimelineEvent *> memory_pressure_events;
-    std::vector<const TimelineEvent *> kernel_fault_events;
-
-    for (const auto &event : events) {
-        const auto &record = event.record;
-        const auto lower_category = record.category;
-        if (lower_category == "ServiceHealth") {
-            auto state = find_attribute(record, "state");
-            auto restarts = find_attribute(record, "restartCount");
+    std::vector<std::size_t> security_events;
+    std::vector<std::size_t> memory_pressure_events;
+    std::vector<std::size_t> kernel_fault_events;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const Symbol category = events.category(i);
+        if (category == kServiceHealthCategory) {
+            auto state = events.attribute(i, kStateKey);
+            auto restarts = events.count(i, kRestartCountKey);
             if (state && contains_case_insensitive(*state, "restart")) {
-                restart_bursts[event.origin] += 2;
+                restart_bursts[events.origin(i).view()] += 2;
             }
-            if (restarts) {
-                try {
-                    std::size_t count = static_cast<std::size_t>(std::stoull(*restarts));
-                    if (count >= 3) {
-                        restart_bursts[event.origin] += count;
-                    }
-                } catch (const std::exception &) {
-                }
+            if (restarts && *restarts >= 3) {
+                restart_bursts[events.origin(i).view()] += static_cast<std::size_t>(*restarts);
             }
         }
 
-        if (record.category == "Security") {
-            auto state_text = find_attribute(record, "stateText");
-            auto vendor = find_attribute(record, "name");
-            auto suite = find_attribute(record, "suite");
+        if (category == kSecurityCategory) {
+            auto state_text = events.attribute(i, kStateTextKey);
+            auto vendor = events.attribute(i, kNameKey);
+            auto suite = events.attribute(i, kSuiteKey);
             const bool disabled = state_text && contains_case_insensitive(*state_text, "Disabled");
             if (disabled) {
                 security_disabled += 2;
@@ -106,22 +257,19 @@ std::vector<HeuristicInsight> AnalyzeEventTimeline(const std::vector<TimelineEve
                 security_disabled += 1;
             }
             if (disabled || (suite && contains_case_insensitive(*suite, "ThirdParty"))) {
-                security_events.push_back(&event);
+                security_events.push_back(i);
             }
         }
 
-        if (record.category == "Process" || record.category == "Resource") {
-            auto message_lower = record.message;
-            if (contains_case_insensitive(message_lower, "memory pressure") ||
-                contains_case_insensitive(message_lower, "pressure stall")) {
-                memory_pressure_events.push_back(&event);
+        if (category == kProcessCategory || category == kResourceCategory) {
+            if (events.message_contains(i, "memory pressure") || events.message_contains(i, "pressure stall")) {
+                memory_pressure_events.push_back(i);
             }
         }
 
-        if (record.category == "Kernel" || record.category == "Kmsg" ||
-            contains_case_insensitive(record.message, "panic") ||
-            contains_case_insensitive(record.message, "bugcheck")) {
-            kernel_fault_events.push_back(&event);
+        if (category == kKernelCategory || category == kKmsgCategory || events.message_contains(i, "panic") ||
+            events.message_contains(i, "bugcheck")) {
+            kernel_fault_events.push_back(i);
         }
     }
 
@@ -130,14 +278,15 @@ std::vector<HeuristicInsight> AnalyzeEventTimeline(const std::vector<TimelineEve
             continue;
         }
         HeuristicInsight insight;
-        insight.id = origin + "_service_restart_burst";
-        insight.summary = "Rapid restart burst detected on " + origin + " service stack";
+        insight.id = std::string(origin) + "_service_restart_burst";
+        insight.summary = "Rapid restart burst detected on " + std::string(origin) + " service stack";
         insight.rationale = "Multiple ServiceHealth events indicated restart storms shortly before collection halted.";
         insight.confidence = compute_confidence(weight);
-        for (const auto &event : events) {
-            if (event.origin == origin && event.record.category == "ServiceHealth" &&
-                is_recent(last_event, event.record)) {
-                add_supporting_event(insight.supporting_events, event);
+        const Symbol origin_symbol(origin);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (events.origin(i) == origin_symbol && events.category(i) == kServiceHealthCategory &&
+                is_recent(last_timestamp, events.timestamp(i))) {
+                events.add_supporting(insight.supporting_events, i);
             }
         }
         if (!insight.supporting_events.empty()) {
@@ -152,9 +301,9 @@ std::vector<HeuristicInsight> AnalyzeEventTimeline(const std::vector<TimelineEve
         insight.rationale =
             "SecurityCenter telemetry reported disabled or outdated states for non-Microsoft products around the shutdown.";
         insight.confidence = compute_confidence(security_disabled + security_events.size());
-        for (const auto *event : security_events) {
-            if (is_recent(last_event, event->record, std::chrono::minutes(30))) {
-                add_supporting_event(insight.supporting_events, *event);
+        for (std::size_t i : security_events) {
+            if (is_recent(last_timestamp, events.timestamp(i), std::chrono::minutes(30))) {
+                events.add_supporting(insight.supporting_events, i);
             }
         }
         if (!insight.supporting_events.empty()) {
@@ -169,9 +318,9 @@ std::vector<HeuristicInsight> AnalyzeEventTimeline(const std::vector<TimelineEve
         insight.rationale =
             "Process and resource collectors recorded elevated working sets or pressure stall metrics leading up to the outage.";
         insight.confidence = compute_confidence(memory_pressure_events.size());
-        for (const auto *event : memory_pressure_events) {
-            if (is_recent(last_event, event->record)) {
-                add_supporting_event(insight.supporting_events, *event);
+        for (std::size_t i : memory_pressure_events) {
+            if (is_recent(last_timestamp, events.timestamp(i))) {
+                events.add_supporting(insight.supporting_events, i);
             }
         }
         if (!insight.supporting_events.empty()) {
@@ -186,9 +335,9 @@ std::vector<HeuristicInsight> AnalyzeEventTimeline(const std::vector<TimelineEve
         insight.rationale =
             "Guest kernel messages or Windows bugcheck indicators were emitted close to the shutdown timeline.";
         insight.confidence = compute_confidence(kernel_fault_events.size());
-        for (const auto *event : kernel_fault_events) {
-            if (is_recent(last_event, event->record, std::chrono::minutes(30))) {
-                add_supporting_event(insight.supporting_events, *event);
+        for (std::size_t i : kernel_fault_events) {
+            if (is_recent(last_timestamp, events.timestamp(i), std::chrono::minutes(30))) {
+                events.add_supporting(insight.supporting_events, i);
             }
         }
         if (!insight.supporting_events.empty()) {
@@ -202,38 +351,77 @@ std::vector<HeuristicInsight> AnalyzeEventTimeline(const std::vector<TimelineEve
     return insights;
 }
 
-CrossChannelHealthSnapshot ComputeCrossChannelSnapshot(const std::vector<TimelineEvent> &events) {
-    CrossChannelHealthSnapshot snapshot;
-    auto accumulate = [](ChannelHealthMetrics &metrics, const EventRecord &record) {
-        if (metrics.total == 0) {
-            metrics.first_timestamp = record.timestamp;
-            metrics.last_timestamp = record.timestamp;
-        } else {
-            metrics.first_timestamp = std::min(metrics.first_timestamp, record.timestamp);
-            metrics.last_timestamp = std::max(metrics.last_timestamp, record.timestamp);
-        }
-        metrics.total += 1;
-        const auto &severity = record.severity;
-        if (severity == "Critical") {
-            metrics.critical += 1;
-        } else if (severity == "Error") {
-            metrics.error += 1;
-        } else if (severity == "Warning") {
-            metrics.warning += 1;
+// Counts per channel and severity in flat arrays, then folds them into the
+// metrics structs; the loop body is a handful of column loads and adds.
+template <typename Source>
+CrossChannelHealthSnapshot compute_snapshot(const Source &events) {
+    constexpr std::size_t kSeverities = static_cast<std::size_t>(Severity::Critical) + 1;
+    std::size_t counts[2][kSeverities] = {};
+    std::chrono::system_clock::time_point first[2] = {std::chrono::system_clock::time_point::max(),
+                                                      std::chrono::system_clock::time_point::max()};
+    std::chrono::system_clock::time_point last[2] = {std::chrono::system_clock::time_point::min(),
+                                                     std::chrono::system_clock::time_point::min()};
+
+    const std::size_t count = events.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        const Symbol origin = events.origin(i);
+        std::size_t channel = 0;
+        if (origin == kHostOrigin) {
+            channel = 0;
+        } else if (origin == kGuestOrigin) {
+            channel = 1;
         } else {
-            metrics.info += 1;
+            continue;
         }
-    };
+        const auto timestamp = events.timestamp(i);
+        counts[channel][static_cast<std::size_t>(events.severity(i))] += 1;
+        first[channel] = std::min(first[channel], timestamp);
+        last[channel] = std::max(last[channel], timestamp);
+    }
 
-    for (const auto &event : events) {
-        if (event.origin == "host") {
-            accumulate(snapshot.host, event.record);
-        } else if (event.origin == "guest") {
-            accumulate(snapshot.guest, event.record);
+    CrossChannelHealthSnapshot snapshot;
+    ChannelHealthMetrics *metrics[2] = {&snapshot.host, &snapshot.guest};
+    for (std::size_t channel = 0; channel < 2; ++channel) {
+        auto &out = *metrics[channel];
+        const auto &bucket = counts[channel];
+        out.critical = bucket[static_cast<std::size_t>(Severity::Critical)];
+        out.error = bucket[static_cast<std::size_t>(Severity::Error)];
+        out.warning = bucket[static_cast<std::size_t>(Severity::Warning)];
+        out.info = bucket[static_cast<std::size_t>(Severity::Unspecified)] +
+                   bucket[static_cast<std::size_t>(Severity::Verbose)] + bucket[static_cast<std::size_t>(Severity::Info)];
+        out.total = out.critical + out.error + out.warning + out.info;
+        if (out.total > 0) {
+            out.first_timestamp = first[channel];
+            out.last_timestamp = last[channel];
         }
     }
     return snapshot;
 }
 
-}  // namespace wslmon
+}  // namespace
+
+std::vector<HeuristicInsight> AnalyzeEventTimeline(const std::vector<TimelineEvent> &events) {
+    return analyze_timeline(TimelineSource<TimelineEvent>(events));
+}
 
+std::vector<HeuristicInsight> AnalyzeEventTimeline(const std::vector<TimelineEventView> &events) {
+    return analyze_timeline(TimelineSource<TimelineEventView>(events));
+}
+
+std::vector<HeuristicInsight> AnalyzeEventTimeline(const EventBatch &events) {
+    return analyze_timeline(BatchSource(events));
+}
+
+CrossChannelHealthSnapshot ComputeCrossChannelSnapshot(const std::vector<TimelineEvent> &events) {
+    return compute_snapshot(TimelineSource<TimelineEvent>(events));
+}
+
+CrossChannelHealthSnapshot ComputeCrossChannelSnapshot(const std::vector<TimelineEventView> &events) {
+    return compute_snapshot(TimelineSource<TimelineEventView>(events));
+}
+
+CrossChannelHealthSnapshot ComputeCrossChannelSnapshot(const EventBatch &events) {
+    return compute_snapshot(BatchSource(events));
+}
+
+}  // namespace wslmon
@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "crypto.hpp"
+#include "event_codec.hpp"
 
 namespace wslmon {
 namespace {
@@ -15,20 +16,22 @@ constexpr std::array<char, 4> kServerHelloMagic{'W', 'S', 'L', 'H'};
 constexpr std::array<char, 4> kClientHelloMagic{'W', 'S', 'L', 'C'};
 constexpr std::array<char, 4> kServerAckMagic{'W', 'S', 'L', 'A'};
 constexpr std::array<char, 4> kFrameMagic{'W', 'S', 'L', 'E'};
-constexpr std::uint8_t kProtocolVersion = 1;
+// Version 2 added binary event frames and brought the frame's version and
+// type bytes under its MAC. A version 1 peer understands neither, so it has
+// to fail the handshake rather than lose every frame after it.
+constexpr std::uint8_t kProtocolVersion = 2;
 
-std::vector<std::uint8_t> HmacLabel(const std::vector<std::uint8_t> &secret,
-                                    std::string_view label,
-                                    const std::uint8_t *first,
-                                    std::size_t first_len,
-                                    const std::uint8_t *second,
-                                    std::size_t second_len) {
-    std::vector<std::uint8_t> input;
-    input.reserve(label.size() + first_len + second_len);
-    input.insert(input.end(), label.begin(), label.end());
-    input.insert(input.end(), first, first + first_len);
-    input.insert(input.end(), second, second + second_len);
-    return HmacSha256(secret, input.data(), input.size());
+std::array<std::uint8_t, 32> HmacLabel(const HmacKey &secret,
+                                       std::string_view label,
+                                       const std::uint8_t *first,
+                                       std::size_t first_len,
+                                       const std::uint8_t *second,
+                                       std::size_t second_len) {
+    HmacSha256Context context(secret);
+    context.Update(label);
+    context.Update(first, first_len);
+    context.Update(second, second_len);
+    return context.Final();
 }
 
 bool ReadExact(const IpcReadFn &read_fn, std::uint8_t *buffer, std::size_t length) {
@@ -53,7 +56,21 @@ bool WriteExact(const IpcWriteFn &write_fn, const std::uint8_t *buffer, std::siz
     return true;
 }
 
-bool DeserializeEventPayload(std::string_view payload, EventRecord &out_record) {
+// The MAC covers the version and frame type (header bytes 4 and 5) as well
+// as the payload, so a relay cannot re-type a frame.
+std::array<std::uint8_t, 32> FrameMac(const HmacKey &session_key,
+                                      const std::uint8_t *header,
+                                      std::string_view payload) {
+    HmacSha256Context context(session_key);
+    context.Update(header + 4, 2);
+    context.Update(payload);
+    return context.Final();
+}
+
+bool DeserializeEventPayload(std::uint8_t frame_type, std::string_view payload, EventRecord &out_record) {
+    if (frame_type == static_cast<std::uint8_t>(IpcPayloadEncoding::Binary)) {
+        return DecodeEventBinary(payload, out_record);
+    }
     return DeserializeEvent(payload, out_record);
 }
 
@@ -71,7 +88,8 @@ std::array<std::uint8_t, 32> GenerateNonce() {
 bool IpcServerHandshake(const IpcWriteFn &write_fn,
                         const IpcReadFn &read_fn,
                         const std::vector<std::uint8_t> &shared_secret,
-                        std::vector<std::uint8_t> &session_key) {
+                        HmacKey &session_key) {
+    const HmacKey secret_key(shared_secret);
     auto server_nonce = GenerateNonce();
     std::array<std::uint8_t, 4 + 1 + 3 + 32> server_hello{};
     std::copy(kServerHelloMagic.begin(), kServerHelloMagic.end(), server_hello.begin());
@@ -97,14 +115,14 @@ bool IpcServerHandshake(const IpcWriteFn &write_fn,
     std::array<std::uint8_t, 32> client_proof{};
     std::copy(client_response.begin() + 40, client_response.end(), client_proof.begin());
 
-    const auto expected_client_proof = HmacLabel(shared_secret, "client-proof",
+    const auto expected_client_proof = HmacLabel(secret_key, "client-proof",
                                                  server_nonce.data(), server_nonce.size(),
                                                  client_nonce.data(), client_nonce.size());
     if (!std::equal(expected_client_proof.begin(), expected_client_proof.end(), client_proof.begin())) {
         return false;
     }
 
-    const auto server_proof = HmacLabel(shared_secret, "server-proof",
+    const auto server_proof = HmacLabel(secret_key, "server-proof",
                                         client_nonce.data(), client_nonce.size(),
                                         server_nonce.data(), server_nonce.size());
 
@@ -117,17 +135,17 @@ bool IpcServerHandshake(const IpcWriteFn &write_fn,
         return false;
     }
 
-    const auto session = HmacLabel(shared_secret, "session",
+    const auto session = HmacLabel(secret_key, "session",
                                    server_nonce.data(), server_nonce.size(),
                                    client_nonce.data(), client_nonce.size());
-    session_key.assign(session.begin(), session.end());
+    session_key = HmacKey(session.data(), session.size());
     return true;
 }
 
 bool IpcClientHandshake(const IpcWriteFn &write_fn,
                         const IpcReadFn &read_fn,
                         const std::vector<std::uint8_t> &shared_secret,
-                        std::vector<std::uint8_t> &session_key) {
+                        HmacKey &session_key) {
     std::array<std::uint8_t, 4 + 1 + 3 + 32> server_hello{};
     if (!ReadExact(read_fn, server_hello.data(), server_hello.size())) {
         return false;
@@ -141,8 +159,9 @@ bool IpcClientHandshake(const IpcWriteFn &write_fn,
     std::array<std::uint8_t, 32> server_nonce{};
     std::copy(server_hello.begin() + 8, server_hello.end(), server_nonce.begin());
 
+    const HmacKey secret_key(shared_secret);
     auto client_nonce = GenerateNonce();
-    const auto client_proof = HmacLabel(shared_secret, "client-proof",
+    const auto client_proof = HmacLabel(secret_key, "client-proof",
                                         server_nonce.data(), server_nonce.size(),
                                         client_nonce.data(), client_nonce.size());
 
@@ -169,40 +188,46 @@ bool IpcClientHandshake(const IpcWriteFn &write_fn,
 
     std::array<std::uint8_t, 32> server_proof{};
     std::copy(server_ack.begin() + 8, server_ack.end(), server_proof.begin());
-    const auto expected_server_proof = HmacLabel(shared_secret, "server-proof",
+    const auto expected_server_proof = HmacLabel(secret_key, "server-proof",
                                                  client_nonce.data(), client_nonce.size(),
                                                  server_nonce.data(), server_nonce.size());
     if (!std::equal(expected_server_proof.begin(), expected_server_proof.end(), server_proof.begin())) {
         return false;
     }
 
-    const auto session = HmacLabel(shared_secret, "session",
+    const auto session = HmacLabel(secret_key, "session",
                                    server_nonce.data(), server_nonce.size(),
                                    client_nonce.data(), client_nonce.size());
-    session_key.assign(session.begin(), session.end());
+    session_key = HmacKey(session.data(), session.size());
     return true;
 }
 
 bool IpcSendEvent(const IpcWriteFn &write_fn,
-                  const std::vector<std::uint8_t> &session_key,
-                  const EventRecord &record) {
+                  const HmacKey &session_key,
+                  const EventRecord &record,
+                  IpcPayloadEncoding encoding) {
     if (session_key.empty()) {
         return false;
     }
-    const std::string payload = SerializeEvent(record);
-    const auto mac = HmacSha256(session_key, reinterpret_cast<const std::uint8_t *>(payload.data()), payload.size());
-
+    thread_local std::string payload;
+    payload.clear();
+    if (encoding == IpcPayloadEncoding::Binary) {
+        EncodeEventBinary(record, payload);
+    } else {
+        SerializeEvent(record, payload);
+    }
     std::uint32_t payload_len = static_cast<std::uint32_t>(payload.size());
     std::array<std::uint8_t, 4 + 1 + 1 + 2 + 4> header{};
     std::copy(kFrameMagic.begin(), kFrameMagic.end(), header.begin());
     header[4] = kProtocolVersion;
-    header[5] = 1;  // event frame
+    header[5] = static_cast<std::uint8_t>(encoding);  // event frame type
     header[6] = 0;
     header[7] = 0;
     header[8] = static_cast<std::uint8_t>(payload_len & 0xFFu);
     header[9] = static_cast<std::uint8_t>((payload_len >> 8) & 0xFFu);
     header[10] = static_cast<std::uint8_t>((payload_len >> 16) & 0xFFu);
     header[11] = static_cast<std::uint8_t>((payload_len >> 24) & 0xFFu);
+    const auto mac = FrameMac(session_key, header.data(), payload);
 
     if (!WriteExact(write_fn, header.data(), header.size())) {
         return false;
@@ -214,7 +239,7 @@ bool IpcSendEvent(const IpcWriteFn &write_fn,
 }
 
 bool IpcReceiveEvent(const IpcReadFn &read_fn,
-                     const std::vector<std::uint8_t> &session_key,
+                     const HmacKey &session_key,
                      EventRecord &out_record) {
     if (session_key.empty()) {
         return false;
@@ -226,7 +251,9 @@ bool IpcReceiveEvent(const IpcReadFn &read_fn,
     if (!std::equal(kFrameMagic.begin(), kFrameMagic.end(), header.begin())) {
         return false;
     }
-    if (header[4] != kProtocolVersion || header[5] != 1) {
+    if (header[4] != kProtocolVersion ||
+        (header[5] != static_cast<std::uint8_t>(IpcPayloadEncoding::Json) &&
+         header[5] != static_cast<std::uint8_t>(IpcPayloadEncoding::Binary))) {
         return false;
     }
     std::uint32_t payload_len = header[8] | (header[9] << 8) | (header[10] << 16) | (header[11] << 24);
@@ -243,14 +270,12 @@ bool IpcReceiveEvent(const IpcReadFn &read_fn,
         }
     }
 
-    const auto expected_mac = HmacSha256(session_key,
-                                         reinterpret_cast<const std::uint8_t *>(payload.data()),
-                                         payload.size());
+    const auto expected_mac = FrameMac(session_key, header.data(), payload);
     if (!std::equal(expected_mac.begin(), expected_mac.end(), mac.begin())) {
         return false;
     }
 
-    if (!DeserializeEventPayload(payload, out_record)) {
+    if (!DeserializeEventPayload(header[5], payload, out_record)) {
         return false;
     }
     return true;
@@ -0,0 +1,195 @@
+#include "json_escape.hpp"
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WSLMON_JSON_ESCAPE_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#include "cpu_features.hpp"
+
+namespace wslmon {
+namespace {
+inline bool needs_escape(char c) {
+    return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+}
+
+std::size_t find_escape_scalar(const char *data, std::size_t size, std::size_t from) {
+    for (std::size_t i = from; i < size; ++i) {
+        if (needs_escape(data[i])) {
+            return i;
+        }
+    }
+    return size;
+}
+
+#if defined(WSLMON_JSON_ESCAPE_X86)
+
+inline unsigned count_trailing_zeros(std::uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+// A byte needs escaping when it equals '"' or '\\', or when it is <= 0x1F as
+// an unsigned value, i.e. max_epu8(byte, 0x1F) == 0x1F.
+std::size_t find_escape_sse2(const char *data, std::size_t size, std::size_t from) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+    std::size_t i = from;
+    for (; i + 16 <= size; i += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        const __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+            _mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control));
+        const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(hits));
+        if (mask != 0) {
+            return i + count_trailing_zeros(mask);
+        }
+    }
+    return find_escape_scalar(data, size, i);
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+#define WSLMON_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define WSLMON_TARGET_AVX2
+#endif
+
+WSLMON_TARGET_AVX2 std::size_t find_escape_avx2(const char *data, std::size_t size, std::size_t from) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(0x1F);
+    std::size_t i = from;
+    for (; i + 32 <= size; i += 32) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        const __m256i hits = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)),
+            _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, control), control));
+        const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(hits));
+        if (mask != 0) {
+            return i + count_trailing_zeros(mask);
+        }
+    }
+    // The tail is shorter than one AVX2 block; finish it with SSE2.
+    return find_escape_sse2(data, size, i);
+}
+
+#endif  // WSLMON_JSON_ESCAPE_X86
+
+using FindEscapeFn = std::size_t (*)(const char *, std::size_t, std::size_t);
+
+JsonEscapeScanner detect_scanner() {
+#if defined(WSLMON_JSON_ESCAPE_X86)
+    return GetCpuFeatures().avx2 ? JsonEscapeScanner::Avx2 : JsonEscapeScanner::Sse2;
+#else
+    return JsonEscapeScanner::Scalar;
+#endif
+}
+
+JsonEscapeScanner resolve(JsonEscapeScanner scanner) {
+    static const JsonEscapeScanner detected = detect_scanner();
+    if (scanner == JsonEscapeScanner::Auto || !JsonEscapeScannerSupported(scanner)) {
+        return detected;
+    }
+    return scanner;
+}
+
+FindEscapeFn scanner_function(JsonEscapeScanner scanner) {
+    switch (resolve(scanner)) {
+#if defined(WSLMON_JSON_ESCAPE_X86)
+        case JsonEscapeScanner::Avx2:
+            return find_escape_avx2;
+        case JsonEscapeScanner::Sse2:
+            return find_escape_sse2;
+#endif
+        default:
+            return find_escape_scalar;
+    }
+}
+
+FindEscapeFn active_function() {
+    static const FindEscapeFn active = scanner_function(JsonEscapeScanner::Auto);
+    return active;
+}
+
+}  // namespace
+
+JsonEscapeScanner ActiveJsonEscapeScanner() {
+    return resolve(JsonEscapeScanner::Auto);
+}
+
+bool JsonEscapeScannerSupported(JsonEscapeScanner scanner) {
+    switch (scanner) {
+        case JsonEscapeScanner::Auto:
+        case JsonEscapeScanner::Scalar:
+            return true;
+#if defined(WSLMON_JSON_ESCAPE_X86)
+        case JsonEscapeScanner::Sse2:
+            return true;
+        case JsonEscapeScanner::Avx2:
+            return GetCpuFeatures().avx2;
+#endif
+        default:
+            return false;
+    }
+}
+
+std::size_t FindJsonEscape(std::string_view input, std::size_t from, JsonEscapeScanner scanner) {
+    if (from >= input.size()) {
+        return input.size();
+    }
+    const FindEscapeFn find = scanner == JsonEscapeScanner::Auto ? active_function() : scanner_function(scanner);
+    return find(input.data(), input.size(), from);
+}
+
+void AppendJsonEscaped(std::string &out, std::string_view input, JsonEscapeScanner scanner) {
+    static const char *kHex = "0123456789ABCDEF";
+    const FindEscapeFn find = scanner == JsonEscapeScanner::Auto ? active_function() : scanner_function(scanner);
+    const char *data = input.data();
+    const std::size_t size = input.size();
+    std::size_t run_start = 0;
+    while (run_start < size) {
+        const std::size_t i = find(data, size, run_start);
+        out.append(data + run_start, i - run_start);
+        if (i == size) {
+            break;
+        }
+        const char c = data[i];
+        switch (c) {
+            case '\\':
+                out += "\\\\";
+                break;
+            case '"':
+                out += "\\\"";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default: {
+                const auto code = static_cast<unsigned char>(c);
+                const char escaped[6] = {'\\', 'u', '0', '0', kHex[code >> 4], kHex[code & 0x0F]};
+                out.append(escaped, sizeof(escaped));
+                break;
+            }
+        }
+        run_start = i + 1;
+    }
+}
+
+}  // namespace wslmon
@@ -1,40 +1,49 @@
 #include "logger.hpp"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <condition_variable>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
-#include <iomanip>
+#include <iterator>
+#include <mutex>
 #include <sstream>
 #include <system_error>
 
 #include "crypto.hpp"
+#include "timestamp.hpp"
 
 namespace wslmon {
 
 namespace {
 constexpr std::size_t kMaxLogSizeBytes = 5 * 1024 * 1024;
-const std::string kZeroHash(64, '0');
-
-std::string format_rotation_suffix() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t_value = std::chrono::system_clock::to_time_t(now);
-    std::tm tm{};
-#ifdef _WIN32
-    gmtime_s(&tm, &time_t_value);
-#else
-    gmtime_r(&time_t_value, &tm);
-#endif
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y%m%dT%H%M%SZ");
-    return oss.str();
+// A whole segment plus room for the record that crosses the rotation size.
+constexpr std::size_t kSegmentPreallocationBytes = kMaxLogSizeBytes + 256 * 1024;
+const Symbol kDefaultCategory("General");
+constexpr std::string_view kEventPrefix = "{\"event\":";
+constexpr std::string_view kChainHashField = ",\"chainHash\":\"";
+constexpr std::string_view kHmacField = ",\"hmac\":\"";
+constexpr std::string_view kManifestAlgorithmField = "\"chainHashAlgorithm\"";
+constexpr std::size_t kDigestHexLength = 64;
+constexpr std::size_t kVerifyBatch = 1024;
+
+ChainHashAlgorithm load_chain_algorithm_from_env() {
+    ChainHashAlgorithm algorithm = ChainHashAlgorithm::Sha256;
+    const char *name = std::getenv("WSLMON_LOG_CHAIN_HASH");
+    if (name && *name && !ParseChainHashAlgorithm(name, algorithm)) {
+        algorithm = ChainHashAlgorithm::Sha256;
+    }
+    return algorithm;
 }
 
-std::vector<std::uint8_t> load_hmac_key_from_env() {
+HmacKey load_hmac_key_from_env() {
     const char *hex = std::getenv("WSLMON_LOG_HMAC_KEY");
     if (hex && *hex) {
         try {
-            return HexToBytes(hex);
+            const auto key = HexToBytes(hex);
+            return key.empty() ? HmacKey() : HmacKey(key);
         } catch (const std::exception &) {
         }
     }
@@ -45,7 +54,8 @@ std::vector<std::uint8_t> load_hmac_key_from_env() {
             std::ostringstream buffer;
             buffer << in.rdbuf();
             try {
-                return HexToBytes(buffer.str());
+                const auto key = HexToBytes(buffer.str());
+                return key.empty() ? HmacKey() : HmacKey(key);
             } catch (const std::exception &) {
             }
         }
@@ -53,18 +63,272 @@ std::vector<std::uint8_t> load_hmac_key_from_env() {
     return {};
 }
 
+std::array<char, 64> digest_hex(const std::array<std::uint8_t, 32> &digest) {
+    static constexpr char kHex[] = "0123456789abcdef";
+    std::array<char, 64> out{};
+    for (std::size_t i = 0; i < digest.size(); ++i) {
+        out[i * 2] = kHex[digest[i] >> 4];
+        out[i * 2 + 1] = kHex[digest[i] & 0x0Fu];
+    }
+    return out;
+}
+
+// One chain step: hash(hex(previous digest) || payload).
+std::array<std::uint8_t, 32> chain_link(ChainHashAlgorithm algorithm,
+                                        std::string_view previous_hex,
+                                        std::string_view payload) {
+    if (algorithm == ChainHashAlgorithm::Blake3) {
+        Blake3Context context;
+        context.Update(previous_hex);
+        context.Update(payload);
+        return context.Final();
+    }
+    Sha256Context context;
+    context.Update(previous_hex);
+    context.Update(payload);
+    return context.Final();
+}
+
+int hex_nibble(char c) {
+    if ('0' <= c && c <= '9') {
+        return c - '0';
+    }
+    if ('a' <= c && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if ('A' <= c && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+bool parse_digest(std::string_view hex, std::array<std::uint8_t, 32> &digest) {
+    if (hex.size() < digest.size() * 2) {
+        return false;
+    }
+    for (std::size_t i = 0; i < digest.size(); ++i) {
+        const int high = hex_nibble(hex[i * 2]);
+        const int low = hex_nibble(hex[i * 2 + 1]);
+        if (high < 0 || low < 0) {
+            return false;
+        }
+        digest[i] = static_cast<std::uint8_t>((high << 4) | low);
+    }
+    return true;
+}
+
+struct RecordFields {
+    std::string_view payload;
+    std::string_view chain_hash;
+    // Empty when the record is unsigned.
+    std::string_view hmac;
+};
+
+// Splits a log line into the chained/MACed payload and the recorded hashes.
+bool split_record(std::string_view line, RecordFields &fields) {
+    if (line.substr(0, kEventPrefix.size()) != kEventPrefix) {
+        return false;
+    }
+    const auto chain = line.rfind(kChainHashField);
+    if (chain == std::string_view::npos || chain < kEventPrefix.size()) {
+        return false;
+    }
+    fields.payload = line.substr(kEventPrefix.size(), chain - kEventPrefix.size());
+    fields.chain_hash = line.substr(chain + kChainHashField.size(), kDigestHexLength);
+    const auto hmac = line.find(kHmacField, chain + kChainHashField.size());
+    fields.hmac = hmac == std::string_view::npos ? std::string_view()
+                                                 : line.substr(hmac + kHmacField.size(), kDigestHexLength);
+    return fields.chain_hash.size() == kDigestHexLength;
+}
+
+// Calls |visit(line_number, line)| for every non-empty line before the
+// first NUL. A live preallocated segment ends in NUL padding; any other
+// byte after a NUL means records sit behind a zeroed gap where no reader
+// looks. Returns the line at which such a gap starts.
+template <typename Visit>
+std::optional<std::size_t> for_each_line(std::string_view text, Visit &&visit) {
+    const auto nul = text.find('\0');
+    const std::string_view data = text.substr(0, nul);
+    std::size_t line_number = 0;
+    std::size_t offset = 0;
+    while (offset < data.size()) {
+        auto end = data.find('\n', offset);
+        if (end == std::string_view::npos) {
+            end = data.size();
+        }
+        const std::string_view line = data.substr(offset, end - offset);
+        offset = end + 1;
+        const std::size_t current = line_number++;
+        if (!line.empty()) {
+            visit(current, line);
+        }
+    }
+    if (nul == std::string_view::npos || text.find_first_not_of('\0', nul) == std::string_view::npos) {
+        return std::nullopt;
+    }
+    return static_cast<std::size_t>(std::count(data.begin(), data.end(), '\n'));
+}
+
 }  // namespace
 
-JsonLogger::JsonLogger(std::filesystem::path log_path, std::string default_source)
+RecordHmacReport VerifyRecordHmacs(std::string_view log_text, const HmacKey &key) {
+    RecordHmacReport report;
+    std::vector<std::string_view> payloads;
+    std::vector<std::array<std::uint8_t, 32>> expected;
+    std::vector<std::size_t> lines;
+    std::vector<std::array<std::uint8_t, 32>> computed(kVerifyBatch);
+    payloads.reserve(kVerifyBatch);
+    expected.reserve(kVerifyBatch);
+    lines.reserve(kVerifyBatch);
+
+    auto flush = [&] {
+        HmacSha256Many(key, payloads.data(), payloads.size(), computed.data());
+        for (std::size_t i = 0; i < payloads.size(); ++i) {
+            if (computed[i] != expected[i]) {
+                report.failed_lines.push_back(lines[i]);
+            }
+        }
+        payloads.clear();
+        expected.clear();
+        lines.clear();
+    };
+
+    const auto gap = for_each_line(log_text, [&](std::size_t line_number, std::string_view line) {
+        ++report.records;
+        RecordFields fields;
+        std::array<std::uint8_t, 32> mac{};
+        if (key.empty() || !split_record(line, fields) || !parse_digest(fields.hmac, mac)) {
+            report.failed_lines.push_back(line_number);
+            return;
+        }
+        payloads.push_back(fields.payload);
+        expected.push_back(mac);
+        lines.push_back(line_number);
+        if (payloads.size() == kVerifyBatch) {
+            flush();
+        }
+    });
+    if (!payloads.empty()) {
+        flush();
+    }
+    if (gap) {
+        report.failed_lines.push_back(*gap);
+    }
+    // Batches finish out of order relative to early rejects.
+    std::sort(report.failed_lines.begin(), report.failed_lines.end());
+    return report;
+}
+
+const char *ChainHashAlgorithmName(ChainHashAlgorithm algorithm) {
+    switch (algorithm) {
+        case ChainHashAlgorithm::Blake3:
+            return "blake3";
+        case ChainHashAlgorithm::Sha256:
+        default:
+            return "sha256";
+    }
+}
+
+bool ParseChainHashAlgorithm(std::string_view name, ChainHashAlgorithm &algorithm) {
+    if (name == "sha256") {
+        algorithm = ChainHashAlgorithm::Sha256;
+        return true;
+    }
+    if (name == "blake3") {
+        algorithm = ChainHashAlgorithm::Blake3;
+        return true;
+    }
+    return false;
+}
+
+ChainReport VerifyChain(std::string_view log_text, ChainHashAlgorithm algorithm) {
+    ChainReport report;
+    std::array<std::uint8_t, 32> chain{};
+    const auto gap = for_each_line(log_text, [&](std::size_t line_number, std::string_view line) {
+        ++report.records;
+        if (report.first_broken_line) {
+            return;
+        }
+        RecordFields fields;
+        std::array<std::uint8_t, 32> recorded{};
+        const auto previous_hex = digest_hex(chain);
+        if (!split_record(line, fields) || !parse_digest(fields.chain_hash, recorded)) {
+            report.first_broken_line = line_number;
+            return;
+        }
+        chain = chain_link(algorithm, std::string_view(previous_hex.data(), previous_hex.size()), fields.payload);
+        if (chain != recorded) {
+            report.first_broken_line = line_number;
+        }
+    });
+    if (gap && !report.first_broken_line) {
+        report.first_broken_line = gap;
+    }
+    report.final_chain_hash = BytesToHex(chain.data(), chain.size());
+    return report;
+}
+
+bool ReadManifestChainHashAlgorithm(std::string_view manifest_text, ChainHashAlgorithm &algorithm) {
+    const auto field = manifest_text.find(kManifestAlgorithmField);
+    if (field == std::string_view::npos) {
+        algorithm = ChainHashAlgorithm::Sha256;
+        return true;
+    }
+    const auto open = manifest_text.find('"', manifest_text.find(':', field + kManifestAlgorithmField.size()));
+    const auto close = open == std::string_view::npos ? open : manifest_text.find('"', open + 1);
+    if (close == std::string_view::npos) {
+        return false;
+    }
+    return ParseChainHashAlgorithm(manifest_text.substr(open + 1, close - open - 1), algorithm);
+}
+
+struct JsonLogger::CommitWaiter {
+    std::mutex mutex;
+    std::condition_variable done_cv;
+    bool done = false;
+};
+
+struct JsonLogger::PendingEntry {
+    enum class Kind { Record, Flush, Rotate };
+
+    Kind kind = Kind::Record;
+    EventRecord record{};
+    std::chrono::system_clock::time_point received;
+    // Set when the producer blocks until the entry has been committed.
+    CommitWaiter *waiter = nullptr;
+    // Where the record sits in the attached black box.
+    std::uint64_t black_box_offset = BlackBoxRing::kNotRecorded;
+    PendingEntry *next = nullptr;
+};
+
+JsonLogger::JsonLogger(std::filesystem::path log_path, std::string default_source, LogCommitPolicy policy)
     : log_path_(std::move(log_path)),
       chain_state_path_(log_path_),
-      default_source_(std::move(default_source)),
+      default_source_(default_source),
       hmac_key_(load_hmac_key_from_env()),
-      current_chain_hash_(kZeroHash) {
+      configured_chain_algorithm_(load_chain_algorithm_from_env()),
+      chain_algorithm_(configured_chain_algorithm_),
+      policy_(policy) {
     chain_state_path_ += ".chainstate";
     ensure_directory_hardening();
     load_chain_state();
-    open_stream();
+    open_file();
+    persist_chain_state();
+    if (policy_.group_commit) {
+        writer_ = std::thread([this] { writer_loop(); });
+    }
+}
+
+JsonLogger::~JsonLogger() {
+    if (!writer_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stopping_.store(true);
+    }
+    wake_.notify_one();
+    writer_.join();
 }
 
 void JsonLogger::ensure_directory_hardening() {
@@ -86,52 +350,189 @@ void JsonLogger::ensure_directory_hardening() {
 #endif
 }
 
-void JsonLogger::open_stream() {
-    stream_.open(log_path_, std::ios::out | std::ios::app | std::ios::binary);
+void JsonLogger::open_file() {
+    file_.Open(log_path_, policy_.preallocate_segments ? kSegmentPreallocationBytes : 0);
+}
+
+std::string JsonLogger::CurrentChainHash() {
+    if (policy_.group_commit) {
+        Flush();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return BytesToHex(current_chain_.data(), current_chain_.size());
+}
+
+ChainHashAlgorithm JsonLogger::CurrentChainHashAlgorithm() {
+    if (policy_.group_commit) {
+        Flush();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return chain_algorithm_;
 }
 
 void JsonLogger::load_chain_state() {
-    std::ifstream in(chain_state_path_);
-    if (!in) {
-        current_chain_hash_ = kZeroHash;
-        next_sequence_ = 1;
-        entries_since_rotation_ = 0;
+    std::string text;
+    {
+        std::ifstream in(log_path_, std::ios::binary);
+        text.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    ChainState state;
+    const bool have_state = state_file_.Open(chain_state_path_) && state_file_.Load(state);
+    // A NUL anywhere means padding or a zeroed page, which only recovery
+    // cuts away.
+    if (have_state && state.log_size == text.size() && text.find('\0') == std::string::npos) {
+        current_chain_ = state.chain;
+        next_sequence_ = state.next_sequence == 0 ? 1 : state.next_sequence;
+        entries_since_rotation_ = state.entries_since_rotation;
+        // An empty segment takes the configured algorithm.
+        if (entries_since_rotation_ > 0) {
+            chain_algorithm_ = static_cast<ChainHashAlgorithm>(state.algorithm);
+        }
         return;
     }
-    in >> current_chain_hash_ >> next_sequence_ >> entries_since_rotation_;
-    if (current_chain_hash_.size() != 64) {
-        current_chain_hash_ = kZeroHash;
+    recover_chain_state(have_state ? &state : nullptr, std::move(text));
+}
+
+void JsonLogger::recover_chain_state(const ChainState *state, std::string text) {
+    // Verifiers stop at the first NUL, so the chain resumes after the last
+    // complete line before it. Past that point only NUL padding and a record
+    // torn by a crash may be dropped. Anything written behind a zeroed gap
+    // is evidence and is moved to a sealed gap segment below.
+    const std::size_t file_size = text.size();
+    const auto nul = text.find('\0');
+    const std::size_t kept = std::string_view(text).substr(0, nul).rfind('\n') + 1;
+    const auto last_data = text.find_last_not_of('\0');
+    std::string gap_tail;
+    if (nul != std::string::npos && last_data != std::string::npos && last_data > nul) {
+        gap_tail = text.substr(kept, last_data + 1 - kept);
     }
-    if (next_sequence_ == 0) {
-        next_sequence_ = 1;
+    text.resize(kept);
+
+    current_chain_.fill(0);
+    next_sequence_ = 1;
+    entries_since_rotation_ = 0;
+    std::size_t start = 0;
+    bool algorithm_known = false;
+    // A lagging page still covers a prefix of the log when it ends on a line
+    // boundary; otherwise the segment is rebuilt from its first line.
+    if (state && state->log_size <= text.size() && (state->log_size == 0 || text[state->log_size - 1] == '\n')) {
+        start = static_cast<std::size_t>(state->log_size);
+        current_chain_ = state->chain;
+        next_sequence_ = state->next_sequence == 0 ? 1 : state->next_sequence;
+        entries_since_rotation_ = state->entries_since_rotation;
+        if (entries_since_rotation_ > 0) {
+            chain_algorithm_ = static_cast<ChainHashAlgorithm>(state->algorithm);
+            algorithm_known = true;
+        }
+    }
+
+    EventRecord record{};
+    for_each_line(std::string_view(text).substr(start), [&](std::size_t, std::string_view line) {
+        ++entries_since_rotation_;
+        RecordFields fields;
+        std::array<std::uint8_t, 32> recorded{};
+        if (!split_record(line, fields) || !parse_digest(fields.chain_hash, recorded)) {
+            return;
+        }
+        if (!algorithm_known) {
+            // The segment's first record tells which algorithm built it.
+            const auto previous_hex = digest_hex(current_chain_);
+            const std::string_view previous(previous_hex.data(), previous_hex.size());
+            chain_algorithm_ = chain_link(ChainHashAlgorithm::Blake3, previous, fields.payload) == recorded
+                                   ? ChainHashAlgorithm::Blake3
+                                   : ChainHashAlgorithm::Sha256;
+            algorithm_known = true;
+        }
+        current_chain_ = recorded;
+        record.sequence = 0;
+        if (DeserializeEvent(fields.payload, record) && record.sequence >= next_sequence_) {
+            next_sequence_ = record.sequence + 1;
+        }
+    });
+
+    std::uint64_t new_size = kept;
+    if (!gap_tail.empty()) {
+        if (seal_gap_segment(kept, gap_tail)) {
+            // Sequences stay unique across the log and its gap segments.
+            std::size_t offset = 0;
+            while (offset < gap_tail.size()) {
+                auto end = gap_tail.find('\n', offset);
+                if (end == std::string::npos) {
+                    end = gap_tail.size();
+                }
+                const std::string_view line = std::string_view(gap_tail).substr(offset, end - offset);
+                offset = end + 1;
+                RecordFields fields;
+                record.sequence = 0;
+                if (line.find('\0') == std::string_view::npos && split_record(line, fields) &&
+                    DeserializeEvent(fields.payload, record) && record.sequence >= next_sequence_) {
+                    next_sequence_ = record.sequence + 1;
+                }
+            }
+        } else {
+            // Without a durable copy the records stay where they are, and
+            // only the padding after them goes.
+            new_size = last_data + 1;
+        }
+    }
+    if (new_size < file_size) {
+        std::error_code ec;
+        std::filesystem::resize_file(log_path_, new_size, ec);
     }
 }
 
-void JsonLogger::persist_chain_state() {
-    std::ofstream out(chain_state_path_, std::ios::out | std::ios::trunc | std::ios::binary);
-    out << current_chain_hash_ << '\n' << next_sequence_ << '\n' << entries_since_rotation_ << '\n';
+bool JsonLogger::seal_gap_segment(std::uint64_t log_offset, std::string_view tail) {
+    const auto now = std::chrono::system_clock::now();
+    const std::string stamp = FormatTimestamp(now, TimestampFormat::CompactSeconds);
+    std::filesystem::path gap_path = log_path_;
+    gap_path += ".gap-" + stamp;
+    for (int attempt = 1; std::filesystem::exists(gap_path); ++attempt) {
+        gap_path = log_path_;
+        gap_path += ".gap-" + stamp + '-' + std::to_string(attempt);
+    }
+
+    AppendFile segment;
+    if (!segment.Open(gap_path) || !segment.Write(tail) || !segment.Sync()) {
+        return false;
+    }
+    segment.Close();
+
+    const auto digest = Sha256(tail);
+    std::ostringstream manifest;
+    manifest << "{\n";
+    manifest << "  \"chainHashAlgorithm\": \"" << ChainHashAlgorithmName(chain_algorithm_) << "\",\n";
+    manifest << "  \"precedingChainHash\": \"" << BytesToHex(current_chain_.data(), current_chain_.size())
+             << "\",\n";
+    manifest << "  \"logOffset\": " << log_offset << ",\n";
+    manifest << "  \"bytes\": " << tail.size() << ",\n";
+    manifest << "  \"sha256\": \"" << BytesToHex(digest.data(), digest.size()) << "\",\n";
+    if (!hmac_key_.empty()) {
+        const auto mac =
+            HmacSha256(hmac_key_, reinterpret_cast<const std::uint8_t *>(tail.data()), tail.size());
+        manifest << "  \"hmac\": \"" << BytesToHex(mac.data(), mac.size()) << "\",\n";
+    }
+    manifest << "  \"recoveredAt\": \"" << FormatTimestamp(now, TimestampFormat::Iso8601Seconds) << "\"\n";
+    manifest << "}\n";
+
+    std::filesystem::path manifest_path = gap_path;
+    manifest_path += ".manifest";
+    AppendFile manifest_file;
+    return manifest_file.Open(manifest_path) && manifest_file.Write(manifest.str()) && manifest_file.Sync();
 }
 
-std::string JsonLogger::format_timestamp_utc() const {
-    auto now = std::chrono::system_clock::now();
-    auto time_t_value = std::chrono::system_clock::to_time_t(now);
-    std::tm tm{};
-#ifdef _WIN32
-    gmtime_s(&tm, &time_t_value);
-#else
-    gmtime_r(&time_t_value, &tm);
-#endif
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
-    return oss.str();
+void JsonLogger::persist_chain_state() {
+    ChainState state;
+    state.chain = current_chain_;
+    state.next_sequence = next_sequence_;
+    state.entries_since_rotation = entries_since_rotation_;
+    state.log_size = file_.size();
+    state.algorithm = static_cast<std::uint8_t>(chain_algorithm_);
+    state_file_.Store(state);
 }
 
-void JsonLogger::Append(const EventRecord &record) {
-    auto now = std::chrono::system_clock::now();
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!stream_.is_open()) {
-        open_stream();
-    }
+std::uint64_t JsonLogger::format_line(const EventRecord &record,
+                                      std::chrono::system_clock::time_point now,
+                                      std::string &line) {
     EventRecord enriched = record;
     if (enriched.sequence == 0) {
         enriched.sequence = next_sequence_++;
@@ -145,43 +546,121 @@ void JsonLogger::Append(const EventRecord &record) {
         enriched.source = default_source_;
     }
     if (enriched.category.empty()) {
-        enriched.category = "General";
+        enriched.category = kDefaultCategory;
     }
-    if (enriched.severity.empty()) {
-        enriched.severity = "Info";
+    if (enriched.severity == Severity::Unspecified) {
+        enriched.severity = Severity::Info;
     }
 
-    const std::string payload = SerializeEvent(enriched);
-    const std::string hash_input = current_chain_hash_ + payload;
-    const auto chain_bytes = Sha256(reinterpret_cast<const std::uint8_t *>(hash_input.data()), hash_input.size());
-    current_chain_hash_ = BytesToHex(chain_bytes.data(), chain_bytes.size());
+    // The envelope is assembled in a reused buffer; the payload is the slice
+    // between the "event" key and the chain hash.
+    line.assign(kEventPrefix.data(), kEventPrefix.size());
+    SerializeEvent(enriched, line);
+    const std::string_view payload(line.data() + kEventPrefix.size(), line.size() - kEventPrefix.size());
+
+    // The chain links hex(previous digest) || payload, so the previous
+    // digest's hex form is what gets hashed.
+    const auto previous_hex = digest_hex(current_chain_);
+    current_chain_ =
+        chain_link(chain_algorithm_, std::string_view(previous_hex.data(), previous_hex.size()), payload);
 
-    std::string hmac_hex;
+    std::array<std::uint8_t, 32> hmac{};
     if (!hmac_key_.empty()) {
-        const auto hmac = HmacSha256(hmac_key_, reinterpret_cast<const std::uint8_t *>(payload.data()), payload.size());
-        hmac_hex = BytesToHex(hmac.data(), hmac.size());
+        hmac = HmacSha256(hmac_key_, reinterpret_cast<const std::uint8_t *>(payload.data()), payload.size());
     }
 
-    stream_ << '{' << "\"event\":" << payload << ",\"chainHash\":\"" << current_chain_hash_ << "\"";
-    if (!hmac_hex.empty()) {
-        stream_ << ",\"hmac\":\"" << hmac_hex << "\"";
+    line += kChainHashField;
+    AppendHex(line, current_chain_.data(), current_chain_.size());
+    line.push_back('"');
+    if (!hmac_key_.empty()) {
+        line += kHmacField;
+        AppendHex(line, hmac.data(), hmac.size());
+        line.push_back('"');
     }
-    stream_ << "}\n";
-    stream_.flush();
-
+    line += "}\n";
     ++entries_since_rotation_;
+    return enriched.sequence;
+}
+
+void JsonLogger::Append(const EventRecord &record) {
+    const auto now = std::chrono::system_clock::now();
+    BlackBoxRing *black_box = black_box_.load(std::memory_order_acquire);
+    const std::uint64_t black_box_offset = black_box ? black_box->Append(record) : BlackBoxRing::kNotRecorded;
+    if (policy_.group_commit) {
+        auto *entry = new PendingEntry;
+        entry->record = record;
+        entry->received = now;
+        entry->black_box_offset = black_box_offset;
+        if (record.severity == Severity::Critical) {
+            wait_for_writer(entry);
+        } else {
+            enqueue(entry);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_.is_open()) {
+        open_file();
+    }
+    const std::uint64_t sequence = format_line(record, now, line_buffer_);
+    file_.Write(line_buffer_);
+    if (black_box_offset != BlackBoxRing::kNotRecorded) {
+        unsynced_logged_.push_back({black_box_offset, sequence});
+    }
+    if (record.severity == Severity::Critical) {
+        sync_locked();
+    }
     persist_chain_state();
 
-    if (stream_.tellp() > static_cast<std::streamoff>(kMaxLogSizeBytes)) {
-        Rotate();
+    if (file_.size() > kMaxLogSizeBytes) {
+        rotate_locked();
     }
 }
 
+void JsonLogger::AttachBlackBox(BlackBoxRing *ring) {
+    black_box_.store(ring, std::memory_order_release);
+}
+
+void JsonLogger::Flush() {
+    if (!policy_.group_commit) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sync_locked();
+        return;
+    }
+    auto *entry = new PendingEntry;
+    entry->kind = PendingEntry::Kind::Flush;
+    wait_for_writer(entry);
+}
+
 void JsonLogger::Rotate() {
-    stream_.close();
+    if (!policy_.group_commit) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rotate_locked();
+        return;
+    }
+    auto *entry = new PendingEntry;
+    entry->kind = PendingEntry::Kind::Rotate;
+    wait_for_writer(entry);
+}
+
+void JsonLogger::sync_locked() {
+    if (!file_.Sync()) {
+        return;
+    }
+    BlackBoxRing *black_box = black_box_.load(std::memory_order_acquire);
+    if (black_box && !unsynced_logged_.empty()) {
+        black_box->MarkLogged(unsynced_logged_.data(), unsynced_logged_.size());
+    }
+    unsynced_logged_.clear();
+}
+
+void JsonLogger::rotate_locked() {
+    sync_locked();
+    file_.Close();
 
     auto rotated_name = log_path_;
-    rotated_name += '.' + format_rotation_suffix();
+    rotated_name += '.' + FormatTimestamp(std::chrono::system_clock::now(), TimestampFormat::CompactSeconds);
     std::error_code ec;
     std::filesystem::rename(log_path_, rotated_name, ec);
 
@@ -189,18 +668,157 @@ void JsonLogger::Rotate() {
     manifest_path += ".manifest";
     std::ofstream manifest(manifest_path, std::ios::out | std::ios::trunc | std::ios::binary);
     manifest << "{\n";
-    manifest << "  \"finalChainHash\": \"" << current_chain_hash_ << "\",\n";
+    manifest << "  \"chainHashAlgorithm\": \"" << ChainHashAlgorithmName(chain_algorithm_) << "\",\n";
+    manifest << "  \"finalChainHash\": \"" << BytesToHex(current_chain_.data(), current_chain_.size()) << "\",\n";
     manifest << "  \"entries\": " << entries_since_rotation_ << ",\n";
-    manifest << "  \"rotatedAt\": \"" << format_timestamp_utc() << "\"\n";
+    manifest << "  \"rotatedAt\": \""
+             << FormatTimestamp(std::chrono::system_clock::now(), TimestampFormat::Iso8601Seconds) << "\"\n";
     manifest << "}\n";
     manifest.close();
 
-    current_chain_hash_ = kZeroHash;
+    current_chain_.fill(0);
+    chain_algorithm_ = configured_chain_algorithm_;
     entries_since_rotation_ = 0;
     next_sequence_ = 1;
     persist_chain_state();
-    open_stream();
+    open_file();
 }
 
-}  // namespace wslmon
+void JsonLogger::enqueue(PendingEntry *entry) {
+    PendingEntry *head = pending_.load(std::memory_order_relaxed);
+    do {
+        entry->next = head;
+    } while (!pending_.compare_exchange_weak(head, entry, std::memory_order_release, std::memory_order_relaxed));
+    // The writer parks only on an empty list, so only the producer that
+    // makes it non-empty has to wake it.
+    if (head == nullptr) {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        wake_.notify_one();
+    }
+}
 
+void JsonLogger::wait_for_writer(PendingEntry *entry) {
+    CommitWaiter waiter;
+    entry->waiter = &waiter;
+    enqueue(entry);
+    std::unique_lock<std::mutex> lock(waiter.mutex);
+    waiter.done_cv.wait(lock, [&] { return waiter.done; });
+}
+
+void JsonLogger::writer_loop() {
+    using Clock = std::chrono::steady_clock;
+    std::vector<PendingEntry *> batch;
+    std::vector<CommitWaiter *> waiters;
+    std::vector<std::string_view> parts;
+    std::size_t unsynced_bytes = 0;
+    Clock::time_point first_unsynced;
+
+    const auto sync = [&] {
+        sync_locked();
+        unsynced_bytes = 0;
+    };
+
+    for (;;) {
+        // Read the stop flag before draining so nothing queued ahead of it
+        // is left behind.
+        const bool stopping = stopping_.load();
+        PendingEntry *head = pending_.exchange(nullptr, std::memory_order_acquire);
+        if (!head) {
+            if (stopping) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                sync();
+                return;
+            }
+            std::unique_lock<std::mutex> wake_lock(wake_mutex_);
+            const auto ready = [this] {
+                return pending_.load(std::memory_order_acquire) != nullptr || stopping_.load();
+            };
+            if (unsynced_bytes == 0) {
+                wake_.wait(wake_lock, ready);
+            } else if (!wake_.wait_until(wake_lock, first_unsynced + policy_.max_latency, ready)) {
+                wake_lock.unlock();
+                std::lock_guard<std::mutex> lock(mutex_);
+                sync();
+            }
+            continue;
+        }
+
+        batch.clear();
+        for (; head; head = head->next) {
+            batch.push_back(head);
+        }
+        std::reverse(batch.begin(), batch.end());
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!file_.is_open()) {
+            open_file();
+        }
+        bool force_sync = false;
+        std::size_t lines = 0;
+        std::size_t line_bytes = 0;
+        const auto write_lines = [&] {
+            if (lines == 0) {
+                return;
+            }
+            parts.assign(batch_lines_.begin(), batch_lines_.begin() + static_cast<std::ptrdiff_t>(lines));
+            file_.Write(parts.data(), parts.size());
+            persist_chain_state();
+            if (unsynced_bytes == 0) {
+                first_unsynced = Clock::now();
+            }
+            unsynced_bytes += line_bytes;
+            lines = 0;
+            line_bytes = 0;
+        };
+
+        for (PendingEntry *entry : batch) {
+            switch (entry->kind) {
+                case PendingEntry::Kind::Record: {
+                    if (lines == batch_lines_.size()) {
+                        batch_lines_.emplace_back();
+                    }
+                    const std::uint64_t sequence = format_line(entry->record, entry->received, batch_lines_[lines]);
+                    if (entry->black_box_offset != BlackBoxRing::kNotRecorded) {
+                        unsynced_logged_.push_back({entry->black_box_offset, sequence});
+                    }
+                    line_bytes += batch_lines_[lines].size();
+                    ++lines;
+                    if (file_.size() + line_bytes > kMaxLogSizeBytes) {
+                        write_lines();
+                        rotate_locked();
+                        unsynced_bytes = 0;
+                    }
+                    break;
+                }
+                case PendingEntry::Kind::Rotate:
+                    write_lines();
+                    rotate_locked();
+                    unsynced_bytes = 0;
+                    break;
+                case PendingEntry::Kind::Flush:
+                    break;
+            }
+            if (entry->waiter) {
+                force_sync = true;
+                waiters.push_back(entry->waiter);
+            }
+        }
+        write_lines();
+        if (unsynced_bytes > 0 && (force_sync || unsynced_bytes >= policy_.max_unsynced_bytes ||
+                                   Clock::now() - first_unsynced >= policy_.max_latency)) {
+            sync();
+        }
+
+        for (PendingEntry *entry : batch) {
+            delete entry;
+        }
+        for (CommitWaiter *waiter : waiters) {
+            std::lock_guard<std::mutex> waiter_lock(waiter->mutex);
+            waiter->done = true;
+            waiter->done_cv.notify_one();
+        }
+        waiters.clear();
+    }
+}
+
+}  // namespace wslmon
@@ -0,0 +1,128 @@
+#include "mapped_file.hpp"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace wslmon {
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::filesystem::path &path) {
+    Close();
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+    if (size.QuadPart == 0) {
+        CloseHandle(file);
+        return true;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) {
+        return false;
+    }
+    const void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view) {
+        return false;
+    }
+    data_ = static_cast<const char *>(view);
+    size_ = static_cast<std::size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data_) {
+        UnmapViewOfFile(data_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+}
+
+#else
+
+bool MappedFile::Open(const std::filesystem::path &path) {
+    Close();
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+    if (info.st_size == 0) {
+        ::close(fd);
+        return true;
+    }
+    char last = 0;
+    if (::pread(fd, &last, 1, info.st_size - 1) != 1 || last == '\0') {
+        const bool read = read_all(fd, static_cast<std::size_t>(info.st_size));
+        ::close(fd);
+        return read;
+    }
+    void *view = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    data_ = static_cast<const char *>(view);
+    size_ = static_cast<std::size_t>(info.st_size);
+    return true;
+}
+
+bool MappedFile::read_all(int fd, std::size_t size) {
+    buffer_.resize(size);
+    std::size_t done = 0;
+    while (done < buffer_.size()) {
+        const ssize_t got = ::pread(fd, &buffer_[done], buffer_.size() - done, static_cast<off_t>(done));
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got < 0) {
+            buffer_.clear();
+            return false;
+        }
+        if (got == 0) {
+            // Trimmed while we read.
+            break;
+        }
+        done += static_cast<std::size_t>(got);
+    }
+    buffer_.resize(done);
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data_ && data_ != buffer_.data()) {
+        ::munmap(const_cast<char *>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    buffer_.clear();
+}
+
+#endif
+
+}  // namespace wslmon
@@ -0,0 +1,79 @@
+#include "priority_ring.hpp"
+
+#include <algorithm>
+
+namespace wslmon {
+
+EventPriority PriorityOf(Severity severity) {
+    switch (severity) {
+        case Severity::Warning:
+            return EventPriority::Elevated;
+        case Severity::Error:
+        case Severity::Critical:
+            return EventPriority::Urgent;
+        default:
+            return EventPriority::Routine;
+    }
+}
+
+const char *EventPriorityName(EventPriority priority) {
+    switch (priority) {
+        case EventPriority::Elevated:
+            return "elevated";
+        case EventPriority::Urgent:
+            return "urgent";
+        default:
+            return "routine";
+    }
+}
+
+PriorityRing::PriorityRing(const std::array<std::size_t, kEventPriorityCount> &capacities)
+    : capacities_(capacities) {
+    for (std::size_t i = 0; i < kEventPriorityCount; ++i) {
+        partitions_[i] = std::make_unique<RingBuffer<Stamped>>(capacities_[i]);
+    }
+}
+
+void PriorityRing::Push(EventRecord record) {
+    const auto partition = static_cast<std::size_t>(PriorityOf(record.severity));
+    Stamped stamped;
+    stamped.arrival = next_arrival_.fetch_add(1, std::memory_order_relaxed);
+    stamped.record = std::move(record);
+    partitions_[partition]->Push(std::move(stamped));
+}
+
+std::vector<EventRecord> PriorityRing::Snapshot() const {
+    struct Position {
+        std::uint64_t arrival;
+        std::uint32_t partition;
+        std::uint32_t index;
+    };
+    std::array<std::vector<Stamped>, kEventPriorityCount> parts;
+    std::vector<Position> order;
+    for (std::size_t i = 0; i < kEventPriorityCount; ++i) {
+        parts[i] = partitions_[i]->Snapshot();
+        for (std::size_t j = 0; j < parts[i].size(); ++j) {
+            order.push_back({parts[i][j].arrival, static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(j)});
+        }
+    }
+    // Producers racing into one partition can land out of stamp order, so
+    // sort rather than merge. Sorting positions keeps the records in place.
+    std::sort(order.begin(), order.end(),
+              [](const Position &lhs, const Position &rhs) { return lhs.arrival < rhs.arrival; });
+    std::vector<EventRecord> out;
+    out.reserve(order.size());
+    for (const auto &position : order) {
+        out.push_back(std::move(parts[position.partition][position.index].record));
+    }
+    return out;
+}
+
+std::array<PriorityRing::Occupancy, kEventPriorityCount> PriorityRing::occupancy() const {
+    std::array<Occupancy, kEventPriorityCount> result{};
+    for (std::size_t i = 0; i < kEventPriorityCount; ++i) {
+        result[i] = {static_cast<EventPriority>(i), partitions_[i]->size(), capacities_[i]};
+    }
+    return result;
+}
+
+}  // namespace wslmon
@@ -0,0 +1,125 @@
+#include "symbol.hpp"
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace wslmon {
+namespace {
+constexpr std::uint32_t kChunkBits = 10;
+constexpr std::uint32_t kChunkSize = 1u << kChunkBits;
+constexpr std::uint32_t kMaxChunks = 4096;
+// Untrusted text stops being interned once the table holds this many
+// symbols, leaving the rest of the ids to the process's own vocabulary.
+constexpr std::uint32_t kMaxUntrustedSymbols = 64 * kChunkSize;
+constexpr std::size_t kMaxUntrustedLength = 256;
+
+// Ids resolve through fixed chunks that are never moved once published, so
+// Symbol::view() reads without taking the table lock.
+class SymbolTable {
+  public:
+    SymbolTable() {
+        for (auto &chunk : chunks_) {
+            chunk.store(nullptr, std::memory_order_relaxed);
+        }
+        insert_locked(std::string_view{});
+        unknown_id_ = insert_locked(Symbol::kUnknownText);
+    }
+
+    std::uint32_t intern(std::string_view text) {
+        if (text.empty()) {
+            return 0;
+        }
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = index_.find(text);
+            if (it != index_.end()) {
+                return it->second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto it = index_.find(text);
+        if (it != index_.end()) {
+            return it->second;
+        }
+        return insert_locked(text);
+    }
+
+    std::uint32_t intern_untrusted(std::string_view text) {
+        if (text.empty()) {
+            return 0;
+        }
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = index_.find(text);
+            if (it != index_.end()) {
+                return it->second;
+            }
+        }
+        if (text.size() > kMaxUntrustedLength) {
+            return unknown_id_;
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto it = index_.find(text);
+        if (it != index_.end()) {
+            return it->second;
+        }
+        return next_id_ < kMaxUntrustedSymbols ? insert_locked(text) : unknown_id_;
+    }
+
+    std::string_view lookup(std::uint32_t id) const {
+        const auto *chunk = chunks_[id >> kChunkBits].load(std::memory_order_acquire);
+        return chunk ? chunk[id & (kChunkSize - 1)] : std::string_view{};
+    }
+
+  private:
+    std::uint32_t insert_locked(std::string_view text) {
+        const auto id = next_id_;
+        const auto chunk_index = id >> kChunkBits;
+        if (chunk_index >= kMaxChunks) {
+            throw std::length_error("Symbol table exhausted");
+        }
+        if (!owned_chunks_[chunk_index]) {
+            owned_chunks_[chunk_index] = std::make_unique<std::string_view[]>(kChunkSize);
+            chunks_[chunk_index].store(owned_chunks_[chunk_index].get(), std::memory_order_release);
+        }
+        const std::string &stored = storage_.emplace_back(text);
+        const std::string_view view(stored);
+        owned_chunks_[chunk_index][id & (kChunkSize - 1)] = view;
+        index_.emplace(view, id);
+        ++next_id_;
+        return id;
+    }
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string_view, std::uint32_t> index_;
+    std::deque<std::string> storage_;
+    std::array<std::unique_ptr<std::string_view[]>, kMaxChunks> owned_chunks_;
+    std::array<std::atomic<const std::string_view *>, kMaxChunks> chunks_;
+    std::uint32_t next_id_ = 0;
+    std::uint32_t unknown_id_ = 0;
+};
+
+SymbolTable &Table() {
+    static SymbolTable *table = new SymbolTable();
+    return *table;
+}
+
+}  // namespace
+
+std::uint32_t Symbol::Intern(std::string_view text) { return Table().intern(text); }
+
+Symbol Symbol::FromUntrusted(std::string_view text) {
+    Symbol symbol;
+    symbol.id_ = Table().intern_untrusted(text);
+    return symbol;
+}
+
+std::string_view Symbol::view() const { return id_ == 0 ? std::string_view{} : Table().lookup(id_); }
+
+}  // namespace wslmon
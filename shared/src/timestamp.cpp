@@ -0,0 +1,197 @@
+#include "timestamp.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace wslmon {
+namespace {
+constexpr std::int64_t kSecondsPerDay = 86400;
+constexpr std::int64_t kMicrosPerSecond = 1000000;
+
+struct CivilTime {
+    std::int64_t year;
+    unsigned month;
+    unsigned day;
+    unsigned hour;
+    unsigned minute;
+    unsigned second;
+};
+
+// days_from_civil / civil_from_days from Howard Hinnant's date algorithms.
+std::int64_t days_from_civil(std::int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2 ? 1 : 0;
+    const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const auto year_of_era = static_cast<unsigned>(year - era * 400);
+    const unsigned day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + static_cast<std::int64_t>(day_of_era) - 719468;
+}
+
+CivilTime civil_from_seconds(std::int64_t seconds_total) {
+    std::int64_t days = seconds_total / kSecondsPerDay;
+    std::int64_t second_of_day = seconds_total % kSecondsPerDay;
+    if (second_of_day < 0) {
+        second_of_day += kSecondsPerDay;
+        days -= 1;
+    }
+    days += 719468;
+    const std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const std::int64_t day_of_era = days - era * 146097;
+    const std::int64_t year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    const std::int64_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    const std::int64_t mp = (5 * day_of_year + 2) / 153;
+
+    CivilTime civil{};
+    civil.day = static_cast<unsigned>(day_of_year - (153 * mp + 2) / 5 + 1);
+    civil.month = static_cast<unsigned>(mp < 10 ? mp + 3 : mp - 9);
+    civil.year = year_of_era + era * 400 + (civil.month <= 2 ? 1 : 0);
+    civil.hour = static_cast<unsigned>(second_of_day / 3600);
+    civil.minute = static_cast<unsigned>((second_of_day / 60) % 60);
+    civil.second = static_cast<unsigned>(second_of_day % 60);
+    return civil;
+}
+
+inline void put_digits(char *out, std::uint64_t value, int width) {
+    for (int i = width - 1; i >= 0; --i) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+// Writes YYYY-MM-DDTHH:MM:SS (19 chars).
+void write_iso_prefix(char *out, const CivilTime &civil) {
+    put_digits(out, static_cast<std::uint64_t>(civil.year), 4);
+    out[4] = '-';
+    put_digits(out + 5, civil.month, 2);
+    out[7] = '-';
+    put_digits(out + 8, civil.day, 2);
+    out[10] = 'T';
+    put_digits(out + 11, civil.hour, 2);
+    out[13] = ':';
+    put_digits(out + 14, civil.minute, 2);
+    out[16] = ':';
+    put_digits(out + 17, civil.second, 2);
+}
+
+struct PrefixCache {
+    std::int64_t second = std::numeric_limits<std::int64_t>::min();
+    char prefix[19] = {};
+};
+
+const char *cached_iso_prefix(std::int64_t seconds_total) {
+    thread_local PrefixCache cache;
+    if (cache.second != seconds_total) {
+        write_iso_prefix(cache.prefix, civil_from_seconds(seconds_total));
+        cache.second = seconds_total;
+    }
+    return cache.prefix;
+}
+
+bool read_fixed(std::string_view text, std::size_t offset, int width, unsigned &value) {
+    unsigned result = 0;
+    for (int i = 0; i < width; ++i) {
+        const char c = text[offset + static_cast<std::size_t>(i)];
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        result = result * 10 + static_cast<unsigned>(c - '0');
+    }
+    value = result;
+    return true;
+}
+
+}  // namespace
+
+void AppendTimestamp(std::string &out, std::chrono::system_clock::time_point tp, TimestampFormat format) {
+    using namespace std::chrono;
+    const std::int64_t micros_total = duration_cast<microseconds>(tp.time_since_epoch()).count();
+    std::int64_t seconds_total = micros_total / kMicrosPerSecond;
+    std::int64_t fractional = micros_total % kMicrosPerSecond;
+    if (fractional < 0) {
+        fractional += kMicrosPerSecond;
+        seconds_total -= 1;
+    }
+
+    switch (format) {
+        case TimestampFormat::Iso8601Micros: {
+            char buffer[27];
+            std::memcpy(buffer, cached_iso_prefix(seconds_total), 19);
+            buffer[19] = '.';
+            put_digits(buffer + 20, static_cast<std::uint64_t>(fractional), 6);
+            buffer[26] = 'Z';
+            out.append(buffer, sizeof(buffer));
+            break;
+        }
+        case TimestampFormat::Iso8601Seconds: {
+            char buffer[20];
+            std::memcpy(buffer, cached_iso_prefix(seconds_total), 19);
+            buffer[19] = 'Z';
+            out.append(buffer, sizeof(buffer));
+            break;
+        }
+        case TimestampFormat::CompactSeconds: {
+            const CivilTime civil = civil_from_seconds(seconds_total);
+            char buffer[16];
+            put_digits(buffer, static_cast<std::uint64_t>(civil.year), 4);
+            put_digits(buffer + 4, civil.month, 2);
+            put_digits(buffer + 6, civil.day, 2);
+            buffer[8] = 'T';
+            put_digits(buffer + 9, civil.hour, 2);
+            put_digits(buffer + 11, civil.minute, 2);
+            put_digits(buffer + 13, civil.second, 2);
+            buffer[15] = 'Z';
+            out.append(buffer, sizeof(buffer));
+            break;
+        }
+    }
+}
+
+std::string FormatTimestamp(std::chrono::system_clock::time_point tp, TimestampFormat format) {
+    std::string out;
+    AppendTimestamp(out, tp, format);
+    return out;
+}
+
+bool ParseTimestamp(std::string_view text, std::chrono::system_clock::time_point &tp) {
+    if (text.size() < 19 || text[4] != '-' || text[7] != '-' || text[10] != 'T' || text[13] != ':' ||
+        text[16] != ':') {
+        return false;
+    }
+    unsigned year = 0;
+    unsigned month = 0;
+    unsigned day = 0;
+    unsigned hour = 0;
+    unsigned minute = 0;
+    unsigned second = 0;
+    if (!read_fixed(text, 0, 4, year) || !read_fixed(text, 5, 2, month) || !read_fixed(text, 8, 2, day) ||
+        !read_fixed(text, 11, 2, hour) || !read_fixed(text, 14, 2, minute) || !read_fixed(text, 17, 2, second)) {
+        return false;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) {
+        return false;
+    }
+
+    std::int64_t micros = 0;
+    if (text.size() > 19 && text[19] == '.') {
+        int digits = 0;
+        for (std::size_t i = 20; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i) {
+            if (digits < 6) {
+                micros = micros * 10 + (text[i] - '0');
+                ++digits;
+            }
+        }
+        for (; digits < 6; ++digits) {
+            micros *= 10;
+        }
+    }
+
+    const std::int64_t seconds_total = days_from_civil(year, month, day) * kSecondsPerDay +
+                                       static_cast<std::int64_t>(hour) * 3600 +
+                                       static_cast<std::int64_t>(minute) * 60 + second;
+    tp = std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+        std::chrono::microseconds(seconds_total * kMicrosPerSecond + micros)));
+    return true;
+}
+
+}  // namespace wslmon
@@ -0,0 +1,187 @@
+#include "black_box.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "logger.hpp"
+
+namespace {
+wslmon::EventRecord make_record(std::uint64_t index) {
+    wslmon::EventRecord record{};
+    record.source = "black_box_test";
+    record.category = "Kmsg";
+    record.severity = wslmon::Severity::Error;
+    record.message = "event " + std::to_string(index);
+    record.attributes.push_back({"index", index});
+    record.timestamp = std::chrono::system_clock::now();
+    record.sequence = 0;
+    return record;
+}
+
+// Copies the ring as a killed process would leave it: the mapping is
+// shared, so the file already holds every Append.
+std::filesystem::path snapshot_killed(const std::filesystem::path &ring, const std::string &name) {
+    const auto copy = ring.parent_path() / name;
+    std::filesystem::copy_file(ring, copy, std::filesystem::copy_options::overwrite_existing);
+    return copy;
+}
+
+// Recovered messages must be "event N" for consecutive N ending at |last|.
+bool consecutive_tail(const std::vector<wslmon::EventRecord> &events, std::uint64_t last) {
+    if (events.empty()) {
+        return false;
+    }
+    std::uint64_t expected = last + 1 - events.size();
+    for (const auto &event : events) {
+        if (event.message != "event " + std::to_string(expected++)) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+int main() {
+    const auto dir = std::filesystem::temp_directory_path() / "wslmon_black_box_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const auto ring_path = dir / "ring.bin";
+    constexpr std::size_t kCapacity = 8192;
+
+    wslmon::BlackBoxRing ring;
+    if (!ring.Open(ring_path, kCapacity) || !ring.TakeRecovered().empty()) {
+        std::cerr << "Fresh ring failed to open or recovered events" << std::endl;
+        return 1;
+    }
+    for (std::uint64_t i = 0; i < 20; ++i) {
+        ring.Append(make_record(i));
+    }
+    const auto first_lap = snapshot_killed(ring_path, "first_lap.bin");
+    // Enough records to wrap the ring several times.
+    for (std::uint64_t i = 20; i < 1000; ++i) {
+        ring.Append(make_record(i));
+    }
+    const auto wrapped = snapshot_killed(ring_path, "wrapped.bin");
+    ring.Close();
+
+    wslmon::BlackBoxRing reader;
+    reader.Open(first_lap, kCapacity);
+    auto events = reader.TakeRecovered();
+    if (events.size() != 20 || !consecutive_tail(events, 19) || events.front().severity != wslmon::Severity::Error ||
+        events.front().attributes.size() != 1) {
+        std::cerr << "Recovered " << events.size() << " events from the first lap, expected 20" << std::endl;
+        return 1;
+    }
+    // Recovery empties the ring, so a second start finds nothing.
+    reader.Close();
+    reader.Open(first_lap, kCapacity);
+    if (!reader.TakeRecovered().empty()) {
+        std::cerr << "Recovered events were recovered again" << std::endl;
+        return 1;
+    }
+    reader.Close();
+
+    reader.Open(wrapped, kCapacity);
+    events = reader.TakeRecovered();
+    if (events.size() < 50 || !consecutive_tail(events, 999)) {
+        std::cerr << "Wrapped ring recovered " << events.size() << " events, not a consecutive tail" << std::endl;
+        return 1;
+    }
+    reader.Close();
+
+    // A clean Close leaves nothing to recover.
+    reader.Open(ring_path, kCapacity);
+    if (!reader.TakeRecovered().empty()) {
+        std::cerr << "Cleanly closed ring reported recovered events" << std::endl;
+        return 1;
+    }
+    reader.Close();
+
+    // Damage one record in the middle: only that record is lost.
+    {
+        wslmon::BlackBoxRing writer;
+        writer.Open(dir / "fresh.bin", kCapacity);
+        for (std::uint64_t i = 0; i < 30; ++i) {
+            writer.Append(make_record(i));
+        }
+        const auto killed = snapshot_killed(dir / "fresh.bin", "fresh_killed.bin");
+        std::fstream file(killed, std::ios::in | std::ios::out | std::ios::binary);
+        std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        const auto hit = contents.find("event 12");
+        file.seekp(static_cast<std::streamoff>(hit));
+        file.put('X');
+        file.close();
+        wslmon::BlackBoxRing survivor;
+        survivor.Open(killed, kCapacity);
+        events = survivor.TakeRecovered();
+        if (events.size() != 29 || events[11].message != "event 11" || events[12].message != "event 13") {
+            std::cerr << "Damaged record was not skipped cleanly: " << events.size() << " events" << std::endl;
+            return 1;
+        }
+    }
+
+    // Attached to a logger, the ring keeps only what the log never got:
+    // records the logger wrote are stamped and skipped by recovery.
+    {
+        wslmon::BlackBoxRing attached;
+        attached.Open(dir / "attached.bin", kCapacity);
+        wslmon::LogCommitPolicy policy;
+        policy.group_commit = true;
+        wslmon::JsonLogger logger(dir / "events.log", "black_box_test", policy);
+        logger.AttachBlackBox(&attached);
+        for (std::uint64_t i = 0; i < 30; ++i) {
+            logger.Append(make_record(i));
+        }
+        logger.Flush();
+        // Still queued in the logger when the process died.
+        for (std::uint64_t i = 30; i < 33; ++i) {
+            attached.Append(make_record(i));
+        }
+        const auto killed = snapshot_killed(dir / "attached.bin", "attached_killed.bin");
+        wslmon::BlackBoxRing survivor;
+        survivor.Open(killed, kCapacity);
+        events = survivor.TakeRecovered();
+        if (events.size() != 3 || !consecutive_tail(events, 32)) {
+            std::cerr << "Recovered " << events.size() << " events from an attached ring, expected the 3 unlogged"
+                      << std::endl;
+            return 1;
+        }
+        logger.AttachBlackBox(nullptr);
+    }
+
+    // A written line is stamped only once it has been synced: until then a
+    // VM kill can keep the ring page and lose the log page.
+    {
+        wslmon::BlackBoxRing attached;
+        attached.Open(dir / "unsynced.bin", kCapacity);
+        wslmon::JsonLogger logger(dir / "unsynced.log", "black_box_test");
+        logger.AttachBlackBox(&attached);
+        for (std::uint64_t i = 0; i < 5; ++i) {
+            logger.Append(make_record(i));
+        }
+        wslmon::BlackBoxRing before_sync;
+        before_sync.Open(snapshot_killed(dir / "unsynced.bin", "unsynced_killed.bin"), kCapacity);
+        events = before_sync.TakeRecovered();
+        if (events.size() != 5) {
+            std::cerr << "Recovered " << events.size() << " of 5 written but unsynced events" << std::endl;
+            return 1;
+        }
+        logger.Flush();
+        wslmon::BlackBoxRing after_sync;
+        after_sync.Open(snapshot_killed(dir / "unsynced.bin", "synced_killed.bin"), kCapacity);
+        if (!after_sync.TakeRecovered().empty()) {
+            std::cerr << "Synced events were recovered from the black box" << std::endl;
+            return 1;
+        }
+        logger.AttachBlackBox(nullptr);
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
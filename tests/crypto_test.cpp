@@ -0,0 +1,323 @@
+#include "crypto.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+struct HashVector {
+    std::string message;
+    const char *digest;
+};
+
+const char *multi_backend_name(wslmon::Sha256MultiBackend backend) {
+    switch (backend) {
+        case wslmon::Sha256MultiBackend::Auto:
+            return "auto";
+        case wslmon::Sha256MultiBackend::Single:
+            return "single";
+        case wslmon::Sha256MultiBackend::Sse2:
+            return "sse2";
+        case wslmon::Sha256MultiBackend::Avx2:
+            return "avx2";
+        case wslmon::Sha256MultiBackend::Avx512:
+            return "avx512";
+    }
+    return "?";
+}
+
+const char *backend_name(wslmon::Sha256Backend backend) {
+    switch (backend) {
+        case wslmon::Sha256Backend::Auto:
+            return "auto";
+        case wslmon::Sha256Backend::Scalar:
+            return "scalar";
+        case wslmon::Sha256Backend::Avx2:
+            return "avx2";
+        case wslmon::Sha256Backend::ShaNi:
+            return "sha-ni";
+        case wslmon::Sha256Backend::ArmV8:
+            return "armv8";
+    }
+    return "?";
+}
+
+std::string hash_hex(const std::string &message, wslmon::Sha256Backend backend) {
+    const auto digest =
+        wslmon::Sha256(reinterpret_cast<const std::uint8_t *>(message.data()), message.size(), backend);
+    return wslmon::BytesToHex(digest.data(), digest.size());
+}
+}  // namespace
+
+int main() {
+    using wslmon::Sha256Backend;
+
+    // FIPS 180-4 example vectors plus the NIST long-message case.
+    const std::vector<HashVector> vectors = {
+        {"", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+        {"abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+        {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+         "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"},
+        {"abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrst"
+         "nopqrstu",
+         "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1"},
+        {std::string(1000000, 'a'), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"},
+    };
+
+    const Sha256Backend backends[] = {Sha256Backend::Auto, Sha256Backend::Scalar, Sha256Backend::Avx2,
+                                      Sha256Backend::ShaNi, Sha256Backend::ArmV8};
+    for (Sha256Backend backend : backends) {
+        if (!wslmon::Sha256BackendSupported(backend)) {
+            std::cout << "skipping unsupported backend " << backend_name(backend) << "\n";
+            continue;
+        }
+        for (const auto &vector : vectors) {
+            if (hash_hex(vector.message, backend) != vector.digest) {
+                std::cerr << "SHA-256 vector mismatch for backend " << backend_name(backend) << " on "
+                          << vector.message.size() << "-byte message\n";
+                return 1;
+            }
+        }
+    }
+
+    // Every backend must agree with the scalar code across block boundaries.
+    std::mt19937 rng(1234);
+    for (std::size_t length = 0; length < 300; ++length) {
+        std::string message(length, '\0');
+        for (auto &c : message) {
+            c = static_cast<char>(rng());
+        }
+        const std::string expected = hash_hex(message, Sha256Backend::Scalar);
+        for (Sha256Backend backend : backends) {
+            if (wslmon::Sha256BackendSupported(backend) && hash_hex(message, backend) != expected) {
+                std::cerr << "Backend " << backend_name(backend) << " differs from scalar at length " << length
+                          << "\n";
+                return 1;
+            }
+        }
+    }
+
+    // RFC 4231 test cases 1 and 6 (short key, key longer than a block).
+    const std::string data1 = "Hi There";
+    const auto mac1 = wslmon::HmacSha256(std::vector<std::uint8_t>(20, 0x0b),
+                                         reinterpret_cast<const std::uint8_t *>(data1.data()), data1.size());
+    const std::string data6 = "Test Using Larger Than Block-Size Key - Hash Key First";
+    const auto mac6 = wslmon::HmacSha256(std::vector<std::uint8_t>(131, 0xaa),
+                                         reinterpret_cast<const std::uint8_t *>(data6.data()), data6.size());
+    if (wslmon::BytesToHex(mac1.data(), mac1.size()) !=
+            "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7" ||
+        wslmon::BytesToHex(mac6.data(), mac6.size()) !=
+            "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54") {
+        std::cerr << "HMAC-SHA256 vector mismatch\n";
+        return 1;
+    }
+    const wslmon::HmacKey prepared6(std::vector<std::uint8_t>(131, 0xaa));
+    const auto keyed6 =
+        wslmon::HmacSha256(prepared6, reinterpret_cast<const std::uint8_t *>(data6.data()), data6.size());
+    if (!std::equal(keyed6.begin(), keyed6.end(), mac6.begin(), mac6.end())) {
+        std::cerr << "HmacKey result differs from raw-key HMAC\n";
+        return 1;
+    }
+
+    // Streaming contexts must match the one-shot functions whatever the
+    // split points.
+    const std::vector<std::uint8_t> key(37, 0x5a);
+    for (std::size_t length = 0; length < 300; length += 7) {
+        std::string message(length, '\0');
+        for (auto &c : message) {
+            c = static_cast<char>(rng());
+        }
+        wslmon::Sha256Context hash;
+        wslmon::HmacSha256Context mac(key);
+        std::size_t offset = 0;
+        while (offset < message.size()) {
+            const std::size_t piece = std::min<std::size_t>(rng() % 70, message.size() - offset);
+            hash.Update(std::string_view(message).substr(offset, piece));
+            mac.Update(std::string_view(message).substr(offset, piece));
+            offset += piece;
+        }
+        const auto digest = hash.Final();
+        const auto tag = mac.Final();
+        const auto expected_tag =
+            wslmon::HmacSha256(key, reinterpret_cast<const std::uint8_t *>(message.data()), message.size());
+        if (wslmon::BytesToHex(digest.data(), digest.size()) != hash_hex(message, Sha256Backend::Scalar) ||
+            !std::equal(tag.begin(), tag.end(), expected_tag.begin(), expected_tag.end())) {
+            std::cerr << "Streaming context differs from one-shot result at length " << length << "\n";
+            return 1;
+        }
+    }
+
+    // Multi-buffer engines: mixed lengths make lanes finish at different
+    // blocks and pick up queued messages mid-batch.
+    std::vector<std::string> batch(300);
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        batch[i].resize((i * 37) % 530);
+        for (auto &c : batch[i]) {
+            c = static_cast<char>(rng());
+        }
+    }
+    const std::vector<std::string_view> batch_views(batch.begin(), batch.end());
+    const wslmon::HmacKey batch_key(key);
+    for (auto backend : {wslmon::Sha256MultiBackend::Auto, wslmon::Sha256MultiBackend::Single,
+                         wslmon::Sha256MultiBackend::Sse2, wslmon::Sha256MultiBackend::Avx2,
+                         wslmon::Sha256MultiBackend::Avx512}) {
+        if (!wslmon::Sha256MultiBackendSupported(backend)) {
+            std::cout << "skipping unsupported multi-buffer backend " << multi_backend_name(backend) << "\n";
+            continue;
+        }
+        for (std::size_t count : {std::size_t{1}, std::size_t{5}, batch_views.size()}) {
+            std::vector<std::array<std::uint8_t, 32>> digests(count);
+            std::vector<std::array<std::uint8_t, 32>> macs(count);
+            wslmon::Sha256Many(batch_views.data(), count, digests.data(), backend);
+            wslmon::HmacSha256Many(batch_key, batch_views.data(), count, macs.data(), backend);
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto *bytes = reinterpret_cast<const std::uint8_t *>(batch[i].data());
+                if (digests[i] != wslmon::Sha256(bytes, batch[i].size()) ||
+                    macs[i] != wslmon::HmacSha256(batch_key, bytes, batch[i].size())) {
+                    std::cerr << "Multi-buffer backend " << multi_backend_name(backend) << " differs on message "
+                              << i << " of " << count << "\n";
+                    return 1;
+                }
+            }
+        }
+    }
+
+    // Bulk verification of a segment written by JsonLogger, then with one
+    // record tampered with.
+    const auto log_dir = std::filesystem::temp_directory_path() / "wslmon_crypto_test";
+    std::filesystem::remove_all(log_dir);
+    const std::string log_key_hex = wslmon::BytesToHex(key.data(), key.size());
+#ifdef _WIN32
+    _putenv_s("WSLMON_LOG_HMAC_KEY", log_key_hex.c_str());
+#else
+    setenv("WSLMON_LOG_HMAC_KEY", log_key_hex.c_str(), 1);
+#endif
+    {
+        wslmon::JsonLogger logger(log_dir / "events.log", "crypto_test");
+        for (int i = 0; i < 40; ++i) {
+            wslmon::EventRecord record{};
+            record.message = "record " + std::to_string(i);
+            record.attributes.push_back({"index", i});
+            logger.Append(record);
+        }
+    }
+    std::ifstream log_in(log_dir / "events.log", std::ios::binary);
+    std::string log_text((std::istreambuf_iterator<char>(log_in)), std::istreambuf_iterator<char>());
+    auto report = wslmon::VerifyRecordHmacs(log_text, batch_key);
+    if (report.records != 40 || !report.ok()) {
+        std::cerr << "VerifyRecordHmacs rejected an untouched log\n";
+        return 1;
+    }
+    const auto tampered = log_text.find("record 17");
+    log_text[tampered + 7] = '8';
+    report = wslmon::VerifyRecordHmacs(log_text, batch_key);
+    if (report.failed_lines != std::vector<std::size_t>{17}) {
+        std::cerr << "VerifyRecordHmacs missed a tampered record\n";
+        return 1;
+    }
+    const auto chain_report = wslmon::VerifyChain(log_text, wslmon::ChainHashAlgorithm::Sha256);
+    if (chain_report.records != 40 || chain_report.first_broken_line != std::optional<std::size_t>{17}) {
+        std::cerr << "VerifyChain did not locate the tampered record\n";
+        return 1;
+    }
+    std::filesystem::remove_all(log_dir);
+
+    // BLAKE3 reference vectors (input bytes i % 251) across chunk and
+    // subtree boundaries, which also exercise every chunk-lane width.
+    const std::vector<std::pair<std::size_t, const char *>> blake3_vectors = {
+        {0, "af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262"},
+        {1, "2d3adedff11b61f14c886e35afa036736dcd87a74d27b5c1510225d0f592e213"},
+        {64, "4eed7141ea4a5cd4b788606bd23f46e212af9cacebacdc7d1f4c6dc7f2511b98"},
+        {65, "de1e5fa0be70df6d2be8fffd0e99ceaa8eb6e8c93a63f2d8d1c30ecb6b263dee"},
+        {1024, "42214739f095a406f3fc83deb889744ac00df831c10daa55189b5d121c855af7"},
+        {1025, "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444"},
+        {3073, "7124b49501012f81cc7f11ca069ec9226cecb8a2c850cfe644e327d22d3e1cd3"},
+        {5120, "9cadc15fed8b5d854562b26a9536d9707cadeda9b143978f319ab34230535833"},
+        {8193, "bab6c09cb8ce8cf459261398d2e7aef35700bf488116ceb94a36d0f5f1b7bc3b"},
+        {31744, "62b6960e1a44bcc1eb1a611a8d6235b6b4b78f32e7abc4fb4c6cdcce94895c47"},
+        {102400, "bc3e3d41a1146b069abffad3c0d44860cf664390afce4d9661f7902e7943e085"},
+    };
+    for (auto backend : {wslmon::Blake3Backend::Auto, wslmon::Blake3Backend::Portable, wslmon::Blake3Backend::Sse41,
+                         wslmon::Blake3Backend::Avx2, wslmon::Blake3Backend::Avx512}) {
+        if (!wslmon::Blake3BackendSupported(backend)) {
+            continue;
+        }
+        for (const auto &[length, digest] : blake3_vectors) {
+            std::vector<std::uint8_t> input(length);
+            for (std::size_t i = 0; i < length; ++i) {
+                input[i] = static_cast<std::uint8_t>(i % 251);
+            }
+            // Feed in uneven pieces so buffered and direct paths mix.
+            wslmon::Blake3Context context(backend);
+            std::size_t offset = 0;
+            while (offset < length) {
+                const std::size_t piece = std::min<std::size_t>(1 + rng() % 9000, length - offset);
+                context.Update(input.data() + offset, piece);
+                offset += piece;
+            }
+            const auto result = context.Final();
+            if (wslmon::BytesToHex(result.data(), result.size()) != digest) {
+                std::cerr << "BLAKE3 vector mismatch at length " << length << "\n";
+                return 1;
+            }
+        }
+    }
+
+    // A BLAKE3-chained segment declares the algorithm in its manifest and
+    // verifies against the final hash recorded there.
+#ifdef _WIN32
+    _putenv_s("WSLMON_LOG_CHAIN_HASH", "blake3");
+#else
+    setenv("WSLMON_LOG_CHAIN_HASH", "blake3", 1);
+#endif
+    std::string final_hash;
+    {
+        wslmon::JsonLogger logger(log_dir / "events.log", "crypto_test");
+        for (int i = 0; i < 10; ++i) {
+            wslmon::EventRecord record{};
+            record.message = "blake3 record " + std::to_string(i);
+            logger.Append(record);
+        }
+        if (logger.CurrentChainHashAlgorithm() != wslmon::ChainHashAlgorithm::Blake3) {
+            std::cerr << "WSLMON_LOG_CHAIN_HASH was ignored\n";
+            return 1;
+        }
+        final_hash = logger.CurrentChainHash();
+        logger.Rotate();
+    }
+    std::string manifest_text;
+    std::string segment_text;
+    for (const auto &entry : std::filesystem::directory_iterator(log_dir)) {
+        std::ifstream in(entry.path(), std::ios::binary);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (entry.path().extension() == ".manifest") {
+            manifest_text = std::move(content);
+        } else if (entry.path().filename().string().rfind("events.log.", 0) == 0 &&
+                   entry.path().extension() != ".chainstate") {
+            segment_text = std::move(content);
+        }
+    }
+    wslmon::ChainHashAlgorithm declared = wslmon::ChainHashAlgorithm::Sha256;
+    const auto blake3_report = wslmon::VerifyChain(segment_text, wslmon::ChainHashAlgorithm::Blake3);
+    if (!wslmon::ReadManifestChainHashAlgorithm(manifest_text, declared) ||
+        declared != wslmon::ChainHashAlgorithm::Blake3 || blake3_report.records != 10 || !blake3_report.ok() ||
+        blake3_report.final_chain_hash != final_hash ||
+        manifest_text.find(final_hash) == std::string::npos) {
+        std::cerr << "BLAKE3 chain segment failed verification\n";
+        return 1;
+    }
+    std::filesystem::remove_all(log_dir);
+    return 0;
+}
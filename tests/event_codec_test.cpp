@@ -0,0 +1,194 @@
+#include "event_codec.hpp"
+#include "ipc.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <iostream>
+
+namespace {
+wslmon::EventRecord make_record() {
+    using namespace std::chrono;
+    wslmon::EventRecord record;
+    record.source = "kernel.kmsg";
+    record.category = "Kernel";
+    record.severity = wslmon::Severity::Critical;
+    record.message = "BUG: unable to handle \"page fault\"\n\tat 0x0\x01";
+    record.attributes.push_back({"boot_id", "5b1a8d0c3f2e4e5c9a3b7d6e1f0a2b3c"});
+    record.attributes.push_back({"hostname", "wsl-guest"});
+    record.attributes.push_back({"empty", ""});
+    record.attributes.push_back({"long", std::string(300, 'x')});
+    record.timestamp = system_clock::time_point(microseconds(1700000000123456LL));
+    record.sequence = 300;
+    return record;
+}
+}  // namespace
+
+int main() {
+    using namespace wslmon;
+
+    const EventRecord original = make_record();
+    const std::string json = SerializeEvent(original);
+
+    std::string encoded;
+    EncodeEventBinary(original, encoded);
+    if (encoded.size() >= json.size()) {
+        std::cerr << "Binary encoding is not smaller than JSON\n";
+        return 1;
+    }
+
+    EventRecordView view;
+    if (!DecodeEventBinary(encoded, view)) {
+        std::cerr << "Failed to decode binary record\n";
+        return 1;
+    }
+    if (view.source != "kernel.kmsg" || view.attribute_count() != 4 || view.sequence != 300) {
+        std::cerr << "Decoded view fields incorrect\n";
+        return 1;
+    }
+    const char *base = encoded.data();
+    if (view.message.data() < base || view.message.data() >= base + encoded.size()) {
+        std::cerr << "View does not reference the encoded buffer\n";
+        return 1;
+    }
+    std::size_t visited = 0;
+    for (const auto &attr : view) {
+        if (attr.key != original.attributes[visited].key || attr.value != original.attributes[visited].value) {
+            std::cerr << "Attribute table mismatch\n";
+            return 1;
+        }
+        ++visited;
+    }
+    if (visited != original.attributes.size()) {
+        std::cerr << "Attribute iteration incomplete\n";
+        return 1;
+    }
+
+    EventRecord decoded;
+    if (!DecodeEventBinary(encoded, decoded) || SerializeEvent(decoded) != json) {
+        std::cerr << "Binary round trip does not match SerializeEvent\n";
+        return 1;
+    }
+
+    EventRecord from_json;
+    if (!DeserializeEvent(json, from_json)) {
+        std::cerr << "DeserializeEvent failed\n";
+        return 1;
+    }
+    std::string reencoded;
+    EncodeEventBinary(from_json, reencoded);
+    if (!DecodeEventBinary(reencoded, decoded) || SerializeEvent(decoded) != json) {
+        std::cerr << "JSON -> binary -> JSON round trip mismatch\n";
+        return 1;
+    }
+
+    // Typed numbers serialize exactly as the std::to_string text they replace,
+    // and decoded text reads back as the same number.
+    EventRecord typed = original;
+    typed.attributes.push_back({"pid", 4242});
+    typed.attributes.push_back({"delta", -17});
+    typed.attributes.push_back({"rx_bytes", std::uint64_t{18446744073709551615ULL}});
+    typed.attributes.push_back({"cpu", 37.125});
+    const std::string typed_json = SerializeEvent(typed);
+    EventRecord textual = typed;
+    for (auto &attr : textual.attributes) {
+        if (attr.value.type() == AttributeType::Int64) {
+            attr.value = std::to_string(*attr.value.as_int64());
+        } else if (attr.value.type() == AttributeType::UInt64) {
+            attr.value = std::to_string(*attr.value.as_uint64());
+        } else if (attr.value.type() == AttributeType::Double) {
+            attr.value = std::to_string(*attr.value.as_double());
+        }
+    }
+    std::string typed_encoded;
+    EncodeEventBinary(typed, typed_encoded);
+    if (SerializeEvent(textual) != typed_json || !DecodeEventBinary(typed_encoded, decoded) ||
+        SerializeEvent(decoded) != typed_json) {
+        std::cerr << "Typed attributes changed the JSON encoding\n";
+        return 1;
+    }
+    for (double sample : {0.0, -0.5, 1e-7, 0.0000005, 99.9999995, 1234567.25, -1e300}) {
+        if (AttributeValue(sample).str() != std::to_string(sample)) {
+            std::cerr << "Double formatting differs from std::to_string for " << sample << "\n";
+            return 1;
+        }
+    }
+    std::uint64_t pid = 0;
+    if (!DeserializeEvent(typed_json, decoded)) {
+        std::cerr << "DeserializeEvent failed on typed record\n";
+        return 1;
+    }
+    for (const auto &attr : decoded.attributes) {
+        if (attr.key == "pid" && attr.value.as_uint64()) {
+            pid = *attr.value.as_uint64();
+        }
+    }
+    if (pid != 4242 || AttributeValue("oops").as_uint64() || AttributeValue("-3").as_uint64() ||
+        AttributeValue("4.000000").as_uint64() != std::uint64_t{4}) {
+        std::cerr << "Numeric attribute parsing incorrect\n";
+        return 1;
+    }
+
+    for (std::size_t length = 0; length < encoded.size(); ++length) {
+        if (DecodeEventBinary(std::string_view(encoded.data(), length), view)) {
+            std::cerr << "Truncated record decoded at length " << length << "\n";
+            return 1;
+        }
+    }
+
+    // Binary frames travel through the authenticated IPC framing unchanged.
+    const HmacKey session(std::vector<std::uint8_t>(32, 0x5A));
+    std::string wire;
+    auto write_fn = [&wire](const std::uint8_t *buffer, std::size_t bytes) {
+        wire.append(reinterpret_cast<const char *>(buffer), bytes);
+        return true;
+    };
+    std::size_t offset = 0;
+    auto read_fn = [&wire, &offset](std::uint8_t *buffer, std::size_t bytes) {
+        if (wire.size() - offset < bytes) {
+            return false;
+        }
+        std::memcpy(buffer, wire.data() + offset, bytes);
+        offset += bytes;
+        return true;
+    };
+    if (!IpcSendEvent(write_fn, session, original, IpcPayloadEncoding::Binary) ||
+        !IpcSendEvent(write_fn, session, original, IpcPayloadEncoding::Json)) {
+        std::cerr << "IpcSendEvent failed\n";
+        return 1;
+    }
+    for (int i = 0; i < 2; ++i) {
+        EventRecord received;
+        if (!IpcReceiveEvent(read_fn, session, received) || SerializeEvent(received) != json) {
+            std::cerr << "IPC frame round trip mismatch\n";
+            return 1;
+        }
+    }
+
+    // The frame type is authenticated: a binary frame relabelled as JSON
+    // (or the reverse) fails its MAC.
+    wire.clear();
+    offset = 0;
+    if (!IpcSendEvent(write_fn, session, original, IpcPayloadEncoding::Json)) {
+        std::cerr << "IpcSendEvent failed\n";
+        return 1;
+    }
+    wire[5] = static_cast<char>(IpcPayloadEncoding::Binary);
+    EventRecord retyped;
+    if (IpcReceiveEvent(read_fn, session, retyped)) {
+        std::cerr << "Re-typed IPC frame was accepted\n";
+        return 1;
+    }
+
+    // A peer speaking an older protocol version is refused at the handshake.
+    wire.assign("WSLH\x01\0\0\0", 8);
+    wire.append(32, '\x11');
+    offset = 0;
+    HmacKey client_session;
+    if (IpcClientHandshake(write_fn, read_fn, std::vector<std::uint8_t>(32, 0x22), client_session)) {
+        std::cerr << "Handshake with a version 1 server succeeded\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include "event.hpp"
+#include "event_view.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+namespace {
+constexpr const char *kTimestamp = "\"timestamp\":\"2023-11-14T22:13:20.000001Z\"";
+
+// Decodes |json| with DeserializeEvent and with ParseEventView, and checks
+// that both accept it and agree on every field.
+bool decode_both(const std::string &json, wslmon::EventRecord &record) {
+    if (!wslmon::DeserializeEvent(json, record)) {
+        std::cerr << "DeserializeEvent rejected " << json << "\n";
+        return false;
+    }
+    wslmon::EventArena arena;
+    wslmon::EventView view;
+    if (!wslmon::ParseEventView(json, arena, view)) {
+        std::cerr << "ParseEventView rejected " << json << "\n";
+        return false;
+    }
+    wslmon::EventRecord materialized;
+    wslmon::MaterializeEvent(view, materialized);
+    if (wslmon::SerializeEvent(materialized) != wslmon::SerializeEvent(record)) {
+        std::cerr << "Record and view decoders disagree on " << json << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool rejected_by_both(const std::string &json) {
+    wslmon::EventRecord record;
+    wslmon::EventArena arena;
+    wslmon::EventView view;
+    if (wslmon::DeserializeEvent(json, record) || wslmon::ParseEventView(json, arena, view)) {
+        std::cerr << "Malformed record was accepted: " << json << "\n";
+        return false;
+    }
+    return true;
+}
+
+const wslmon::EventAttribute *find_attribute(const wslmon::EventRecord &record, const char *key) {
+    for (const auto &attribute : record.attributes) {
+        if (attribute.key == key) {
+            return &attribute;
+        }
+    }
+    return nullptr;
+}
+}  // namespace
+
+int main() {
+    using wslmon::EventRecord;
+    using wslmon::Severity;
+
+    // Key names inside other values are data, not fields.
+    {
+        EventRecord record;
+        const std::string json = std::string("{\"message\":\"\\\"severity\\\":\\\"Critical\\\",\\\"sequence\\\":7\",") +
+                                 kTimestamp +
+                                 ",\"attributes\":[{\"key\":\"note\",\"value\":\"\\\"source\\\":\\\"forged\\\"\"}],"
+                                 "\"source\":\"real\",\"severity\":\"Info\",\"sequence\":3}";
+        if (!decode_both(json, record) || record.severity != Severity::Info || record.sequence != 3 ||
+            record.source != "real" || record.message != "\"severity\":\"Critical\",\"sequence\":7" ||
+            record.attributes.size() != 1 || record.attributes[0].value.text() != "\"source\":\"forged\"") {
+            std::cerr << "A key name inside a value was decoded as a field\n";
+            return 1;
+        }
+    }
+
+    // Escapes are unescaped in every string field.
+    {
+        EventRecord record;
+        const std::string json = std::string("{") + kTimestamp +
+                                 ",\"source\":\"a\\\\b\",\"message\":\"q\\\"t\\nn\\tt\\u0041\\u00e9\\u20ac\","
+                                 "\"attributes\":[{\"key\":\"k\\\"ey\",\"value\":\"v\\\\al\\\"ue\"}]}";
+        if (!decode_both(json, record) || record.source != "a\\b" ||
+            record.message != "q\"t\nn\ttA\xC3\xA9\xE2\x82\xAC" || record.attributes.size() != 1 ||
+            record.attributes[0].key != "k\"ey" || record.attributes[0].value.text() != "v\\al\"ue") {
+            std::cerr << "Escaped strings were decoded wrongly\n";
+            return 1;
+        }
+    }
+
+    // Whitespace around every token, as a pretty-printer would write it.
+    {
+        EventRecord record;
+        const std::string json =
+            "{\n  \"timestamp\" : \"2023-11-14T22:13:20.000001Z\" ,\n  \"sequence\"\t:\t42 ,\n"
+            "  \"source\": \"ws\",\r\n  \"attributes\" : [ { \"key\" : \"k\" , \"value\" : \"v\" } , "
+            "{ \"key\" : \"k2\" , \"value\" : \"v2\" } ] ,\n  \"message\" : \"spaced\"\n}\n";
+        if (!decode_both(json, record) || record.sequence != 42 || record.source != "ws" ||
+            record.message != "spaced" || record.attributes.size() != 2 || !find_attribute(record, "k2")) {
+            std::cerr << "Whitespace between tokens broke decoding\n";
+            return 1;
+        }
+    }
+
+    // Unknown fields of every JSON type are skipped, whatever they contain.
+    {
+        EventRecord record;
+        const std::string json =
+            std::string("{\"extra\":\"}],{\\\"message\\\":\\\"fake\\\"\",\"count\":-12.5e3,\"flag\":true,") +
+            "\"none\":null,\"nested\":{\"message\":\"fake\",\"list\":[1,{\"a\":[]},\"]\"],\"empty\":{}}," + kTimestamp +
+            ",\"list\":[[],[\"x\"]],\"message\":\"real\",\"sequence\":9}";
+        if (!decode_both(json, record) || record.message != "real" || record.sequence != 9) {
+            std::cerr << "Unknown fields were not skipped cleanly\n";
+            return 1;
+        }
+    }
+
+    // A sequence outside uint64 is dropped, and the fields after it still
+    // decode.
+    {
+        EventRecord record;
+        const std::string max = std::string("{") + kTimestamp + ",\"sequence\":18446744073709551615,\"message\":\"m\"}";
+        if (!decode_both(max, record) || record.sequence != 18446744073709551615ULL || record.message != "m") {
+            std::cerr << "Largest uint64 sequence did not decode\n";
+            return 1;
+        }
+        for (const char *sequence : {"18446744073709551616", "99999999999999999999999", "-5", "1.5", "2e3"}) {
+            record.sequence = 1;
+            const std::string json = std::string("{") + kTimestamp + ",\"sequence\":" + sequence +
+                                     ",\"message\":\"after\",\"source\":\"s\"}";
+            if (!decode_both(json, record) || record.sequence != 0 || record.message != "after" ||
+                record.source != "s") {
+                std::cerr << "Sequence " << sequence << " was not skipped cleanly\n";
+                return 1;
+            }
+        }
+    }
+
+    if (!rejected_by_both("") || !rejected_by_both("{\"message\":\"no timestamp\"}") ||
+        !rejected_by_both(std::string("{") + kTimestamp + ",\"message\":\"unterminated}") ||
+        !rejected_by_both(std::string("{") + kTimestamp + ",\"message\" \"missing colon\"}") ||
+        !rejected_by_both(std::string("{") + kTimestamp + ",\"nested\":{\"a\":1}") ||
+        !rejected_by_both(std::string("{") + kTimestamp + ",\"sequence\":}")) {
+        return 1;
+    }
+    return 0;
+}
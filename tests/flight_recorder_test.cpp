@@ -0,0 +1,96 @@
+#include "flight_recorder.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+namespace {
+wslmon::EventRecord make_record(std::uint64_t sequence, std::size_t message_size) {
+    wslmon::EventRecord record{};
+    record.message = std::string(message_size, 'm');
+    record.sequence = sequence;
+    return record;
+}
+}  // namespace
+
+int main() {
+    using namespace std::chrono_literals;
+    const auto start = wslmon::FlightRecorder::Clock::now();
+
+    // Short messages live in the small-string buffer; long ones are charged
+    // for their heap storage.
+    const auto small = wslmon::EventFootprint(make_record(0, 4));
+    const auto large = wslmon::EventFootprint(make_record(0, 4000));
+    if (small != sizeof(wslmon::EventRecord) || large < small + 4000) {
+        std::cerr << "Unexpected footprints " << small << " and " << large << std::endl;
+        return 1;
+    }
+
+    wslmon::FlightRecorderLimits limits;
+    limits.horizon = 120s;
+    limits.max_bytes = 1 << 30;
+    wslmon::FlightRecorder by_time(limits);
+    for (std::uint64_t i = 0; i < 300; ++i) {
+        by_time.Push(make_record(i, 16), start + std::chrono::seconds(i));
+    }
+    // Arrivals at 179..299 s are within 120 s of the last push.
+    auto kept = by_time.Snapshot(start + 299s);
+    if (by_time.size() != 121 || kept.size() != 121 || kept.front().sequence != 179 || kept.back().sequence != 299) {
+        std::cerr << "Horizon kept " << by_time.size() << " records" << std::endl;
+        return 1;
+    }
+    // A later read ignores records that have aged out since the last push.
+    if (by_time.Snapshot(start + 400s).size() != 20) {
+        std::cerr << "Snapshot returned records older than the horizon" << std::endl;
+        return 1;
+    }
+
+    // Give routine records the whole budget to check byte accounting alone.
+    limits.max_bytes = 10 * large;
+    limits.budget_shares = {1, 0, 0};
+    wslmon::FlightRecorder by_bytes(limits);
+    for (std::uint64_t i = 0; i < 100; ++i) {
+        by_bytes.Push(make_record(i, 4000), start);
+    }
+    if (by_bytes.size() != 10 || by_bytes.bytes() != 10 * large ||
+        by_bytes.Snapshot(start).front().sequence != 90) {
+        std::cerr << "Byte budget kept " << by_bytes.size() << " records, " << by_bytes.bytes() << " bytes"
+                  << std::endl;
+        return 1;
+    }
+    // The same budget holds far more small records.
+    for (std::uint64_t i = 100; i < 1100; ++i) {
+        by_bytes.Push(make_record(i, 4), start);
+    }
+    if (by_bytes.size() != limits.max_bytes / small || by_bytes.bytes() > limits.max_bytes) {
+        std::cerr << "Small records were not packed into the budget" << std::endl;
+        return 1;
+    }
+
+    // With the default shares, an Info flood evicts only Info records.
+    limits.max_bytes = 100 * small;
+    limits.budget_shares = wslmon::FlightRecorderLimits{}.budget_shares;
+    wslmon::FlightRecorder partitioned(limits);
+    auto critical = make_record(0, 4);
+    critical.severity = wslmon::Severity::Critical;
+    partitioned.Push(critical, start);
+    for (std::uint64_t i = 1; i <= 10000; ++i) {
+        auto info = make_record(i, 4);
+        info.severity = wslmon::Severity::Info;
+        partitioned.Push(info, start);
+    }
+    auto warning = make_record(10001, 4);
+    warning.severity = wslmon::Severity::Warning;
+    partitioned.Push(warning, start);
+    const auto merged = partitioned.Snapshot(start);
+    const auto usage = partitioned.usage();
+    const auto routine = usage[static_cast<std::size_t>(wslmon::EventPriority::Routine)];
+    if (merged.size() != routine.entries + 2 || merged.front().sequence != 0 || merged.back().sequence != 10001 ||
+        merged[1].sequence != 10001 - routine.entries || routine.bytes > routine.budget ||
+        usage[static_cast<std::size_t>(wslmon::EventPriority::Urgent)].entries != 1) {
+        std::cerr << "Info flood evicted across partitions or broke arrival order" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -2,6 +2,11 @@
 
 #include <chrono>
 #include <iostream>
+#include <string>
+#include <vector>
+
+#include "event_batch.hpp"
+#include "event_view.hpp"
 
 namespace {
 void add_attribute(wslmon::EventRecord &record, const std::string &key, const std::string &value) {
@@ -18,7 +23,7 @@ int main() {
 
     EventRecord service_event;
     service_event.category = "ServiceHealth";
-    service_event.severity = "Warning";
+    service_event.severity = Severity::Warning;
     service_event.timestamp = now - minutes(2);
     add_attribute(service_event, "state", "RestartPending");
     add_attribute(service_event, "restartCount", "4");
@@ -26,7 +31,7 @@ int main() {
 
     EventRecord security_event;
     security_event.category = "Security";
-    security_event.severity = "Warning";
+    security_event.severity = Severity::Warning;
     security_event.timestamp = now - minutes(1);
     add_attribute(security_event, "name", "Contoso Endpoint Shield");
     add_attribute(security_event, "stateText", "Disabled|Outdated");
@@ -34,7 +39,7 @@ int main() {
 
     EventRecord memory_event;
     memory_event.category = "Process";
-    memory_event.severity = "Warning";
+    memory_event.severity = Severity::Warning;
     memory_event.timestamp = now - minutes(1);
     memory_event.message = "Tracked process memory pressure";
     add_attribute(memory_event, "name", "vmmem");
@@ -42,7 +47,7 @@ int main() {
 
     EventRecord kernel_event;
     kernel_event.category = "Kernel";
-    kernel_event.severity = "Error";
+    kernel_event.severity = Severity::Error;
     kernel_event.timestamp = now - minutes(1);
     kernel_event.message = "kernel panic: fatal fault";
     events.push_back({"guest", kernel_event, "hash4"});
@@ -70,6 +75,52 @@ int main() {
         return 1;
     }
 
+    // The view-based overloads must agree with the record-based ones.
+    EventArena arena;
+    std::vector<TimelineEventView> views;
+    for (const auto &event : events) {
+        TimelineEventView view;
+        view.origin = event.origin;
+        view.chain_hash = arena.Store(event.chain_hash);
+        if (!ParseEventView(arena.Store(SerializeEvent(event.record)), arena, view.event)) {
+            std::cerr << "Failed to parse event view\n";
+            return 1;
+        }
+        views.push_back(view);
+    }
+    EventBatch batch;
+    for (const auto &event : events) {
+        batch.Append(event.origin, event.record);
+    }
+    const std::vector<HeuristicInsight> alternatives[] = {AnalyzeEventTimeline(views), AnalyzeEventTimeline(batch)};
+    for (const auto &other : alternatives) {
+        if (other.size() != insights.size()) {
+            std::cerr << "View/batch insight count differs\n";
+            return 1;
+        }
+        for (std::size_t i = 0; i < insights.size(); ++i) {
+            if (other[i].id != insights[i].id || other[i].confidence != insights[i].confidence ||
+                other[i].supporting_events.size() != insights[i].supporting_events.size()) {
+                std::cerr << "View/batch insight mismatch for " << insights[i].id << "\n";
+                return 1;
+            }
+            for (std::size_t j = 0; j < insights[i].supporting_events.size(); ++j) {
+                if (SerializeEvent(other[i].supporting_events[j].record) !=
+                    SerializeEvent(insights[i].supporting_events[j].record)) {
+                    std::cerr << "View/batch supporting event mismatch\n";
+                    return 1;
+                }
+            }
+        }
+    }
+    for (const auto &other : {ComputeCrossChannelSnapshot(views), ComputeCrossChannelSnapshot(batch)}) {
+        if (other.host.total != 2 || other.guest.total != 2 || other.host.warning != 2 ||
+            floor<microseconds>(other.guest.first_timestamp) != floor<microseconds>(now - minutes(1))) {
+            std::cerr << "View/batch snapshot incorrect\n";
+            return 1;
+        }
+    }
+
     auto snapshot = ComputeCrossChannelSnapshot(events);
     if (snapshot.host.total != 2 || snapshot.guest.total != 2) {
         std::cerr << "Cross-channel totals incorrect\n";
@@ -0,0 +1,129 @@
+#include "json_escape.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+// The byte-at-a-time escaper that event.cpp used before the vectorised
+// scanners; every scanner must produce exactly the same output.
+std::string reference_escape(const std::string &input) {
+    static const char *kHex = "0123456789ABCDEF";
+    std::string out;
+    for (char c : input) {
+        switch (c) {
+            case '\\':
+                out += "\\\\";
+                break;
+            case '"':
+                out += "\\\"";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    const auto code = static_cast<unsigned char>(c);
+                    out += "\\u00";
+                    out.push_back(kHex[code >> 4]);
+                    out.push_back(kHex[code & 0x0F]);
+                } else {
+                    out.push_back(c);
+                }
+                break;
+        }
+    }
+    return out;
+}
+
+std::size_t reference_find(const std::string &input, std::size_t from) {
+    for (std::size_t i = from; i < input.size(); ++i) {
+        const auto c = static_cast<unsigned char>(input[i]);
+        if (c == '"' || c == '\\' || c < 0x20) {
+            return i;
+        }
+    }
+    return input.size();
+}
+
+const char *scanner_name(wslmon::JsonEscapeScanner scanner) {
+    switch (scanner) {
+        case wslmon::JsonEscapeScanner::Auto:
+            return "auto";
+        case wslmon::JsonEscapeScanner::Scalar:
+            return "scalar";
+        case wslmon::JsonEscapeScanner::Sse2:
+            return "sse2";
+        case wslmon::JsonEscapeScanner::Avx2:
+            return "avx2";
+    }
+    return "?";
+}
+
+// Mostly printable text with an adjustable density of bytes that need
+// escaping, plus high-bit bytes that must pass through untouched.
+std::string random_input(std::mt19937 &rng, std::size_t length, unsigned escape_per_mille) {
+    static const char kSpecial[] = {'"', '\\', '\n', '\r', '\t', '\0', '\x01', '\x1F', '\x1B'};
+    std::string input;
+    input.reserve(length);
+    for (std::size_t i = 0; i < length; ++i) {
+        const unsigned roll = rng() % 1000;
+        if (roll < escape_per_mille) {
+            input.push_back(kSpecial[rng() % sizeof(kSpecial)]);
+        } else if (roll < escape_per_mille + 50) {
+            input.push_back(static_cast<char>(0x80 + rng() % 0x80));
+        } else {
+            input.push_back(static_cast<char>(0x20 + rng() % 0x5F));
+        }
+    }
+    return input;
+}
+}  // namespace
+
+int main() {
+    using wslmon::JsonEscapeScanner;
+    const JsonEscapeScanner scanners[] = {JsonEscapeScanner::Auto, JsonEscapeScanner::Scalar, JsonEscapeScanner::Sse2,
+                                          JsonEscapeScanner::Avx2};
+
+    std::vector<std::string> inputs = {"", "plain", std::string(1, '\0'), "\"", "\\", std::string(31, 'a') + "\"",
+                                       std::string(32, 'a') + "\n", std::string(33, 'a') + "\x7F\x80\xFF\x1F"};
+    std::mt19937 rng(20240611);
+    for (std::size_t length = 0; length < 160; ++length) {
+        for (unsigned density : {0u, 5u, 100u, 600u}) {
+            inputs.push_back(random_input(rng, length, density));
+        }
+    }
+    inputs.push_back(random_input(rng, 8192, 1));
+
+    for (JsonEscapeScanner scanner : scanners) {
+        if (!wslmon::JsonEscapeScannerSupported(scanner)) {
+            std::cout << "skipping unsupported scanner " << scanner_name(scanner) << "\n";
+            continue;
+        }
+        for (const auto &input : inputs) {
+            std::string out = "prefix:";
+            wslmon::AppendJsonEscaped(out, input, scanner);
+            if (out != "prefix:" + reference_escape(input)) {
+                std::cerr << "Escape mismatch for scanner " << scanner_name(scanner) << " on input of length "
+                          << input.size() << "\n";
+                return 1;
+            }
+            for (std::size_t from = 0; from <= input.size() && from < 64; ++from) {
+                if (wslmon::FindJsonEscape(input, from, scanner) != reference_find(input, from)) {
+                    std::cerr << "Scan mismatch for scanner " << scanner_name(scanner) << " at offset " << from
+                              << "\n";
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,252 @@
+#include "crypto.hpp"
+#include "logger.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+std::string read_file(const std::filesystem::path &path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+// Sequence numbers of every record, read from the "sequence" field.
+std::vector<std::uint64_t> sequences_of(const std::string &log_text) {
+    std::vector<std::uint64_t> sequences;
+    const std::string field = "\"sequence\":";
+    for (auto pos = log_text.find(field); pos != std::string::npos; pos = log_text.find(field, pos + 1)) {
+        sequences.push_back(std::stoull(log_text.substr(pos + field.size(), 20)));
+    }
+    return sequences;
+}
+}  // namespace
+
+int main() {
+    const auto log_dir = std::filesystem::temp_directory_path() / "wslmon_logger_test";
+    std::filesystem::remove_all(log_dir);
+    const auto log_path = log_dir / "events.log";
+
+    wslmon::LogCommitPolicy policy;
+    policy.group_commit = true;
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 500;
+    std::string final_hash;
+    {
+        wslmon::JsonLogger logger(log_path, "logger_test", policy);
+        std::vector<std::thread> producers;
+        for (int t = 0; t < kThreads; ++t) {
+            producers.emplace_back([&logger, t] {
+                for (int i = 0; i < kPerThread; ++i) {
+                    wslmon::EventRecord record{};
+                    record.message = "producer " + std::to_string(t) + " record " + std::to_string(i);
+                    logger.Append(record);
+                }
+            });
+        }
+        for (auto &producer : producers) {
+            producer.join();
+        }
+
+        // A critical record is on disk by the time Append returns.
+        wslmon::EventRecord critical{};
+        critical.severity = wslmon::Severity::Critical;
+        critical.message = "imminent shutdown";
+        logger.Append(critical);
+        if (read_file(log_path).find("imminent shutdown") == std::string::npos) {
+            std::cerr << "critical record was not committed by Append\n";
+            return 1;
+        }
+        final_hash = logger.CurrentChainHash();
+    }
+
+    const std::string log_text = read_file(log_path);
+    const auto report = wslmon::VerifyChain(log_text, wslmon::ChainHashAlgorithm::Sha256);
+    if (report.records != kThreads * kPerThread + 1 || !report.ok() || report.final_chain_hash != final_hash) {
+        std::cerr << "group-committed log failed chain verification\n";
+        return 1;
+    }
+    const auto sequences = sequences_of(log_text);
+    for (std::size_t i = 0; i < sequences.size(); ++i) {
+        if (sequences[i] != i + 1) {
+            std::cerr << "sequence " << sequences[i] << " at line " << i << " is out of order\n";
+            return 1;
+        }
+    }
+
+    // A synchronous logger picks the chain up where the writer thread left
+    // it.
+    {
+        wslmon::JsonLogger logger(log_path, "logger_test");
+        wslmon::EventRecord record{};
+        record.message = "after restart";
+        logger.Append(record);
+    }
+    const auto resumed = wslmon::VerifyChain(read_file(log_path), wslmon::ChainHashAlgorithm::Sha256);
+    if (resumed.records != kThreads * kPerThread + 2 || !resumed.ok()) {
+        std::cerr << "chain did not resume across logger modes\n";
+        return 1;
+    }
+
+    // Recovery: the log is the authority whenever the state page is
+    // missing, stale, corrupt or ahead of a torn tail.
+    const auto state_path = std::filesystem::path(log_path.string() + ".chainstate");
+    const auto append_and_verify = [&](const char *label, std::size_t expected_records) {
+        {
+            wslmon::JsonLogger logger(log_path, "logger_test");
+            wslmon::EventRecord record{};
+            record.message = label;
+            logger.Append(record);
+        }
+        const std::string text = read_file(log_path);
+        const auto recovered = wslmon::VerifyChain(text, wslmon::ChainHashAlgorithm::Sha256);
+        const auto recovered_sequences = sequences_of(text);
+        if (recovered.records != expected_records || !recovered.ok() ||
+            recovered_sequences.back() != recovered_sequences.size()) {
+            std::cerr << "chain broke after recovery from " << label << "\n";
+            return false;
+        }
+        return true;
+    };
+    std::size_t expected = kThreads * kPerThread + 2;
+
+    const std::string stale_state = read_file(state_path);
+    {
+        wslmon::JsonLogger logger(log_path, "logger_test");
+        for (int i = 0; i < 5; ++i) {
+            wslmon::EventRecord record{};
+            record.message = "not in the stale page";
+            logger.Append(record);
+        }
+    }
+    expected += 5;
+    std::ofstream(state_path, std::ios::binary | std::ios::trunc) << stale_state;
+    if (!append_and_verify("stale state", ++expected)) {
+        return 1;
+    }
+
+    std::string corrupt_state = read_file(state_path);
+    corrupt_state[40] ^= 0x01;
+    corrupt_state[168] ^= 0x01;
+    std::ofstream(state_path, std::ios::binary | std::ios::trunc) << corrupt_state;
+    if (!append_and_verify("corrupt state", ++expected)) {
+        return 1;
+    }
+
+    std::filesystem::remove(state_path);
+    if (!append_and_verify("missing state", ++expected)) {
+        return 1;
+    }
+
+    std::ofstream(log_path, std::ios::binary | std::ios::app) << "{\"event\":{\"sequence\":99";
+    if (!append_and_verify("torn tail", ++expected)) {
+        return 1;
+    }
+
+    // Preallocated segments: the live file carries NUL padding that
+    // readers stop at, and a clean close trims it.
+    std::filesystem::remove_all(log_dir);
+    wslmon::LogCommitPolicy mapped_policy;
+    mapped_policy.preallocate_segments = true;
+    std::string padded_copy;
+    {
+        wslmon::JsonLogger logger(log_path, "logger_test", mapped_policy);
+        for (int i = 0; i < 50; ++i) {
+            wslmon::EventRecord record{};
+            record.message = "mapped record " + std::to_string(i);
+            logger.Append(record);
+        }
+        logger.Flush();
+        padded_copy = read_file(log_path);
+        const auto live = wslmon::VerifyChain(padded_copy, wslmon::ChainHashAlgorithm::Sha256);
+        if (live.records != 50 || !live.ok() || padded_copy.back() != '\0') {
+            std::cerr << "live preallocated segment did not verify\n";
+            return 1;
+        }
+    }
+    const std::string trimmed = read_file(log_path);
+    if (trimmed.size() != padded_copy.find('\0') || trimmed.back() != '\n') {
+        std::cerr << "preallocated segment was not trimmed on close\n";
+        return 1;
+    }
+    // A crash leaves the padding behind; the next open trims it and
+    // resumes the chain.
+    std::ofstream(log_path, std::ios::binary | std::ios::trunc) << padded_copy;
+    {
+        wslmon::JsonLogger logger(log_path, "logger_test", mapped_policy);
+        wslmon::EventRecord record{};
+        record.message = "after crash";
+        logger.Append(record);
+    }
+    const auto after_crash = wslmon::VerifyChain(read_file(log_path), wslmon::ChainHashAlgorithm::Sha256);
+    if (after_crash.records != 51 || !after_crash.ok()) {
+        std::cerr << "chain did not resume over preallocation padding\n";
+        return 1;
+    }
+
+    // A zeroed page mid-file hides everything behind it from verifiers, so
+    // the chain must not resume past it.
+    std::filesystem::remove_all(log_dir);
+    {
+        wslmon::JsonLogger logger(log_path, "logger_test");
+        for (int i = 0; i < 100; ++i) {
+            wslmon::EventRecord record{};
+            record.message = "before the gap " + std::to_string(i);
+            logger.Append(record);
+        }
+    }
+    std::string gapped = read_file(log_path);
+    gapped.replace(4096, 4096, 4096, '\0');
+    std::ofstream(log_path, std::ios::binary | std::ios::trunc) << gapped;
+    if (wslmon::VerifyChain(gapped, wslmon::ChainHashAlgorithm::Sha256).ok()) {
+        std::cerr << "records behind a zeroed gap passed verification\n";
+        return 1;
+    }
+    const std::size_t before_gap = sequences_of(gapped.substr(0, gapped.rfind('\n', 4096) + 1)).size();
+    {
+        wslmon::JsonLogger logger(log_path, "logger_test");
+        for (int i = 0; i < 10; ++i) {
+            wslmon::EventRecord record{};
+            record.message = "after the gap " + std::to_string(i);
+            logger.Append(record);
+        }
+    }
+    const auto resumed_after_gap = wslmon::VerifyChain(read_file(log_path), wslmon::ChainHashAlgorithm::Sha256);
+    if (resumed_after_gap.records != before_gap + 10 || !resumed_after_gap.ok()) {
+        std::cerr << "chain resumed past a zeroed gap\n";
+        return 1;
+    }
+    // The records behind the gap were moved to a sealed segment, not lost.
+    std::string gap_segment;
+    std::string gap_manifest;
+    for (const auto &entry : std::filesystem::directory_iterator(log_dir)) {
+        const auto name = entry.path().filename().string();
+        if (name.rfind("events.log.gap-", 0) == 0) {
+            (entry.path().extension() == ".manifest" ? gap_manifest : gap_segment) = read_file(entry.path());
+        }
+    }
+    const std::size_t gap_end = gapped.find_last_not_of('\0') + 1;
+    const std::size_t cut = gapped.rfind('\n', 4096) + 1;
+    const auto sealed = wslmon::Sha256(gap_segment);
+    if (gap_segment != gapped.substr(cut, gap_end - cut) ||
+        sequences_of(gap_segment.substr(gap_segment.find_last_of('\0'))).back() != 100 ||
+        gap_manifest.find(wslmon::BytesToHex(sealed.data(), sealed.size())) == std::string::npos ||
+        gap_manifest.find("\"logOffset\": " + std::to_string(cut)) == std::string::npos) {
+        std::cerr << "records behind a zeroed gap were not kept in a sealed segment\n";
+        return 1;
+    }
+    // New records continue the sequence after the ones in the gap segment.
+    if (sequences_of(read_file(log_path)).back() != 110) {
+        std::cerr << "sequence numbers restarted below the gap segment\n";
+        return 1;
+    }
+
+    std::filesystem::remove_all(log_dir);
+    return 0;
+}
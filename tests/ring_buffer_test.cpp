@@ -0,0 +1,164 @@
+#include "priority_ring.hpp"
+#include "ring_buffer.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+// Producer id in the high bits, per-producer counter in the low bits.
+constexpr int kShift = 32;
+
+// Within one snapshot, each producer's entries must appear in the order it
+// pushed them.
+bool producer_order_holds(const std::vector<std::string> &entries, int producers) {
+    std::vector<std::int64_t> last(static_cast<std::size_t>(producers), -1);
+    for (const auto &entry : entries) {
+        const auto value = std::stoull(entry);
+        const auto producer = static_cast<std::size_t>(value >> kShift);
+        const auto counter = static_cast<std::int64_t>(value & 0xFFFFFFFFu);
+        if (producer >= last.size() || counter <= last[producer]) {
+            return false;
+        }
+        last[producer] = counter;
+    }
+    return true;
+}
+}  // namespace
+
+int main() {
+    wslmon::RingBuffer<std::string> small(4);
+    for (int i = 0; i < 6; ++i) {
+        small.Push(std::to_string(i));
+    }
+    const auto kept = small.Snapshot();
+    if (small.size() != 4 || kept != std::vector<std::string>{"2", "3", "4", "5"}) {
+        std::cerr << "Ring did not keep the newest entries in order" << std::endl;
+        return 1;
+    }
+
+    wslmon::RingBuffer<std::string> polled(4);
+    polled.Push("a");
+    polled.Push("b");
+    auto first = polled.SnapshotSince(0);
+    polled.Push("c");
+    auto second = polled.SnapshotSince(first.next);
+    if (first.entries.size() != 2 || first.next != 2 || first.gap || second.entries != std::vector<std::string>{"c"} ||
+        second.next != 3 || second.gap) {
+        std::cerr << "Cursor reads did not return exactly the new entries" << std::endl;
+        return 1;
+    }
+    for (int i = 0; i < 6; ++i) {
+        polled.Push("x" + std::to_string(i));
+    }
+    auto behind = polled.SnapshotSince(second.next);
+    auto idle = polled.SnapshotSince(behind.next);
+    if (!behind.gap || behind.entries.size() != 4 || behind.entries.front() != "x2" || behind.next != 9 ||
+        !idle.entries.empty() || idle.gap || idle.next != 9) {
+        std::cerr << "Lapped reader was not told about the gap" << std::endl;
+        return 1;
+    }
+    std::vector<std::uint64_t> visited;
+    polled.VisitSince(7, [&](std::uint64_t sequence, const std::string &) { visited.push_back(sequence); });
+    if (visited != std::vector<std::uint64_t>{7, 8}) {
+        std::cerr << "Visitor did not see sequences 7 and 8" << std::endl;
+        return 1;
+    }
+
+    // Partitions: a routine flood leaves the urgent entry in place, and the
+    // merged snapshot is in push order.
+    wslmon::PriorityRing prioritized({8, 4, 4});
+    wslmon::EventRecord urgent{};
+    urgent.severity = wslmon::Severity::Critical;
+    urgent.sequence = 1;
+    prioritized.Push(urgent);
+    for (std::uint64_t i = 2; i < 100; ++i) {
+        wslmon::EventRecord info{};
+        info.severity = wslmon::Severity::Info;
+        info.sequence = i;
+        prioritized.Push(info);
+    }
+    const auto merged = prioritized.Snapshot();
+    const auto occupancy = prioritized.occupancy();
+    if (merged.size() != 9 || merged.front().sequence != 1 || merged[1].sequence != 92 || merged.back().sequence != 99 ||
+        occupancy[0].size != 8 || occupancy[0].capacity != 8 || occupancy[2].size != 1) {
+        std::cerr << "Priority partitions did not isolate the flood" << std::endl;
+        return 1;
+    }
+
+    // Strings force real copies, so a torn read would show up as garbage
+    // or a crash rather than a plausible integer.
+    constexpr int kProducers = 8;
+    constexpr std::uint64_t kPerProducer = 20000;
+    wslmon::RingBuffer<std::string> ring(256);
+    std::atomic<bool> done{false};
+    std::atomic<bool> reader_failed{false};
+    std::atomic<bool> poller_failed{false};
+    std::thread reader([&] {
+        while (!done.load()) {
+            if (!producer_order_holds(ring.Snapshot(), kProducers)) {
+                reader_failed = true;
+            }
+        }
+    });
+    // Without a gap, every poll must pick up exactly where the last ended.
+    std::thread poller([&] {
+        std::uint64_t cursor = 0;
+        while (!done.load()) {
+            std::uint64_t expected = cursor;
+            bool contiguous = true;
+            const auto result = ring.VisitSince(cursor, [&](std::uint64_t sequence, const std::string &) {
+                contiguous = contiguous && sequence == expected;
+                expected = sequence + 1;
+            });
+            if (!result.gap && !contiguous) {
+                poller_failed = true;
+            }
+            cursor = result.next;
+        }
+    });
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&ring, p] {
+            for (std::uint64_t i = 0; i < kPerProducer; ++i) {
+                ring.Push(std::to_string((static_cast<std::uint64_t>(p) << kShift) | i));
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    done = true;
+    reader.join();
+    poller.join();
+
+    if (reader_failed) {
+        std::cerr << "Concurrent snapshot broke per-producer ordering" << std::endl;
+        return 1;
+    }
+    if (poller_failed) {
+        std::cerr << "Cursor poll skipped entries without reporting a gap" << std::endl;
+        return 1;
+    }
+    const auto final_entries = ring.Snapshot();
+    if (final_entries.size() != 256 || !producer_order_holds(final_entries, kProducers)) {
+        std::cerr << "Final snapshot has " << final_entries.size() << " entries, expected 256 in order" << std::endl;
+        return 1;
+    }
+    // The final ticket overall is some producer's last push, and nothing
+    // can have overwritten it.
+    bool saw_last = false;
+    for (const auto &entry : final_entries) {
+        if ((std::stoull(entry) & 0xFFFFFFFFu) == kPerProducer - 1) {
+            saw_last = true;
+        }
+    }
+    if (!saw_last) {
+        std::cerr << "No producer's final push is in the ring" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,163 @@
+#include "small_vector.hpp"
+
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+int constructed = 0;
+int destroyed = 0;
+
+// Counts every construction and destruction, and carries a heap string so
+// a use of a destroyed or moved-over element shows up in the values.
+struct Tracked {
+    std::string value;
+
+    Tracked() : value("default") { ++constructed; }
+    explicit Tracked(std::string text) : value(std::move(text)) { ++constructed; }
+    Tracked(const Tracked &other) : value(other.value) { ++constructed; }
+    Tracked(Tracked &&other) noexcept : value(std::move(other.value)) { ++constructed; }
+    Tracked &operator=(const Tracked &) = default;
+    Tracked &operator=(Tracked &&) noexcept = default;
+    ~Tracked() { ++destroyed; }
+};
+
+using Vec = wslmon::SmallVector<Tracked, 4>;
+
+Tracked item(int index) {
+    return Tracked("item " + std::to_string(index) + " with a heap-sized payload");
+}
+
+std::vector<std::string> values_of(const Vec &vec) {
+    std::vector<std::string> values;
+    for (const auto &element : vec) {
+        values.push_back(element.value);
+    }
+    return values;
+}
+
+std::vector<std::string> expected_items(int first, int last) {
+    std::vector<std::string> values;
+    for (int i = first; i < last; ++i) {
+        values.push_back(item(i).value);
+    }
+    return values;
+}
+
+Vec filled(int count) {
+    Vec vec;
+    for (int i = 0; i < count; ++i) {
+        vec.push_back(item(i));
+    }
+    return vec;
+}
+}  // namespace
+
+int main() {
+    {
+        // Growth: inline up to N, then one move to the heap.
+        Vec vec;
+        for (int i = 0; i < 4; ++i) {
+            vec.push_back(item(i));
+        }
+        if (!vec.is_inline() || vec.capacity() != 4) {
+            std::cerr << "Vector left inline storage before it was full" << std::endl;
+            return 1;
+        }
+        for (int i = 4; i < 20; ++i) {
+            vec.emplace_back("item " + std::to_string(i) + " with a heap-sized payload");
+        }
+        if (vec.is_inline() || vec.size() != 20 || values_of(vec) != expected_items(0, 20)) {
+            std::cerr << "Growth to the heap lost or reordered elements" << std::endl;
+            return 1;
+        }
+    }
+
+    for (const int count : {3, 12}) {
+        const char *storage = count <= 4 ? "inline" : "heap";
+        const auto expected = expected_items(0, count);
+        Vec source = filled(count);
+
+        Vec copy(source);
+        Vec assigned = filled(1);
+        assigned = source;
+        if (values_of(copy) != expected || values_of(assigned) != expected || values_of(source) != expected) {
+            std::cerr << "Copy of a " << storage << " vector differs from its source" << std::endl;
+            return 1;
+        }
+
+        Vec moved(std::move(copy));
+        Vec move_assigned = filled(7);
+        move_assigned = std::move(assigned);
+        if (values_of(moved) != expected || values_of(move_assigned) != expected || !copy.empty() ||
+            !assigned.empty() || !copy.is_inline() || !assigned.is_inline()) {
+            std::cerr << "Move of a " << storage << " vector lost elements or left its source non-empty"
+                      << std::endl;
+            return 1;
+        }
+        // A moved-from vector is still usable.
+        copy.push_back(item(99));
+        if (copy.size() != 1 || copy.front().value != item(99).value) {
+            std::cerr << "Moved-from " << storage << " vector is not reusable" << std::endl;
+            return 1;
+        }
+    }
+
+    {
+        // Appending one of the vector's own elements at the moment it grows:
+        // the argument lives in the storage that growth releases.
+        Vec vec = filled(4);
+        vec.push_back(vec[0]);
+        vec.emplace_back(vec[1]);
+        Vec heap = filled(8);
+        heap.push_back(heap[7]);
+        Vec moved = filled(4);
+        moved.push_back(std::move(moved[2]));
+        auto expected = expected_items(0, 4);
+        expected.push_back(expected[0]);
+        expected.push_back(expected[1]);
+        auto expected_heap = expected_items(0, 8);
+        expected_heap.push_back(expected_heap[7]);
+        if (values_of(vec) != expected || values_of(heap) != expected_heap || moved.back().value != item(2).value) {
+            std::cerr << "Appending an aliased element during growth corrupted it" << std::endl;
+            return 1;
+        }
+    }
+
+    {
+        Vec vec = filled(10);
+        vec.erase(vec.begin());
+        vec.erase(vec.begin() + 4);
+        vec.erase(vec.end() - 1);
+        if (values_of(vec) != std::vector<std::string>{item(1).value, item(2).value, item(3).value, item(4).value,
+                                                       item(6).value, item(7).value, item(8).value}) {
+            std::cerr << "Erase did not close the gap in order" << std::endl;
+            return 1;
+        }
+        vec.resize(2);
+        if (values_of(vec) != std::vector<std::string>{item(1).value, item(2).value}) {
+            std::cerr << "Shrinking resize kept the wrong elements" << std::endl;
+            return 1;
+        }
+        vec.resize(6);
+        if (vec.size() != 6 || vec[1].value != item(2).value || vec[2].value != "default" ||
+            vec[5].value != "default") {
+            std::cerr << "Growing resize did not default-construct the new elements" << std::endl;
+            return 1;
+        }
+        Vec small = filled(3);
+        small.resize(0);
+        small.resize(3);
+        if (!small.is_inline() || small.size() != 3 || small[0].value != "default") {
+            std::cerr << "Resize within inline storage misbehaved" << std::endl;
+            return 1;
+        }
+    }
+
+    if (constructed != destroyed) {
+        std::cerr << "Constructed " << constructed << " elements but destroyed " << destroyed << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,57 @@
+#include "event.hpp"
+#include "event_codec.hpp"
+#include "symbol.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+int main() {
+    using wslmon::Symbol;
+
+    const Symbol trusted("kernel.kmsg");
+    if (Symbol::FromUntrusted("kernel.kmsg") != trusted || !Symbol::FromUntrusted("").empty() ||
+        Symbol::FromUntrusted(std::string(300, 'k')) != Symbol::kUnknownText) {
+        std::cerr << "Untrusted interning did not reuse, pass empty, or reject long text" << std::endl;
+        return 1;
+    }
+
+    // A peer sending a fresh attribute key in every record must not be able
+    // to exhaust the table: past the cap new text becomes "(unknown)".
+    const Symbol early = Symbol::FromUntrusted("peer key 0");
+    std::size_t interned = 0;
+    for (int i = 1; i < 200000; ++i) {
+        const Symbol symbol = Symbol::FromUntrusted("peer key " + std::to_string(i));
+        if (symbol != Symbol::kUnknownText) {
+            ++interned;
+        }
+    }
+    if (interned == 0 || interned > 100000 || early != "peer key 0" ||
+        Symbol::FromUntrusted("peer key 0") != early) {
+        std::cerr << "Untrusted interning was not capped (" << interned << " interned)" << std::endl;
+        return 1;
+    }
+
+    // Decoders fall back instead of throwing, and trusted code keeps its
+    // headroom.
+    wslmon::EventRecord record;
+    record.timestamp = std::chrono::system_clock::now();
+    record.source = "source";
+    record.attributes.push_back({"known", "v"});
+    std::string json = wslmon::SerializeEvent(record);
+    json.replace(json.find("\"known\""), 7, "\"never seen before\"");
+    std::string binary;
+    wslmon::EventRecord decoded;
+    if (!wslmon::DeserializeEvent(json, decoded) || decoded.attributes[0].key != Symbol::kUnknownText ||
+        decoded.source != "source") {
+        std::cerr << "JSON decoding of new text past the cap did not fall back" << std::endl;
+        return 1;
+    }
+    record.attributes[0].key = Symbol("interned by the process");
+    wslmon::EncodeEventBinary(record, binary);
+    if (!wslmon::DecodeEventBinary(binary, decoded) || decoded.attributes[0].key != "interned by the process") {
+        std::cerr << "Binary decoding lost a symbol the process interned" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,212 @@
+#include "timestamp.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+using Clock = std::chrono::system_clock;
+
+#ifdef _WIN32
+// gmtime_s and _mkgmtime reject times before 1970.
+constexpr std::int64_t kLegacyEarliest = 0;
+#else
+constexpr std::int64_t kLegacyEarliest = -2208988800;  // 1900-01-01
+#endif
+
+// The gmtime/put_time and get_time/timegm implementations the timestamp
+// module replaced (also measured in bench/timestamp_bench.cpp), used here
+// as the reference for whole seconds.
+std::string legacy_format(std::time_t seconds, const char *pattern) {
+    std::tm tm{};
+#ifdef _WIN32
+    gmtime_s(&tm, &seconds);
+#else
+    gmtime_r(&seconds, &tm);
+#endif
+    std::ostringstream oss;
+    oss << std::put_time(&tm, pattern);
+    return oss.str();
+}
+
+bool legacy_parse(const std::string &ts, Clock::time_point &tp) {
+    std::tm parsed{};
+    std::istringstream ss(ts.substr(0, 19));
+    ss >> std::get_time(&parsed, "%Y-%m-%dT%H:%M:%S");
+    if (ss.fail()) {
+        return false;
+    }
+#ifdef _WIN32
+    std::time_t time_value = _mkgmtime(&parsed);
+#else
+    std::time_t time_value = timegm(&parsed);
+#endif
+    tp = Clock::from_time_t(time_value);
+    auto dot_pos = ts.find('.');
+    if (dot_pos != std::string::npos) {
+        auto frac = ts.substr(dot_pos + 1);
+        if (!frac.empty() && frac.back() == 'Z') {
+            frac.pop_back();
+        }
+        while (frac.size() < 6) {
+            frac.push_back('0');
+        }
+        tp += std::chrono::microseconds(std::stoll(frac.substr(0, 6)));
+    }
+    return true;
+}
+
+Clock::time_point at_micros(std::int64_t micros) {
+    return Clock::time_point(std::chrono::duration_cast<Clock::duration>(std::chrono::microseconds(micros)));
+}
+
+std::int64_t micros_of(Clock::time_point tp) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(tp.time_since_epoch()).count();
+}
+
+std::string pad_micros(std::int64_t fraction) {
+    std::ostringstream oss;
+    oss << std::setw(6) << std::setfill('0') << fraction;
+    return oss.str();
+}
+
+// Formats |seconds| + |fraction| in every format and checks each against
+// the legacy formatter, then parses the ISO forms back.
+bool matches_legacy(std::int64_t seconds, std::int64_t fraction) {
+    const auto tp = at_micros(seconds * 1000000 + fraction);
+    const auto t = static_cast<std::time_t>(seconds);
+    const std::string micros = legacy_format(t, "%Y-%m-%dT%H:%M:%S") + "." + pad_micros(fraction) + "Z";
+    const std::string whole = legacy_format(t, "%Y-%m-%dT%H:%M:%SZ");
+    const std::string compact = legacy_format(t, "%Y%m%dT%H%M%SZ");
+    if (wslmon::FormatTimestamp(tp) != micros ||
+        wslmon::FormatTimestamp(tp, wslmon::TimestampFormat::Iso8601Seconds) != whole ||
+        wslmon::FormatTimestamp(tp, wslmon::TimestampFormat::CompactSeconds) != compact) {
+        std::cerr << "Formatting " << micros << " differs from the legacy formatter: "
+                  << wslmon::FormatTimestamp(tp) << std::endl;
+        return false;
+    }
+    Clock::time_point parsed;
+    Clock::time_point legacy;
+    if (!wslmon::ParseTimestamp(micros, parsed) || !legacy_parse(micros, legacy) || parsed != legacy ||
+        parsed != tp) {
+        std::cerr << "Parsing " << micros << " differs from the legacy parser" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Parses |text| with both implementations and expects the same instant,
+// |expected_micros| since the epoch.
+bool parses_like_legacy(const std::string &text, std::int64_t expected_micros) {
+    Clock::time_point parsed;
+    Clock::time_point legacy = at_micros(expected_micros);
+    if (!wslmon::ParseTimestamp(text, parsed) ||
+        (expected_micros >= kLegacyEarliest * 1000000 && (!legacy_parse(text, legacy) || parsed != legacy)) ||
+        micros_of(parsed) != expected_micros) {
+        std::cerr << "Parsing " << text << " gave " << micros_of(parsed) << ", expected " << expected_micros
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+}  // namespace
+
+int main() {
+    // Every day from 1901 to 2099 at a time of day that moves through the
+    // clock, so each month end and leap day is formatted. Revisiting an
+    // earlier second also exercises the per-thread prefix cache.
+    constexpr std::int64_t kDay = 86400;
+    const std::int64_t first = -69 * 365 * kDay;
+    for (std::int64_t day = 0; day < 199 * 366; ++day) {
+        const std::int64_t seconds = first + day * kDay + (day * 7919) % kDay;
+        if (seconds - kDay < kLegacyEarliest) {
+            continue;
+        }
+        if (!matches_legacy(seconds, (day * 104729) % 1000000) || !matches_legacy(seconds - kDay, 0)) {
+            return 1;
+        }
+    }
+
+    // Before 1970 the fraction still counts forward from the whole second
+    // below, which the legacy formatter printed as a negative number.
+    if (wslmon::FormatTimestamp(at_micros(-1)) != "1969-12-31T23:59:59.999999Z" ||
+        wslmon::FormatTimestamp(at_micros(-1500000)) != "1969-12-31T23:59:58.500000Z") {
+        std::cerr << "Pre-1970 fractions were formatted wrongly" << std::endl;
+        return 1;
+    }
+    Clock::time_point parsed;
+    if (!wslmon::ParseTimestamp("1969-12-31T23:59:58.500000Z", parsed) || micros_of(parsed) != -1500000) {
+        std::cerr << "Pre-1970 fraction did not parse back" << std::endl;
+        return 1;
+    }
+
+    // Leap days, including the century rules.
+    const std::int64_t feb29_2000 = 951782400;
+    const std::int64_t feb29_2024 = 1709164800;
+    const std::int64_t mar1_1900 = -2203891200;
+    if (!parses_like_legacy("2000-02-29T00:00:00Z", feb29_2000 * 1000000) ||
+        !parses_like_legacy("2024-02-29T23:59:59.999999Z", (feb29_2024 + kDay) * 1000000 - 1) ||
+        !parses_like_legacy("1900-03-01T00:00:00Z", mar1_1900 * 1000000) ||
+        wslmon::FormatTimestamp(at_micros(feb29_2024 * 1000000)) != "2024-02-29T00:00:00.000000Z" ||
+        wslmon::FormatTimestamp(at_micros((mar1_1900 - 1) * 1000000)) != "1900-02-28T23:59:59.000000Z") {
+        return 1;
+    }
+
+    // A leap second reads as the first second of the next minute, as
+    // timegm normalizes it.
+    const std::int64_t new_year_2017 = 1483228800;
+    if (!parses_like_legacy("2016-12-31T23:59:60Z", new_year_2017 * 1000000) ||
+        !parses_like_legacy("2016-12-31T23:59:60.250Z", new_year_2017 * 1000000 + 250000)) {
+        return 1;
+    }
+
+    // Fractions shorter than six digits are scaled up, longer ones cut to
+    // microseconds, and the trailing Z is optional.
+    const std::int64_t base = 1700000000;
+    const std::vector<std::pair<std::string, std::int64_t>> fractions = {
+        {"2023-11-14T22:13:20Z", 0},
+        {"2023-11-14T22:13:20.5Z", 500000},
+        {"2023-11-14T22:13:20.05", 50000},
+        {"2023-11-14T22:13:20.123Z", 123000},
+        {"2023-11-14T22:13:20.123456Z", 123456},
+        {"2023-11-14T22:13:20.1234567Z", 123456},
+        {"2023-11-14T22:13:20.999999999Z", 999999},
+    };
+    for (const auto &[text, fraction] : fractions) {
+        if (!parses_like_legacy(text, base * 1000000 + fraction)) {
+            return 1;
+        }
+    }
+
+    const std::vector<std::string> malformed = {
+        "",
+        "2023-11-14",
+        "2023-11-14T22:13:2",
+        "2023-11-14 22:13:20Z",
+        "2023/11/14T22:13:20Z",
+        "2023-11-14T22-13-20Z",
+        "2023-1a-14T22:13:20Z",
+        "+023-11-14T22:13:20Z",
+        " 2023-11-14T22:13:20Z",
+        "2023-00-14T22:13:20Z",
+        "2023-13-14T22:13:20Z",
+        "2023-11-00T22:13:20Z",
+        "2023-11-32T22:13:20Z",
+        "2023-11-14T24:00:00Z",
+        "2023-11-14T22:60:20Z",
+        "2023-11-14T22:13:61Z",
+    };
+    for (const auto &text : malformed) {
+        if (wslmon::ParseTimestamp(text, parsed)) {
+            std::cerr << "Malformed timestamp \"" << text << "\" was accepted" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -3,15 +3,17 @@
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
-#include <iomanip>
 #include <iostream>
-#include <sstream>
+#include <ostream>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <ctime>
 
 #include "event.hpp"
+#include "event_view.hpp"
 #include "heuristic_analyzer.hpp"
+#include "mapped_file.hpp"
+#include "timestamp.hpp"
 
 namespace {
 struct ReportOptions {
@@ -20,38 +22,17 @@ struct ReportOptions {
     std::filesystem::path output_path;
 };
 
-struct CollectedEvent {
-    wslmon::TimelineEvent timeline;
-    std::string event_json;
-};
-
-std::string now_timestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t_value = std::chrono::system_clock::to_time_t(now);
-    std::tm tm{};
-#ifdef _WIN32
-    gmtime_s(&tm, &time_t_value);
-#else
-    gmtime_r(&time_t_value, &tm);
-#endif
-    auto fractional = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count() % 1000000;
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%S");
-    oss << '.' << std::setw(6) << std::setfill('0') << fractional << 'Z';
-    return oss.str();
-}
-
-bool extract_event_json(const std::string &line, std::string &event_json, std::string &chain_hash) {
+bool extract_event_json(std::string_view line, std::string_view &event_json, std::string_view &chain_hash) {
     auto event_pos = line.find("\"event\":");
-    if (event_pos == std::string::npos) {
+    if (event_pos == std::string_view::npos) {
         return false;
     }
     auto brace_pos = line.find('{', event_pos);
-    if (brace_pos == std::string::npos) {
+    if (brace_pos == std::string_view::npos) {
         return false;
     }
     int depth = 0;
-    std::size_t end_pos = std::string::npos;
+    std::size_t end_pos = std::string_view::npos;
     for (std::size_t i = brace_pos; i < line.size(); ++i) {
         if (line[i] == '{') {
             ++depth;
@@ -63,41 +44,53 @@ bool extract_event_json(const std::string &line, std::string &event_json, std::s
             }
         }
     }
-    if (end_pos == std::string::npos) {
+    if (end_pos == std::string_view::npos) {
         return false;
     }
     event_json = line.substr(brace_pos, end_pos - brace_pos + 1);
 
-    auto chain_pos = line.find("\"chainHash\":\"", end_pos);
-    if (chain_pos != std::string::npos) {
-        chain_pos += std::string("\"chainHash\":\"").size();
+    constexpr std::string_view kChainHashField = "\"chainHash\":\"";
+    auto chain_pos = line.find(kChainHashField, end_pos);
+    if (chain_pos != std::string_view::npos) {
+        chain_pos += kChainHashField.size();
         auto chain_end = line.find('"', chain_pos);
-        if (chain_end != std::string::npos) {
+        if (chain_end != std::string_view::npos) {
             chain_hash = line.substr(chain_pos, chain_end - chain_pos);
         }
     }
     return true;
 }
 
-bool load_log(const std::filesystem::path &path, const std::string &origin, std::vector<CollectedEvent> &events,
-              std::string &final_chain_hash) {
-    std::ifstream in(path);
-    if (!in.is_open()) {
+// The log is mapped rather than streamed; a live segment is read instead,
+// since its writer may trim it under us. Only the event JSON and chain
+// hash of each line are kept, copied into the arena; the views handed to
+// the analyzer point at those copies.
+bool load_log(const std::filesystem::path &path, wslmon::Symbol origin, wslmon::EventArena &arena,
+              std::vector<wslmon::TimelineEventView> &events, std::string &final_chain_hash) {
+    wslmon::MappedFile file;
+    if (!file.Open(path)) {
         return false;
     }
-    std::string line;
-    while (std::getline(in, line)) {
-        std::string event_json;
-        std::string chain_hash;
+    std::string_view text = file.view();
+    // A segment still being written ends in preallocated NUL padding.
+    text = text.substr(0, text.find('\0'));
+    while (!text.empty()) {
+        const auto end = text.find('\n');
+        const std::string_view line = text.substr(0, end);
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+        std::string_view event_json;
+        std::string_view chain_hash;
         if (!extract_event_json(line, event_json, chain_hash)) {
             continue;
         }
-        final_chain_hash = chain_hash;
-        wslmon::EventRecord record;
-        if (!wslmon::DeserializeEvent(event_json, record)) {
+        final_chain_hash.assign(chain_hash.data(), chain_hash.size());
+        wslmon::TimelineEventView entry;
+        entry.origin = origin;
+        if (!wslmon::ParseEventView(arena.Store(event_json), arena, entry.event)) {
             continue;
         }
-        events.push_back(CollectedEvent{wslmon::TimelineEvent{origin, std::move(record), chain_hash}, event_json});
+        entry.chain_hash = arena.Store(chain_hash);
+        events.push_back(entry);
     }
     return true;
 }
@@ -138,21 +131,10 @@ std::string format_timestamp(const std::chrono::system_clock::time_point &tp) {
     if (tp == std::chrono::system_clock::time_point{}) {
         return "";
     }
-    auto time_t_value = std::chrono::system_clock::to_time_t(tp);
-    std::tm tm{};
-#ifdef _WIN32
-    gmtime_s(&tm, &time_t_value);
-#else
-    gmtime_r(&time_t_value, &tm);
-#endif
-    auto fractional = std::chrono::duration_cast<std::chrono::microseconds>(tp.time_since_epoch()).count() % 1000000;
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%S");
-    oss << '.' << std::setw(6) << std::setfill('0') << fractional << 'Z';
-    return oss.str();
+    return wslmon::FormatTimestamp(tp);
 }
 
-void append_metrics(std::ostringstream &oss, const wslmon::ChannelHealthMetrics &metrics) {
+void append_metrics(std::ostream &oss, const wslmon::ChannelHealthMetrics &metrics) {
     oss << "{\"total\":" << metrics.total;
     oss << ",\"info\":" << metrics.info;
     oss << ",\"warning\":" << metrics.warning;
@@ -165,32 +147,25 @@ void append_metrics(std::ostringstream &oss, const wslmon::ChannelHealthMetrics
     oss << '}';
 }
 
-void write_report(const std::vector<CollectedEvent> &events, const ReportOptions &options, const std::string &host_chain,
-                  const std::string &guest_chain) {
-    std::vector<wslmon::TimelineEvent> timeline;
-    timeline.reserve(events.size());
-    for (const auto &entry : events) {
-        timeline.push_back(entry.timeline);
-    }
+void write_report(std::ostream &oss, const std::vector<wslmon::TimelineEventView> &events, const ReportOptions &options,
+                  const std::string &host_chain, const std::string &guest_chain) {
+    const auto health = wslmon::ComputeCrossChannelSnapshot(events);
+    const auto insights = wslmon::AnalyzeEventTimeline(events);
 
-    const auto health = wslmon::ComputeCrossChannelSnapshot(timeline);
-    const auto insights = wslmon::AnalyzeEventTimeline(timeline);
-
-    std::ostringstream oss;
     oss << "{\n";
-    oss << "  \"generatedAt\": \"" << now_timestamp() << "\",\n";
+    oss << "  \"generatedAt\": \"" << wslmon::FormatTimestamp(std::chrono::system_clock::now()) << "\",\n";
     oss << "  \"host\": {\n";
     oss << "    \"logPath\": \"" << options.host_log.string() << "\",\n";
     oss << "    \"finalChainHash\": \"" << host_chain << "\",\n";
     oss << "    \"eventCount\": " << std::count_if(events.begin(), events.end(), [](const auto &e) {
-        return e.timeline.origin == "host";
+        return e.origin == "host";
     }) << "\n";
     oss << "  },\n";
     oss << "  \"guest\": {\n";
     oss << "    \"logPath\": \"" << options.guest_log.string() << "\",\n";
     oss << "    \"finalChainHash\": \"" << guest_chain << "\",\n";
     oss << "    \"eventCount\": " << std::count_if(events.begin(), events.end(), [](const auto &e) {
-        return e.timeline.origin == "guest";
+        return e.origin == "guest";
     }) << "\n";
     oss << "  },\n";
     oss << "  \"health\": {\n";
@@ -226,8 +201,8 @@ void write_report(const std::vector<CollectedEvent> &events, const ReportOptions
     oss << "  \"events\": [\n";
     for (std::size_t i = 0; i < events.size(); ++i) {
         const auto &event = events[i];
-        oss << "    {\"origin\":\"" << event.timeline.origin << "\",\"chainHash\":\""
-            << event.timeline.chain_hash << "\",\"event\":" << event.event_json << "}";
+        oss << "    {\"origin\":\"" << event.origin << "\",\"chainHash\":\"" << event.chain_hash
+            << "\",\"event\":" << event.event.json << "}";
         if (i + 1 < events.size()) {
             oss << ',';
         }
@@ -235,13 +210,6 @@ void write_report(const std::vector<CollectedEvent> &events, const ReportOptions
     }
     oss << "  ]\n";
     oss << "}\n";
-
-    if (!options.output_path.empty()) {
-        std::ofstream out(options.output_path);
-        out << oss.str();
-    } else {
-        std::cout << oss.str();
-    }
 }
 
 }  // namespace
@@ -249,27 +217,36 @@ void write_report(const std::vector<CollectedEvent> &events, const ReportOptions
 int main(int argc, char **argv) {
     ReportOptions options = parse_arguments(argc, argv);
 
-    std::vector<CollectedEvent> events;
+    wslmon::EventArena arena;
+    std::vector<wslmon::TimelineEventView> events;
     events.reserve(4096);
 
     std::string host_chain;
     std::string guest_chain;
 
     if (!options.host_log.empty()) {
-        if (!load_log(options.host_log, "host", events, host_chain)) {
+        if (!load_log(options.host_log, "host", arena, events, host_chain)) {
             std::cerr << "Warning: unable to load host log from " << options.host_log << "\n";
         }
     }
     if (!options.guest_log.empty()) {
-        if (!load_log(options.guest_log, "guest", events, guest_chain)) {
+        if (!load_log(options.guest_log, "guest", arena, events, guest_chain)) {
             std::cerr << "Warning: unable to load guest log from " << options.guest_log << "\n";
         }
     }
 
-    std::sort(events.begin(), events.end(), [](const CollectedEvent &lhs, const CollectedEvent &rhs) {
-        return lhs.timeline.record.timestamp < rhs.timeline.record.timestamp;
-    });
+    std::sort(events.begin(), events.end(),
+              [](const wslmon::TimelineEventView &lhs, const wslmon::TimelineEventView &rhs) {
+                  return lhs.event.timestamp < rhs.event.timestamp;
+              });
 
-    write_report(events, options, host_chain, guest_chain);
+    // The report is streamed straight to its destination rather than built
+    // in memory first.
+    if (!options.output_path.empty()) {
+        std::ofstream out(options.output_path);
+        write_report(out, events, options, host_chain, guest_chain);
+    } else {
+        write_report(std::cout, events, options, host_chain, guest_chain);
+    }
     return 0;
 }
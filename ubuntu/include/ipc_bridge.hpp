@@ -9,6 +9,7 @@
 #include <thread>
 #include <vector>
 
+#include "crypto.hpp"
 #include "event.hpp"
 
 namespace wslmon::ubuntu {
@@ -31,7 +32,7 @@ class IpcBridge {
 
     bool load_secret();
     bool connect_named_pipe(int &fd);
-    bool send_event_via_pipe(int fd, const EventRecord &record, const std::vector<std::uint8_t> &session);
+    bool send_event_via_pipe(int fd, const EventRecord &record, const HmacKey &session);
 
     EventCallback callback_;
     std::string log_origin_;
@@ -52,7 +53,7 @@ class IpcBridge {
     std::string secret_path_;
 
     std::mutex session_mutex_;
-    std::vector<std::uint8_t> pipe_session_;
+    HmacKey pipe_session_;
 
     static constexpr const char *kPipePath = "//./pipe/WslMonitorBridge";
     static constexpr const char *kUnixSocketPath = "/var/run/wsl-monitor/host.sock";
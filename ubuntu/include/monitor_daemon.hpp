@@ -6,8 +6,9 @@
 #include <thread>
 #include <vector>
 
+#include "black_box.hpp"
+#include "flight_recorder.hpp"
 #include "logger.hpp"
-#include "ring_buffer.hpp"
 #include "ipc_bridge.hpp"
 
 namespace wslmon::ubuntu {
@@ -22,20 +23,21 @@ class MonitorDaemon {
 
   private:
     void watch_journal();
-    void watch_resources();
+    void watch_samples();
     void watch_crashes();
     void watch_kmsg();
-    void watch_pressure();
     void watch_systemd_failures();
-    void watch_network_health();
     void emit(EventRecord record);
     void add_common_attributes(EventRecord &record);
     void handle_peer_event(EventRecord record);
 
     std::atomic<bool> running_{false};
     std::vector<std::thread> workers_;
+    // Declared before logger_, whose writer marks records in it until the
+    // logger is destroyed.
+    BlackBoxRing black_box_;
     JsonLogger logger_;
-    RingBuffer<EventRecord> buffer_;
+    FlightRecorder buffer_;
     std::string boot_id_;
     std::string machine_id_;
     std::string hostname_;
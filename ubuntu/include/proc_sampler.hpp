@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wslmon::ubuntu {
+
+// Re-reads a fixed set of procfs files once per sampling tick. The files
+// stay open, and each tick reads them from offset 0. By default each file
+// gets a pread. With |use_io_uring|, every read for a tick goes out in one
+// io_uring_enter instead, and pread takes over if the kernel lacks io_uring
+// or has it disabled. procfs reads cannot complete inline, so the kernel
+// hands them to its io-wq workers. On the kernels measured, that made the
+// ring slower than pread, which is why it is opt-in.
+class ProcSampler {
+  public:
+    ProcSampler(const std::vector<std::string> &paths, bool use_io_uring);
+    ~ProcSampler();
+    ProcSampler(const ProcSampler &) = delete;
+    ProcSampler &operator=(const ProcSampler &) = delete;
+
+    void Sample();
+
+    // Whether the file at |index| (in constructor order) was read on the
+    // last tick; false if it could not be opened or read.
+    [[nodiscard]] bool ok(std::size_t index) const { return sources_[index].ok; }
+    [[nodiscard]] std::string_view text(std::size_t index) const {
+        return {sources_[index].buffer.data(), sources_[index].length};
+    }
+    [[nodiscard]] bool using_io_uring() const { return ring_ != nullptr; }
+
+  private:
+    struct Source {
+        std::string path;
+        int fd = -1;
+        std::vector<char> buffer;
+        std::size_t length = 0;
+        bool ok = false;
+    };
+    struct Ring;
+
+    bool sample_ring();
+    // Called when io_uring_enter fails with |in_flight| reads taken by the
+    // kernel and |completed| of them reaped; waits for the rest.
+    void abandon_ring(unsigned in_flight, unsigned completed);
+    static void read_source(Source &source);
+
+    std::vector<Source> sources_;
+    std::unique_ptr<Ring> ring_;
+    // Buffers of reads that could not be waited out after a ring failure.
+    // They stay allocated since the kernel may still write into them.
+    std::vector<std::vector<char>> abandoned_buffers_;
+};
+
+}  // namespace wslmon::ubuntu
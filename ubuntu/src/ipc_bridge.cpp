@@ -38,7 +38,7 @@ bool read_full(int fd, std::uint8_t *buffer, std::size_t length) {
     return true;
 }
 
-void add_attribute(EventRecord &record, const std::string &key, const std::string &value) {
+void add_attribute(EventRecord &record, Symbol key, const std::string &value) {
     for (auto &attr : record.attributes) {
         if (attr.key == key) {
             attr.value = value;
@@ -119,14 +119,14 @@ bool IpcBridge::connect_named_pipe(int &fd) {
 
 bool IpcBridge::send_event_via_pipe(int fd,
                                     const EventRecord &record,
-                                    const std::vector<std::uint8_t> &session) {
+                                    const HmacKey &session) {
     if (session.empty()) {
         return false;
     }
     auto write_fn = [fd](const std::uint8_t *buffer, std::size_t bytes) -> bool {
         return write_full(fd, buffer, bytes);
     };
-    return IpcSendEvent(write_fn, session, record);
+    return IpcSendEvent(write_fn, session, record, IpcPayloadEncoding::Binary);
 }
 
 void IpcBridge::pipe_worker() {
@@ -153,7 +153,7 @@ void IpcBridge::pipe_worker() {
             return read_full(fd, buffer, bytes);
         };
 
-        std::vector<std::uint8_t> session;
+        HmacKey session;
         if (!IpcClientHandshake(write_fn, read_fn, secret_, session)) {
             ::close(fd);
             pipe_fd_ = -1;
@@ -179,7 +179,7 @@ void IpcBridge::pipe_worker() {
                 outbound_.pop_front();
             }
 
-            std::vector<std::uint8_t> session_copy;
+            HmacKey session_copy;
             {
                 std::lock_guard<std::mutex> lock(session_mutex_);
                 session_copy = pipe_session_;
@@ -193,7 +193,7 @@ void IpcBridge::pipe_worker() {
 
         {
             std::lock_guard<std::mutex> lock(session_mutex_);
-            pipe_session_.clear();
+            pipe_session_.Clear();
         }
         ::close(fd);
         pipe_fd_ = -1;
@@ -251,7 +251,7 @@ void IpcBridge::unix_worker() {
             return read_full(client, buffer, bytes);
         };
 
-        std::vector<std::uint8_t> session;
+        HmacKey session;
         if (!IpcServerHandshake(write_fn, read_fn, secret_, session)) {
             ::close(client);
             std::this_thread::sleep_for(std::chrono::seconds(2));
@@ -10,7 +10,9 @@
 #include <array>
 #include <chrono>
 #include <cctype>
+#include <charconv>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
@@ -23,6 +25,8 @@
 
 #include <systemd/sd-journal.h>
 
+#include "proc_sampler.hpp"
+
 namespace wslmon::ubuntu {
 
 namespace {
@@ -89,11 +93,8 @@ struct PressureReading {
     double avg300 = 0.0;
 };
 
-bool parse_pressure_file(const std::string &path, PressureReading &some, PressureReading &full) {
-    std::ifstream file(path);
-    if (!file.is_open()) {
-        return false;
-    }
+bool parse_pressure(std::string_view text, PressureReading &some, PressureReading &full) {
+    std::istringstream file{std::string(text)};
     std::string line;
     while (std::getline(file, line)) {
         std::istringstream iss(line);
@@ -106,18 +107,18 @@ bool parse_pressure_file(const std::string &path, PressureReading &some, Pressur
             if (pos == std::string::npos) {
                 continue;
             }
-            std::string key = token.substr(0, pos);
-            std::string value = token.substr(pos + 1);
-            try {
-                if (key == "avg10") {
-                    reading.avg10 = std::stod(value);
-                } else if (key == "avg60") {
-                    reading.avg60 = std::stod(value);
-                } else if (key == "avg300") {
-                    reading.avg300 = std::stod(value);
-                }
-            } catch (const std::exception &) {
-                continue;
+            std::string_view key(token.data(), pos);
+            std::string_view value(token.data() + pos + 1, token.size() - pos - 1);
+            double *target = nullptr;
+            if (key == "avg10") {
+                target = &reading.avg10;
+            } else if (key == "avg60") {
+                target = &reading.avg60;
+            } else if (key == "avg300") {
+                target = &reading.avg300;
+            }
+            if (target) {
+                std::from_chars(value.data(), value.data() + value.size(), *target);
             }
         }
         if (scope == "some") {
@@ -169,11 +170,8 @@ struct CpuSample {
     std::uint64_t softirq = 0;
 };
 
-bool read_cpu_sample(CpuSample &sample) {
-    std::ifstream stat("/proc/stat");
-    if (!stat.is_open()) {
-        return false;
-    }
+bool parse_cpu_sample(std::string_view text, CpuSample &sample) {
+    std::istringstream stat{std::string(text.substr(0, text.find('\n')))};
     std::string cpu;
     stat >> cpu >> sample.user >> sample.nice >> sample.system >> sample.idle >> sample.iowait >> sample.irq >> sample.softirq;
     return cpu == "cpu";
@@ -192,11 +190,8 @@ double compute_cpu_usage(const CpuSample &prev, const CpuSample &curr) {
     return (static_cast<double>(totald - idled) / static_cast<double>(totald)) * 100.0;
 }
 
-bool read_memory_usage(double &used_percent) {
-    std::ifstream meminfo("/proc/meminfo");
-    if (!meminfo.is_open()) {
-        return false;
-    }
+bool parse_memory_usage(std::string_view text, double &used_percent) {
+    std::istringstream meminfo{std::string(text)};
     std::uint64_t mem_total = 0;
     std::uint64_t mem_available = 0;
     std::string key;
@@ -227,11 +222,34 @@ void add_journal_matches(sd_journal *journal) {
     sd_journal_add_match(journal, "_TRANSPORT=kernel", 0);
 }
 
+LogCommitPolicy daemon_log_policy() {
+    LogCommitPolicy policy;
+    policy.group_commit = true;
+    policy.preallocate_segments = true;
+    return policy;
+}
+
+// WSLMON_FLIGHT_RECORDER_SECONDS overrides how far back the in-memory
+// history reaches.
+FlightRecorderLimits daemon_recorder_limits() {
+    FlightRecorderLimits limits;
+    if (const char *seconds = std::getenv("WSLMON_FLIGHT_RECORDER_SECONDS"); seconds && *seconds) {
+        char *end = nullptr;
+        const unsigned long long value = std::strtoull(seconds, &end, 10);
+        if (*end == '\0' && value > 0) {
+            limits.horizon = std::chrono::seconds(value);
+        }
+    }
+    return limits;
+}
+
 }  // namespace
 
 MonitorDaemon::MonitorDaemon()
-    : logger_(std::filesystem::path{"/var/log/wsl-monitor/guest-events.log"}, "wslmon.ubuntu"),
-      buffer_(1024),
+    : logger_(std::filesystem::path{"/var/log/wsl-monitor/guest-events.log"},
+              "wslmon.ubuntu",
+              daemon_log_policy()),
+      buffer_(daemon_recorder_limits()),
       boot_id_(read_trimmed_file("/proc/sys/kernel/random/boot_id")),
       machine_id_(read_trimmed_file("/etc/machine-id")),
       hostname_(detect_hostname()),
@@ -244,16 +262,19 @@ void MonitorDaemon::Run() {
     if (running_.exchange(true)) {
         return;
     }
+    // Whatever the previous run left in the black box goes into the log
+    // before new events start overwriting it.
+    black_box_.Open("/var/lib/wsl-monitor/guest-blackbox.ring");
+    logger_.AttachBlackBox(&black_box_);
+    LogRecoveredEvents(logger_, black_box_.TakeRecovered(), "wslmon.ubuntu.blackbox");
     if (bridge_) {
         bridge_->Start();
     }
     workers_.emplace_back(&MonitorDaemon::watch_journal, this);
-    workers_.emplace_back(&MonitorDaemon::watch_resources, this);
+    workers_.emplace_back(&MonitorDaemon::watch_samples, this);
     workers_.emplace_back(&MonitorDaemon::watch_crashes, this);
     workers_.emplace_back(&MonitorDaemon::watch_kmsg, this);
-    workers_.emplace_back(&MonitorDaemon::watch_pressure, this);
     workers_.emplace_back(&MonitorDaemon::watch_systemd_failures, this);
-    workers_.emplace_back(&MonitorDaemon::watch_network_health, this);
 }
 
 void MonitorDaemon::Stop() {
@@ -269,6 +290,7 @@ void MonitorDaemon::Stop() {
         }
     }
     workers_.clear();
+    black_box_.Close();
 }
 
 void MonitorDaemon::emit(EventRecord record) {
@@ -282,9 +304,9 @@ void MonitorDaemon::emit(EventRecord record) {
 }
 
 void MonitorDaemon::handle_peer_event(EventRecord record) {
-    auto ensure_attr = [&record](const std::string &key, const std::string &value) {
+    auto ensure_attr = [&record](Symbol key, const std::string &value) {
         auto it = std::find_if(record.attributes.begin(), record.attributes.end(),
-                               [&key](const auto &attr) { return attr.key == key; });
+                               [key](const auto &attr) { return attr.key == key; });
         if (it == record.attributes.end()) {
             record.attributes.push_back({key, value});
         } else {
@@ -297,12 +319,12 @@ void MonitorDaemon::handle_peer_event(EventRecord record) {
 }
 
 void MonitorDaemon::add_common_attributes(EventRecord &record) {
-    auto ensure_attr = [&record](const std::string &key, const std::string &value) {
+    auto ensure_attr = [&record](Symbol key, const std::string &value) {
         if (value.empty()) {
             return;
         }
         auto existing = std::find_if(record.attributes.begin(), record.attributes.end(),
-                                      [&key](const auto &attr) { return attr.key == key; });
+                                      [key](const auto &attr) { return attr.key == key; });
         if (existing == record.attributes.end()) {
             record.attributes.push_back({key, value});
         }
@@ -319,7 +341,7 @@ void MonitorDaemon::watch_journal() {
         EventRecord record;
         record.source = "systemd.journal";
         record.category = "Journal";
-        record.severity = "Error";
+        record.severity = Severity::Error;
         record.message = "Failed to open systemd journal";
         emit(std::move(record));
         return;
@@ -337,7 +359,7 @@ void MonitorDaemon::watch_journal() {
             EventRecord record;
             record.source = "systemd.journal";
             record.category = "Journal";
-            record.severity = "Info";
+            record.severity = Severity::Info;
             record.message = trim_newlines(get_journal_field(journal, "MESSAGE"));
             record.attributes.push_back({"unit", get_journal_field(journal, "_SYSTEMD_UNIT")});
             record.attributes.push_back({"transport", get_journal_field(journal, "_TRANSPORT")});
@@ -348,46 +370,186 @@ void MonitorDaemon::watch_journal() {
     sd_journal_close(journal);
 }
 
-void MonitorDaemon::watch_resources() {
+// Resource, pressure and network sampling share one tick so that a single
+// ProcSampler pass serves all three. Normally the tick is 5 s, with
+// pressure checked every 10 s and interface counters every 15 s. After a
+// pressure alert, the minute that often precedes a shutdown, resources and
+// interface counters are sampled every tick at kBurstTick.
+void MonitorDaemon::watch_samples() {
+    using Clock = std::chrono::steady_clock;
+    constexpr auto kTick = std::chrono::seconds(5);
+    constexpr auto kBurstTick = std::chrono::milliseconds(500);
+    constexpr auto kBurstWindow = std::chrono::seconds(60);
+    constexpr auto kPressureInterval = std::chrono::seconds(10);
+    constexpr auto kNetworkInterval = std::chrono::seconds(15);
+    enum Source : std::size_t { kStat, kMeminfo, kMemoryPressure, kCpuPressure, kNetDev };
+
+    const char *backend = std::getenv("WSLMON_SAMPLER_BACKEND");
+    ProcSampler sampler({"/proc/stat", "/proc/meminfo", "/proc/pressure/memory", "/proc/pressure/cpu", "/proc/net/dev"},
+                        backend && std::string_view(backend) == "io_uring");
+
     CpuSample prev{};
-    if (!read_cpu_sample(prev)) {
+    sampler.Sample();
+    if (!sampler.ok(kStat) || !parse_cpu_sample(sampler.text(kStat), prev)) {
         EventRecord record;
         record.source = "resource.monitor";
         record.category = "Resource";
-        record.severity = "Warning";
+        record.severity = Severity::Warning;
         record.message = "Unable to read initial CPU sample";
         emit(std::move(record));
     }
+
+    PressureReading last_some{};
+    std::unordered_map<std::string, InterfaceCounters> last_state;
+    auto next_tick = Clock::now();
+    auto next_resources = next_tick + kTick;
+    auto next_pressure = next_tick;
+    auto next_network = next_tick;
+    Clock::time_point next_network_warning{};
+    Clock::time_point burst_until{};
+
     while (running_.load()) {
-        std::this_thread::sleep_for(std::chrono::seconds(5));
-        CpuSample curr{};
-        if (!read_cpu_sample(curr)) {
-            continue;
+        // Ticks follow a fixed schedule, so time spent sampling does not
+        // push later samples back.
+        const bool burst = next_tick < burst_until;
+        next_tick += burst ? std::chrono::duration_cast<Clock::duration>(kBurstTick) : kTick;
+        std::this_thread::sleep_until(next_tick);
+        if (!running_.load()) {
+            break;
+        }
+        const auto now = Clock::now();
+        if (now > next_tick + kTick) {
+            // Suspended or badly delayed; resynchronize instead of catching up.
+            next_tick = now;
         }
-        double cpu_usage = compute_cpu_usage(prev, curr);
-        prev = curr;
-        double mem_usage = 0.0;
-        read_memory_usage(mem_usage);
-
-        struct statvfs vfs {};
-        double root_usage = 0.0;
-        if (statvfs("/", &vfs) == 0) {
-            auto total = static_cast<double>(vfs.f_blocks) * vfs.f_frsize;
-            auto available = static_cast<double>(vfs.f_bavail) * vfs.f_frsize;
-            if (total > 0) {
-                root_usage = (total - available) / total * 100.0;
+        sampler.Sample();
+
+        if (burst || now >= next_resources) {
+            next_resources = now + kTick;
+            CpuSample curr{};
+            if (sampler.ok(kStat) && parse_cpu_sample(sampler.text(kStat), curr)) {
+                double cpu_usage = compute_cpu_usage(prev, curr);
+                prev = curr;
+                double mem_usage = 0.0;
+                if (sampler.ok(kMeminfo)) {
+                    parse_memory_usage(sampler.text(kMeminfo), mem_usage);
+                }
+
+                struct statvfs vfs {};
+                double root_usage = 0.0;
+                if (statvfs("/", &vfs) == 0) {
+                    auto total = static_cast<double>(vfs.f_blocks) * vfs.f_frsize;
+                    auto available = static_cast<double>(vfs.f_bavail) * vfs.f_frsize;
+                    if (total > 0) {
+                        root_usage = (total - available) / total * 100.0;
+                    }
+                }
+
+                EventRecord record;
+                record.source = "resource.monitor";
+                record.category = "Resource";
+                record.severity = Severity::Info;
+                record.message = "Resource utilization";
+                record.attributes.push_back({"cpu", cpu_usage});
+                record.attributes.push_back({"mem", mem_usage});
+                record.attributes.push_back({"disk_root", root_usage});
+                emit(std::move(record));
             }
         }
 
-        EventRecord record;
-        record.source = "resource.monitor";
-        record.category = "Resource";
-        record.severity = "Info";
-        record.message = "Resource utilization";
-        record.attributes.push_back({"cpu", std::to_string(cpu_usage)});
-        record.attributes.push_back({"mem", std::to_string(mem_usage)});
-        record.attributes.push_back({"disk_root", std::to_string(root_usage)});
-        emit(std::move(record));
+        if (now >= next_pressure) {
+            next_pressure = now + kPressureInterval;
+            PressureReading some{};
+            PressureReading full{};
+            if (sampler.ok(kMemoryPressure) && parse_pressure(sampler.text(kMemoryPressure), some, full)) {
+                if ((some.avg10 > 40.0 && some.avg10 > last_some.avg10 + 5.0) || some.avg60 > 30.0 || full.avg10 > 5.0) {
+                    EventRecord record;
+                    record.source = "pressure.memory";
+                    record.category = "Pressure";
+                    record.severity = some.avg10 > 60.0 || full.avg10 > 10.0 ? Severity::Critical : Severity::Warning;
+                    record.message = "Memory pressure elevated";
+                    record.attributes.push_back({"some_avg10", some.avg10});
+                    record.attributes.push_back({"some_avg60", some.avg60});
+                    record.attributes.push_back({"full_avg10", full.avg10});
+                    record.attributes.push_back({"full_avg60", full.avg60});
+                    emit(std::move(record));
+                    burst_until = now + kBurstWindow;
+                }
+                last_some = some;
+            }
+
+            if (sampler.ok(kCpuPressure) && parse_pressure(sampler.text(kCpuPressure), some, full)) {
+                if (some.avg10 > 60.0 || full.avg10 > 20.0) {
+                    EventRecord record;
+                    record.source = "pressure.cpu";
+                    record.category = "Pressure";
+                    record.severity = some.avg10 > 80.0 ? Severity::Critical : Severity::Warning;
+                    record.message = "CPU pressure sustained";
+                    record.attributes.push_back({"some_avg10", some.avg10});
+                    record.attributes.push_back({"some_avg60", some.avg60});
+                    record.attributes.push_back({"full_avg10", full.avg10});
+                    record.attributes.push_back({"full_avg60", full.avg60});
+                    emit(std::move(record));
+                    burst_until = now + kBurstWindow;
+                }
+            }
+        }
+
+        if (burst || now >= next_network) {
+            next_network = now + kNetworkInterval;
+            if (!sampler.ok(kNetDev)) {
+                // Bursts sample every tick; keep this warning at the normal
+                // network cadence.
+                if (now >= next_network_warning) {
+                    next_network_warning = now + kNetworkInterval;
+                    EventRecord record;
+                    record.source = "net.dev";
+                    record.category = "Network";
+                    record.severity = Severity::Warning;
+                    record.message = "Cannot open /proc/net/dev";
+                    emit(std::move(record));
+                }
+            } else {
+                std::istringstream dev{std::string(sampler.text(kNetDev))};
+                std::string line;
+                std::getline(dev, line);
+                std::getline(dev, line);
+                while (std::getline(dev, line)) {
+                    std::string name;
+                    InterfaceCounters counters;
+                    if (!parse_interface_line(line, name, counters)) {
+                        continue;
+                    }
+                    if (name == "lo") {
+                        continue;
+                    }
+                    auto it = last_state.find(name);
+                    if (it != last_state.end()) {
+                        auto &prev_counters = it->second;
+                        auto rx_drop_delta = counters.rx_dropped - prev_counters.rx_dropped;
+                        auto tx_drop_delta = counters.tx_dropped - prev_counters.tx_dropped;
+                        auto rx_err_delta = counters.rx_errors - prev_counters.rx_errors;
+                        auto tx_err_delta = counters.tx_errors - prev_counters.tx_errors;
+                        if (rx_drop_delta > 0 || tx_drop_delta > 0 || rx_err_delta > 0 || tx_err_delta > 0) {
+                            EventRecord record;
+                            record.source = "net.dev";
+                            record.category = "Network";
+                            record.severity = (rx_err_delta + tx_err_delta) > 0 ? Severity::Warning : Severity::Info;
+                            record.message = "Interface error counters increased";
+                            record.attributes.push_back({"interface", name});
+                            record.attributes.push_back({"rx_dropped", rx_drop_delta});
+                            record.attributes.push_back({"tx_dropped", tx_drop_delta});
+                            record.attributes.push_back({"rx_errors", rx_err_delta});
+                            record.attributes.push_back({"tx_errors", tx_err_delta});
+                            record.attributes.push_back({"rx_bytes", counters.rx_bytes});
+                            record.attributes.push_back({"tx_bytes", counters.tx_bytes});
+                            emit(std::move(record));
+                        }
+                    }
+                    last_state[name] = counters;
+                }
+            }
+        }
     }
 }
 
@@ -397,9 +559,9 @@ void MonitorDaemon::watch_crashes() {
         EventRecord record;
         record.source = "inotify.crash";
         record.category = "Crash";
-        record.severity = "Error";
+        record.severity = Severity::Error;
         record.message = "Failed to initialize inotify";
-        record.attributes.push_back({"error", std::to_string(errno)});
+        record.attributes.push_back({"error", errno});
         emit(std::move(record));
         return;
     }
@@ -408,9 +570,9 @@ void MonitorDaemon::watch_crashes() {
         EventRecord record;
         record.source = "inotify.crash";
         record.category = "Crash";
-        record.severity = "Warning";
+        record.severity = Severity::Warning;
         record.message = "Cannot watch /var/crash";
-        record.attributes.push_back({"error", std::to_string(errno)});
+        record.attributes.push_back({"error", errno});
         emit(std::move(record));
     }
 
@@ -430,7 +592,7 @@ void MonitorDaemon::watch_crashes() {
                         EventRecord record;
                         record.source = "inotify.crash";
                         record.category = "Crash";
-                        record.severity = "Critical";
+                        record.severity = Severity::Critical;
                         record.message = "Crash dump detected";
                         record.attributes.push_back({"path", std::string("/var/crash/") + event->name});
                         emit(std::move(record));
@@ -452,9 +614,9 @@ void MonitorDaemon::watch_kmsg() {
         EventRecord record;
         record.source = "kernel.kmsg";
         record.category = "Kernel";
-        record.severity = "Warning";
+        record.severity = Severity::Warning;
         record.message = "Unable to open /dev/kmsg";
-        record.attributes.push_back({"error", std::to_string(errno)});
+        record.attributes.push_back({"error", errno});
         emit(std::move(record));
         return;
     }
@@ -476,11 +638,11 @@ void MonitorDaemon::watch_kmsg() {
                 record.category = "Kernel";
                 record.message = trimmed;
                 if (contains_any_keyword(trimmed, {"panic", "fatal", "bug"})) {
-                    record.severity = "Critical";
+                    record.severity = Severity::Critical;
                 } else if (contains_any_keyword(trimmed, {"error", "warn", "oom"})) {
-                    record.severity = "Warning";
+                    record.severity = Severity::Warning;
                 } else {
-                    record.severity = "Info";
+                    record.severity = Severity::Info;
                 }
                 emit(std::move(record));
             }
@@ -491,9 +653,9 @@ void MonitorDaemon::watch_kmsg() {
                 EventRecord record;
                 record.source = "kernel.kmsg";
                 record.category = "Kernel";
-                record.severity = "Warning";
+                record.severity = Severity::Warning;
                 record.message = "kmsg read failure";
-                record.attributes.push_back({"error", std::to_string(errno)});
+                record.attributes.push_back({"error", errno});
                 emit(std::move(record));
             }
             std::this_thread::sleep_for(std::chrono::seconds(2));
@@ -502,49 +664,6 @@ void MonitorDaemon::watch_kmsg() {
     close(fd);
 }
 
-void MonitorDaemon::watch_pressure() {
-    PressureReading some{};
-    PressureReading full{};
-    PressureReading last_some{};
-    PressureReading last_full{};
-
-    while (running_.load()) {
-        if (parse_pressure_file("/proc/pressure/memory", some, full)) {
-            if ((some.avg10 > 40.0 && some.avg10 > last_some.avg10 + 5.0) || some.avg60 > 30.0 || full.avg10 > 5.0) {
-                EventRecord record;
-                record.source = "pressure.memory";
-                record.category = "Pressure";
-                record.severity = some.avg10 > 60.0 || full.avg10 > 10.0 ? "Critical" : "Warning";
-                record.message = "Memory pressure elevated";
-                record.attributes.push_back({"some_avg10", std::to_string(some.avg10)});
-                record.attributes.push_back({"some_avg60", std::to_string(some.avg60)});
-                record.attributes.push_back({"full_avg10", std::to_string(full.avg10)});
-                record.attributes.push_back({"full_avg60", std::to_string(full.avg60)});
-                emit(std::move(record));
-            }
-            last_some = some;
-            last_full = full;
-        }
-
-        if (parse_pressure_file("/proc/pressure/cpu", some, full)) {
-            if (some.avg10 > 60.0 || full.avg10 > 20.0) {
-                EventRecord record;
-                record.source = "pressure.cpu";
-                record.category = "Pressure";
-                record.severity = some.avg10 > 80.0 ? "Critical" : "Warning";
-                record.message = "CPU pressure sustained";
-                record.attributes.push_back({"some_avg10", std::to_string(some.avg10)});
-                record.attributes.push_back({"some_avg60", std::to_string(some.avg60)});
-                record.attributes.push_back({"full_avg10", std::to_string(full.avg10)});
-                record.attributes.push_back({"full_avg60", std::to_string(full.avg60)});
-                emit(std::move(record));
-            }
-        }
-
-        std::this_thread::sleep_for(std::chrono::seconds(10));
-    }
-}
-
 void MonitorDaemon::watch_systemd_failures() {
     std::string last_output;
     while (running_.load()) {
@@ -553,9 +672,9 @@ void MonitorDaemon::watch_systemd_failures() {
             EventRecord record;
             record.source = "systemd.failures";
             record.category = "Systemd";
-            record.severity = "Warning";
+            record.severity = Severity::Warning;
             record.message = "Failed to execute systemctl";
-            record.attributes.push_back({"error", std::to_string(errno)});
+            record.attributes.push_back({"error", errno});
             emit(std::move(record));
             std::this_thread::sleep_for(std::chrono::seconds(30));
             continue;
@@ -570,7 +689,7 @@ void MonitorDaemon::watch_systemd_failures() {
             EventRecord record;
             record.source = "systemd.failures";
             record.category = "Systemd";
-            record.severity = "Warning";
+            record.severity = Severity::Warning;
             record.message = "Systemd units failing";
             record.attributes.push_back({"units", trim_newlines(output)});
             emit(std::move(record));
@@ -582,61 +701,5 @@ void MonitorDaemon::watch_systemd_failures() {
     }
 }
 
-void MonitorDaemon::watch_network_health() {
-    std::unordered_map<std::string, InterfaceCounters> last_state;
-
-    while (running_.load()) {
-        std::ifstream dev("/proc/net/dev");
-        if (!dev.is_open()) {
-            EventRecord record;
-            record.source = "net.dev";
-            record.category = "Network";
-            record.severity = "Warning";
-            record.message = "Cannot open /proc/net/dev";
-            emit(std::move(record));
-            std::this_thread::sleep_for(std::chrono::seconds(15));
-            continue;
-        }
-        std::string line;
-        std::getline(dev, line);
-        std::getline(dev, line);
-        while (std::getline(dev, line)) {
-            std::string name;
-            InterfaceCounters counters;
-            if (!parse_interface_line(line, name, counters)) {
-                continue;
-            }
-            if (name == "lo") {
-                continue;
-            }
-            auto it = last_state.find(name);
-            if (it != last_state.end()) {
-                auto &prev = it->second;
-                auto rx_drop_delta = counters.rx_dropped - prev.rx_dropped;
-                auto tx_drop_delta = counters.tx_dropped - prev.tx_dropped;
-                auto rx_err_delta = counters.rx_errors - prev.rx_errors;
-                auto tx_err_delta = counters.tx_errors - prev.tx_errors;
-                if (rx_drop_delta > 0 || tx_drop_delta > 0 || rx_err_delta > 0 || tx_err_delta > 0) {
-                    EventRecord record;
-                    record.source = "net.dev";
-                    record.category = "Network";
-                    record.severity = (rx_err_delta + tx_err_delta) > 0 ? "Warning" : "Info";
-                    record.message = "Interface error counters increased";
-                    record.attributes.push_back({"interface", name});
-                    record.attributes.push_back({"rx_dropped", std::to_string(rx_drop_delta)});
-                    record.attributes.push_back({"tx_dropped", std::to_string(tx_drop_delta)});
-                    record.attributes.push_back({"rx_errors", std::to_string(rx_err_delta)});
-                    record.attributes.push_back({"tx_errors", std::to_string(tx_err_delta)});
-                    record.attributes.push_back({"rx_bytes", std::to_string(counters.rx_bytes)});
-                    record.attributes.push_back({"tx_bytes", std::to_string(counters.tx_bytes)});
-                    emit(std::move(record));
-                }
-            }
-            last_state[name] = counters;
-        }
-        std::this_thread::sleep_for(std::chrono::seconds(15));
-    }
-}
-
 }  // namespace wslmon::ubuntu
 
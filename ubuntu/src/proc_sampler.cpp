@@ -0,0 +1,277 @@
+#include "proc_sampler.hpp"
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+namespace wslmon::ubuntu {
+
+namespace {
+constexpr std::size_t kInitialBufferSize = 16 * 1024;
+
+// glibc has no wrappers for these, and liburing is not a build dependency.
+int io_uring_setup(unsigned entries, io_uring_params *params) {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+}  // namespace
+
+// Submission and completion rings mapped from the kernel. Only the sampler
+// thread touches them; the atomics order our stores against the kernel's.
+struct ProcSampler::Ring {
+    int fd = -1;
+    void *sq_map = nullptr;
+    std::size_t sq_map_size = 0;
+    void *cq_map = nullptr;
+    std::size_t cq_map_size = 0;
+    io_uring_sqe *sqes = nullptr;
+    std::size_t sqes_size = 0;
+
+    unsigned *sq_tail = nullptr;
+    unsigned *sq_mask = nullptr;
+    unsigned *sq_array = nullptr;
+    unsigned *cq_head = nullptr;
+    unsigned *cq_tail = nullptr;
+    unsigned *cq_mask = nullptr;
+    io_uring_cqe *cqes = nullptr;
+
+    ~Ring() {
+        if (sqes) {
+            ::munmap(sqes, sqes_size);
+        }
+        if (cq_map && cq_map != sq_map) {
+            ::munmap(cq_map, cq_map_size);
+        }
+        if (sq_map) {
+            ::munmap(sq_map, sq_map_size);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    bool Setup(unsigned entries) {
+        io_uring_params params{};
+        fd = io_uring_setup(entries, &params);
+        if (fd < 0) {
+            return false;
+        }
+        sq_map_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_map_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_map = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_map) {
+            sq_map_size = cq_map_size = std::max(sq_map_size, cq_map_size);
+        }
+        sq_map = ::mmap(nullptr, sq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                        IORING_OFF_SQ_RING);
+        if (sq_map == MAP_FAILED) {
+            sq_map = nullptr;
+            return false;
+        }
+        if (single_map) {
+            cq_map = sq_map;
+        } else {
+            cq_map = ::mmap(nullptr, cq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                            IORING_OFF_CQ_RING);
+            if (cq_map == MAP_FAILED) {
+                cq_map = nullptr;
+                return false;
+            }
+        }
+        sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        void *sqe_map =
+            ::mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+        if (sqe_map == MAP_FAILED) {
+            return false;
+        }
+        sqes = static_cast<io_uring_sqe *>(sqe_map);
+
+        auto *sq = static_cast<unsigned char *>(sq_map);
+        auto *cq = static_cast<unsigned char *>(cq_map);
+        sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        sq_mask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+        cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        cq_mask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+        return true;
+    }
+};
+
+ProcSampler::ProcSampler(const std::vector<std::string> &paths, bool use_io_uring) {
+    sources_.resize(paths.size());
+    unsigned open_count = 0;
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        auto &source = sources_[i];
+        source.path = paths[i];
+        source.fd = ::open(source.path.c_str(), O_RDONLY | O_CLOEXEC);
+        source.buffer.resize(kInitialBufferSize);
+        if (source.fd >= 0) {
+            ++open_count;
+        }
+    }
+    if (use_io_uring && open_count > 0) {
+        auto ring = std::make_unique<Ring>();
+        if (ring->Setup(open_count)) {
+            ring_ = std::move(ring);
+        }
+    }
+}
+
+ProcSampler::~ProcSampler() {
+    ring_.reset();
+    for (auto &source : sources_) {
+        if (source.fd >= 0) {
+            ::close(source.fd);
+        }
+    }
+}
+
+void ProcSampler::read_source(Source &source) {
+    source.ok = false;
+    source.length = 0;
+    if (source.fd < 0) {
+        return;
+    }
+    for (;;) {
+        const ssize_t n = ::pread(source.fd, source.buffer.data(), source.buffer.size(), 0);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        // A full buffer may mean the file was cut short; grow and retry.
+        if (static_cast<std::size_t>(n) < source.buffer.size()) {
+            source.length = static_cast<std::size_t>(n);
+            source.ok = true;
+            return;
+        }
+        source.buffer.resize(source.buffer.size() * 2);
+    }
+}
+
+void ProcSampler::Sample() {
+    if (ring_ && sample_ring()) {
+        return;
+    }
+    // The ring failed mid-tick (or was never available): drop it for good
+    // rather than retrying on every tick.
+    ring_.reset();
+    for (auto &source : sources_) {
+        read_source(source);
+    }
+}
+
+bool ProcSampler::sample_ring() {
+    Ring &ring = *ring_;
+    const unsigned mask = *ring.sq_mask;
+    std::atomic_ref<unsigned> sq_tail(*ring.sq_tail);
+    unsigned tail = sq_tail.load(std::memory_order_relaxed);
+    unsigned submitted = 0;
+    for (std::size_t i = 0; i < sources_.size(); ++i) {
+        auto &source = sources_[i];
+        source.ok = false;
+        source.length = 0;
+        if (source.fd < 0) {
+            continue;
+        }
+        const unsigned index = tail & mask;
+        io_uring_sqe &sqe = ring.sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = source.fd;
+        sqe.addr = reinterpret_cast<std::uint64_t>(source.buffer.data());
+        sqe.len = static_cast<std::uint32_t>(source.buffer.size());
+        sqe.off = 0;
+        sqe.user_data = i;
+        ring.sq_array[index] = index;
+        ++tail;
+        ++submitted;
+    }
+    if (submitted == 0) {
+        return true;
+    }
+    sq_tail.store(tail, std::memory_order_release);
+
+    unsigned to_submit = submitted;
+    unsigned completed = 0;
+    std::atomic_ref<unsigned> cq_head(*ring.cq_head);
+    std::atomic_ref<unsigned> cq_tail(*ring.cq_tail);
+    bool unsupported = false;
+    while (completed < submitted) {
+        const int entered = io_uring_enter(ring.fd, to_submit, submitted - completed, IORING_ENTER_GETEVENTS);
+        if (entered < 0) {
+            // The kernel reports a submission count rather than EINTR
+            // once it has consumed entries, so nothing is in flight twice.
+            if (errno == EINTR) {
+                continue;
+            }
+            abandon_ring(submitted - to_submit, completed);
+            return false;
+        }
+        to_submit = to_submit > static_cast<unsigned>(entered) ? to_submit - static_cast<unsigned>(entered) : 0;
+        unsigned head = cq_head.load(std::memory_order_relaxed);
+        const unsigned ready = cq_tail.load(std::memory_order_acquire);
+        for (; head != ready; ++head) {
+            const io_uring_cqe &cqe = ring.cqes[head & *ring.cq_mask];
+            auto &source = sources_[static_cast<std::size_t>(cqe.user_data)];
+            if (cqe.res == -EINVAL || cqe.res == -EOPNOTSUPP) {
+                // IORING_OP_READ needs Linux 5.6.
+                unsupported = true;
+            } else if (cqe.res >= 0) {
+                source.length = static_cast<std::size_t>(cqe.res);
+                source.ok = true;
+                if (source.length == source.buffer.size()) {
+                    read_source(source);
+                }
+            }
+            ++completed;
+        }
+        cq_head.store(head, std::memory_order_release);
+    }
+    return !unsupported;
+}
+
+void ProcSampler::abandon_ring(unsigned in_flight, unsigned completed) {
+    // Reads the kernel has taken still target the source buffers, and
+    // closing the ring does not wait for them. Reap them before the caller
+    // falls back to pread into the same memory.
+    Ring &ring = *ring_;
+    std::atomic_ref<unsigned> cq_head(*ring.cq_head);
+    std::atomic_ref<unsigned> cq_tail(*ring.cq_tail);
+    while (completed < in_flight) {
+        const unsigned head = cq_head.load(std::memory_order_relaxed);
+        const unsigned ready = cq_tail.load(std::memory_order_acquire);
+        completed += ready - head;
+        cq_head.store(ready, std::memory_order_release);
+        if (completed >= in_flight) {
+            break;
+        }
+        if (io_uring_enter(ring.fd, 0, in_flight - completed, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+            // The reads cannot be waited out. Hand their buffers over for
+            // good so the kernel can never write into memory read later.
+            for (auto &source : sources_) {
+                if (source.fd >= 0) {
+                    abandoned_buffers_.push_back(std::move(source.buffer));
+                    source.buffer.assign(kInitialBufferSize, '\0');
+                }
+            }
+            return;
+        }
+    }
+}
+
+}  // namespace wslmon::ubuntu
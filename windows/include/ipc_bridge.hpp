@@ -11,6 +11,7 @@
 #include <thread>
 #include <vector>
 
+#include "crypto.hpp"
 #include "event.hpp"
 
 namespace wslmon {
@@ -44,8 +45,8 @@ class IpcBridge {
     void handle_guest_event(EventRecord record);
 
     std::vector<std::uint8_t> secret_;
-    std::vector<std::uint8_t> pipe_session_;
-    std::vector<std::uint8_t> socket_session_;
+    HmacKey pipe_session_;
+    HmacKey socket_session_;
 
     ShutdownMonitorService &service_;
     std::atomic<bool> running_{false};
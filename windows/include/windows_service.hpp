@@ -8,8 +8,9 @@
 #include <thread>
 #include <vector>
 
+#include "black_box.hpp"
 #include "logger.hpp"
-#include "ring_buffer.hpp"
+#include "priority_ring.hpp"
 
 namespace wslmon::windows {
 
@@ -27,7 +28,7 @@ class ShutdownMonitorService {
     static ShutdownMonitorService &Instance();
 
     JsonLogger &Logger() { return logger_; }
-    RingBuffer<EventRecord> &Buffer() { return buffer_; }
+    PriorityRing &Buffer() { return buffer_; }
     void ForwardToGuest(const EventRecord &record);
 
   private:
@@ -37,8 +38,11 @@ class ShutdownMonitorService {
     SERVICE_STATUS_HANDLE status_handle_ = nullptr;
     std::atomic<bool> running_{false};
     std::thread worker_;
+    // Declared before logger_, whose writer marks records in it until the
+    // logger is destroyed.
+    BlackBoxRing black_box_;
     JsonLogger logger_;
-    RingBuffer<EventRecord> buffer_;
+    PriorityRing buffer_;
     std::vector<std::unique_ptr<EventCollector>> collectors_;
     std::unique_ptr<IpcBridge> bridge_;
 };
@@ -68,12 +68,12 @@ EventCollector::EventCollector(std::wstring name) : name_(std::move(name)) {}
 void EventCollector::emit(ShutdownMonitorService &service, EventRecord record) {
     record.source = std::string(name_.begin(), name_.end());
     record.timestamp = std::chrono::system_clock::now();
-    auto ensure_attr = [&record](const std::string &key, const std::string &value) {
+    auto ensure_attr = [&record](Symbol key, const std::string &value) {
         if (value.empty()) {
             return;
         }
         auto it = std::find_if(record.attributes.begin(), record.attributes.end(),
-                               [&key](const auto &attr) { return attr.key == key; });
+                               [key](const auto &attr) { return attr.key == key; });
         if (it == record.attributes.end()) {
             record.attributes.push_back({key, value});
         }
@@ -64,20 +64,20 @@ bool render_system_values(EVT_HANDLE event, EVT_VARIANT (&values)[EvtSystemPrope
     return EvtRender(nullptr, event, EvtRenderEventValues, sizeof(values), values, &buffer_used, nullptr) != 0;
 }
 
-std::string level_to_severity(std::uint8_t level) {
+Severity level_to_severity(std::uint8_t level) {
     switch (level) {
         case WINEVENT_LEVEL_CRITICAL:
-            return "Critical";
+            return Severity::Critical;
         case WINEVENT_LEVEL_ERROR:
-            return "Error";
+            return Severity::Error;
         case WINEVENT_LEVEL_WARNING:
-            return "Warning";
+            return Severity::Warning;
         case WINEVENT_LEVEL_VERBOSE:
-            return "Verbose";
+            return Severity::Verbose;
         case WINEVENT_LEVEL_LOG_ALWAYS:
         case WINEVENT_LEVEL_INFO:
         default:
-            return "Info";
+            return Severity::Info;
     }
 }
 
@@ -107,7 +107,7 @@ void EventLogCollector::Start(ShutdownMonitorService &service) {
     if (!stop_event_) {
         EventRecord record;
         record.category = "EventLog";
-        record.severity = "Error";
+        record.severity = Severity::Error;
         record.message = "Failed to create stop event for event log collector";
         service.Logger().Append(record);
         return;
@@ -124,7 +124,7 @@ void EventLogCollector::Start(ShutdownMonitorService &service) {
     if (!thread) {
         EventRecord record;
         record.category = "EventLog";
-        record.severity = "Error";
+        record.severity = Severity::Error;
         record.message = "Failed to create event log collector thread";
         service.Logger().Append(record);
         return;
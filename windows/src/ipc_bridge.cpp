@@ -77,7 +77,7 @@ bool read_full_socket(SOCKET socket, std::uint8_t *buffer, std::size_t length) {
     return true;
 }
 
-void add_attribute(EventRecord &record, const std::string &key, const std::string &value) {
+void add_attribute(EventRecord &record, Symbol key, const std::string &value) {
     for (auto &attr : record.attributes) {
         if (attr.key == key) {
             attr.value = value;
@@ -107,7 +107,7 @@ std::string build_unix_path(const std::string &distro, const std::string &socket
 void log_error(ShutdownMonitorService &service, const std::string &message) {
     EventRecord record;
     record.category = "IPC";
-    record.severity = "Warning";
+    record.severity = Severity::Warning;
     record.message = message;
     service.Logger().Append(record);
 }
@@ -264,7 +264,7 @@ void IpcBridge::pipe_worker() {
             return read_full(pipe, buffer, bytes);
         };
 
-        std::vector<std::uint8_t> session;
+        HmacKey session;
         if (!IpcServerHandshake(write_fn, read_fn, secret_, session)) {
             ::DisconnectNamedPipe(pipe);
             ::CloseHandle(pipe);
@@ -282,7 +282,7 @@ void IpcBridge::pipe_worker() {
             handle_guest_event(std::move(record));
         }
 
-        pipe_session_.clear();
+        pipe_session_.Clear();
         ::DisconnectNamedPipe(pipe);
         ::CloseHandle(pipe);
         pipe_handle_ = INVALID_HANDLE_VALUE;
@@ -292,7 +292,7 @@ void IpcBridge::pipe_worker() {
 
 bool IpcBridge::send_event_over_socket(const EventRecord &record) {
     SOCKET socket = INVALID_SOCKET;
-    std::vector<std::uint8_t> session;
+    HmacKey session;
     {
         std::lock_guard<std::mutex> lock(socket_mutex_);
         socket = socket_handle_;
@@ -304,7 +304,7 @@ bool IpcBridge::send_event_over_socket(const EventRecord &record) {
     auto write_fn = [socket](const std::uint8_t *buffer, std::size_t bytes) -> bool {
         return write_full_socket(socket, buffer, bytes);
     };
-    return IpcSendEvent(write_fn, session, record);
+    return IpcSendEvent(write_fn, session, record, IpcPayloadEncoding::Binary);
 }
 
 void IpcBridge::unix_worker() {
@@ -352,7 +352,7 @@ void IpcBridge::unix_worker() {
             return read_full_socket(socket, buffer, bytes);
         };
 
-        std::vector<std::uint8_t> session;
+        HmacKey session;
         if (!IpcClientHandshake(write_fn, read_fn, secret_, session)) {
             ::closesocket(socket);
             std::this_thread::sleep_for(std::chrono::seconds(3));
@@ -386,7 +386,7 @@ void IpcBridge::unix_worker() {
 
         {
             std::lock_guard<std::mutex> lock(socket_mutex_);
-            socket_session_.clear();
+            socket_session_.Clear();
             socket_handle_ = INVALID_SOCKET;
         }
         ::closesocket(socket);
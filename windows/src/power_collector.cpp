@@ -62,7 +62,7 @@ void PowerCollector::Start(ShutdownMonitorService &service) {
     if (!stop_event_) {
         EventRecord record;
         record.category = "Power";
-        record.severity = "Error";
+        record.severity = Severity::Error;
         record.message = "Failed to create stop event for power collector";
         emit(service, std::move(record));
         return;
@@ -78,7 +78,7 @@ void PowerCollector::Start(ShutdownMonitorService &service) {
     if (!thread) {
         EventRecord record;
         record.category = "Power";
-        record.severity = "Error";
+        record.severity = Severity::Error;
         record.message = "Failed to create power collector thread";
         emit(service, std::move(record));
         return;
@@ -108,7 +108,7 @@ void PowerCollector::run(ShutdownMonitorService &service) {
         if (!GetSystemPowerStatus(&status)) {
             EventRecord record;
             record.category = "Power";
-            record.severity = "Warning";
+            record.severity = Severity::Warning;
             record.message = "GetSystemPowerStatus failed";
             record.attributes.push_back({"error", std::to_string(GetLastError())});
             emit(service, std::move(record));
@@ -117,7 +117,7 @@ void PowerCollector::run(ShutdownMonitorService &service) {
         if (first || memcmp(&status, &last_status, sizeof(status)) != 0) {
             EventRecord record;
             record.category = "Power";
-            record.severity = "Info";
+            record.severity = Severity::Info;
             record.message = "Power status changed";
             record.attributes.push_back({"ACLineStatus", ac_state_to_string(status.ACLineStatus)});
             record.attributes.push_back({"BatteryFlag", battery_flag_to_string(status.BatteryFlag)});
@@ -132,7 +132,7 @@ void PowerCollector::run(ShutdownMonitorService &service) {
                 if (StringFromCLSID(*scheme, &guid_string) == S_OK && guid_string) {
                     EventRecord scheme_record;
                     scheme_record.category = "Power";
-                    scheme_record.severity = "Info";
+                    scheme_record.severity = Severity::Info;
                     scheme_record.message = "Active power scheme";
                     scheme_record.attributes.push_back({"Guid", wide_to_utf8(guid_string)});
                     emit(service, std::move(scheme_record));
@@ -42,7 +42,7 @@ void ProcessCollector::Start(ShutdownMonitorService &service) {
     if (!stop_event_) {
         EventRecord record;
         record.category = "Process";
-        record.severity = "Error";
+        record.severity = Severity::Error;
         record.message = "Failed to create stop event for process collector";
         emit(service, std::move(record));
         return;
@@ -58,7 +58,7 @@ void ProcessCollector::Start(ShutdownMonitorService &service) {
     if (!thread) {
         EventRecord record;
         record.category = "Process";
-        record.severity = "Error";
+        record.severity = Severity::Error;
         record.message = "Failed to create process collector thread";
         emit(service, std::move(record));
         return;
@@ -90,7 +90,7 @@ void ProcessCollector::run(ShutdownMonitorService &service) {
         if (!snapshot || snapshot.get() == INVALID_HANDLE_VALUE) {
             EventRecord record;
             record.category = "Process";
-            record.severity = "Warning";
+            record.severity = Severity::Warning;
             record.message = "CreateToolhelp32Snapshot failed";
             record.attributes.push_back({"error", std::to_string(GetLastError())});
             emit(service, std::move(record));
@@ -111,11 +111,11 @@ void ProcessCollector::run(ShutdownMonitorService &service) {
                     if (!last_wsl_pids.count(entry.th32ProcessID)) {
                         EventRecord record;
                         record.category = "Process";
-                        record.severity = "Info";
+                        record.severity = Severity::Info;
                         record.message = "Tracked process started";
                         record.attributes.push_back({"name", wide_to_utf8(exe)});
-                        record.attributes.push_back({"pid", std::to_string(entry.th32ProcessID)});
-                        record.attributes.push_back({"parent_pid", std::to_string(entry.th32ParentProcessID)});
+                        record.attributes.push_back({"pid", entry.th32ProcessID});
+                        record.attributes.push_back({"parent_pid", entry.th32ParentProcessID});
                         emit(service, std::move(record));
                     }
 
@@ -145,13 +145,13 @@ void ProcessCollector::run(ShutdownMonitorService &service) {
                             if (percent > 75.0 || significant_change) {
                                 EventRecord usage;
                                 usage.category = "Process";
-                                usage.severity = percent > 90.0 ? "Critical" : "Warning";
+                                usage.severity = percent > 90.0 ? Severity::Critical : Severity::Warning;
                                 usage.message = "Tracked process memory pressure";
                                 usage.attributes.push_back({"name", wide_to_utf8(exe)});
-                                usage.attributes.push_back({"pid", std::to_string(entry.th32ProcessID)});
-                                usage.attributes.push_back({"working_set_mb", std::to_string(working_set_mb)});
-                                usage.attributes.push_back({"commit_mb", std::to_string(commit_mb)});
-                                usage.attributes.push_back({"working_set_percent", std::to_string(percent)});
+                                usage.attributes.push_back({"pid", entry.th32ProcessID});
+                                usage.attributes.push_back({"working_set_mb", working_set_mb});
+                                usage.attributes.push_back({"commit_mb", commit_mb});
+                                usage.attributes.push_back({"working_set_percent", percent});
                                 emit(service, std::move(usage));
                             }
                             last_working_sets[entry.th32ProcessID] = counters.WorkingSetSize;
@@ -166,9 +166,9 @@ void ProcessCollector::run(ShutdownMonitorService &service) {
                 last_working_sets.erase(pid);
                 EventRecord record;
                 record.category = "Process";
-                record.severity = "Warning";
+                record.severity = Severity::Warning;
                 record.message = "Tracked process exited";
-                record.attributes.push_back({"pid", std::to_string(pid)});
+                record.attributes.push_back({"pid", pid});
                 emit(service, std::move(record));
             }
         }
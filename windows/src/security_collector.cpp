@@ -99,7 +99,7 @@ void emit_vendor_service_state(EmitFn &&emit_fn,
     record.attributes.push_back({"service", bstr_to_utf8(_bstr_t(probe.service_name.c_str()))});
 
     if (!vendor_service) {
-        record.severity = "Warning";
+        record.severity = Severity::Warning;
         record.message = "Vendor service unavailable";
         record.attributes.push_back({"error", std::to_string(GetLastError())});
         emit_fn(std::move(record));
@@ -110,14 +110,14 @@ void emit_vendor_service_state(EmitFn &&emit_fn,
     DWORD bytes_needed = 0;
     if (!QueryServiceStatusEx(vendor_service.get(), SC_STATUS_PROCESS_INFO, reinterpret_cast<LPBYTE>(&status),
                               sizeof(status), &bytes_needed)) {
-        record.severity = "Warning";
+        record.severity = Severity::Warning;
         record.message = "Vendor service state query failed";
         record.attributes.push_back({"error", std::to_string(GetLastError())});
         emit_fn(std::move(record));
         return;
     }
 
-    record.severity = status.dwCurrentState == SERVICE_RUNNING ? "Info" : "Warning";
+    record.severity = status.dwCurrentState == SERVICE_RUNNING ? Severity::Info : Severity::Warning;
     record.message = "Vendor service state";
     record.attributes.push_back({"serviceState", service_state_to_text(status.dwCurrentState)});
     record.attributes.push_back({"pid", std::to_string(status.dwProcessId)});
@@ -169,7 +169,7 @@ void SecurityCollector::Start(ShutdownMonitorService &service) {
     if (!initialize_wmi()) {
         EventRecord record;
         record.category = "Security";
-        record.severity = "Error";
+        record.severity = Severity::Error;
         record.message = "Failed to initialize WMI security collector";
         emit(service, std::move(record));
         if (com_initialized_) {
@@ -182,7 +182,7 @@ void SecurityCollector::Start(ShutdownMonitorService &service) {
     if (!stop_event_) {
         EventRecord record;
         record.category = "Security";
-        record.severity = "Error";
+        record.severity = Severity::Error;
         record.message = "Failed to create stop event for security collector";
         emit(service, std::move(record));
         return;
@@ -198,7 +198,7 @@ void SecurityCollector::Start(ShutdownMonitorService &service) {
     if (!thread) {
         EventRecord record;
         record.category = "Security";
-        record.severity = "Error";
+        record.severity = Severity::Error;
         record.message = "Failed to create security collector thread";
         emit(service, std::move(record));
         return;
@@ -237,7 +237,7 @@ void SecurityCollector::run(ShutdownMonitorService &service) {
         if (FAILED(hr)) {
             EventRecord record;
             record.category = "Security";
-            record.severity = "Warning";
+            record.severity = Severity::Warning;
             record.message = "Security product query failed";
             record.attributes.push_back({"suite", suite});
             record.attributes.push_back({"error", std::to_string(hr)});
@@ -287,11 +287,11 @@ void SecurityCollector::run(ShutdownMonitorService &service) {
                 record.attributes.push_back({"stateText", state_text});
             }
 
-            record.severity = "Info";
+            record.severity = Severity::Info;
             if (!state_text.empty() && contains_case_insensitive(state_text, "Disabled")) {
-                record.severity = "Warning";
+                record.severity = Severity::Warning;
             } else if (!state_text.empty() && contains_case_insensitive(state_text, "Outdated")) {
-                record.severity = "Warning";
+                record.severity = Severity::Warning;
             }
 
             emit(service, std::move(record));
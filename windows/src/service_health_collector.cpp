@@ -54,7 +54,7 @@ void ServiceHealthCollector::Start(ShutdownMonitorService &service) {
     if (!stop_event_) {
         EventRecord record;
         record.category = "ServiceHealth";
-        record.severity = "Error";
+        record.severity = Severity::Error;
         record.message = "Failed to create stop event for service health collector";
         emit(service, std::move(record));
         return;
@@ -70,7 +70,7 @@ void ServiceHealthCollector::Start(ShutdownMonitorService &service) {
     if (!thread) {
         EventRecord record;
         record.category = "ServiceHealth";
-        record.severity = "Error";
+        record.severity = Severity::Error;
         record.message = "Failed to create service health collector thread";
         emit(service, std::move(record));
         return;
@@ -108,7 +108,7 @@ void ServiceHealthCollector::emit_status(ShutdownMonitorService &service, const
     if (last_status) {
         record.attributes.push_back({"previous_state", state_to_string(last_status->dwCurrentState)});
         if (last_status->dwProcessId != status.dwProcessId) {
-            record.severity = "Warning";
+            record.severity = Severity::Warning;
             record.attributes.push_back({"previous_pid", std::to_string(last_status->dwProcessId)});
             record.message = "Service process changed";
         }
@@ -121,7 +121,7 @@ void ServiceHealthCollector::run(ShutdownMonitorService &service) {
     if (!scm) {
         EventRecord record;
         record.category = "ServiceHealth";
-        record.severity = "Error";
+        record.severity = Severity::Error;
         record.message = "Failed to open service control manager";
         record.attributes.push_back({"error", std::to_string(GetLastError())});
         emit(service, std::move(record));
@@ -136,7 +136,7 @@ void ServiceHealthCollector::run(ShutdownMonitorService &service) {
             if (!svc) {
                 EventRecord record;
                 record.category = "ServiceHealth";
-                record.severity = "Warning";
+                record.severity = Severity::Warning;
                 record.message = "Unable to open service";
                 record.attributes.push_back({"service", wide_to_utf8(service_name)});
                 record.attributes.push_back({"error", std::to_string(GetLastError())});
@@ -150,7 +150,7 @@ void ServiceHealthCollector::run(ShutdownMonitorService &service) {
                                       &bytes_needed)) {
                 EventRecord record;
                 record.category = "ServiceHealth";
-                record.severity = "Warning";
+                record.severity = Severity::Warning;
                 record.message = "QueryServiceStatusEx failed";
                 record.attributes.push_back({"service", wide_to_utf8(service_name)});
                 record.attributes.push_back({"error", std::to_string(GetLastError())});
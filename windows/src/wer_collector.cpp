@@ -47,7 +47,7 @@ void WerCollector::Start(ShutdownMonitorService &service) {
     if (!stop_event_) {
         EventRecord record;
         record.category = "WER";
-        record.severity = "Error";
+        record.severity = Severity::Error;
         record.message = "Failed to create stop event for WER collector";
         emit(service, std::move(record));
         return;
@@ -63,7 +63,7 @@ void WerCollector::Start(ShutdownMonitorService &service) {
     if (!thread) {
         EventRecord record;
         record.category = "WER";
-        record.severity = "Error";
+        record.severity = Severity::Error;
         record.message = "Failed to create WER collector thread";
         emit(service, std::move(record));
         return;
@@ -96,7 +96,7 @@ void WerCollector::scan_directory(ShutdownMonitorService &service, const std::ws
     if (handle == INVALID_HANDLE_VALUE) {
         EventRecord record;
         record.category = category;
-        record.severity = "Warning";
+        record.severity = Severity::Warning;
         record.message = "Unable to enumerate directory";
         record.attributes.push_back({"path", wide_to_utf8(path)});
         record.attributes.push_back({"error", std::to_string(GetLastError())});
@@ -112,7 +112,7 @@ void WerCollector::scan_directory(ShutdownMonitorService &service, const std::ws
         if (it == state.end() || CompareFileTime(&it->second, &data.ftLastWriteTime) < 0) {
             EventRecord record;
             record.category = category;
-            record.severity = "Info";
+            record.severity = Severity::Info;
             record.message = "Crash artifact updated";
             record.attributes.push_back({"path", wide_to_utf8(path + L"\\" + data.cFileName)});
             record.attributes.push_back({"last_write", filetime_to_string(data.ftLastWriteTime)});
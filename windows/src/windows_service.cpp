@@ -28,8 +28,11 @@ constexpr wchar_t kServiceName[] = L"WslShutdownMonitor";
 }
 
 ShutdownMonitorService::ShutdownMonitorService()
-    : logger_(std::filesystem::path{L"C:/ProgramData/WslMonitor/host-events.log"}, "wslmon.windows"),
-      buffer_(1024),
+    : logger_(std::filesystem::path{L"C:/ProgramData/WslMonitor/host-events.log"},
+              "wslmon.windows",
+              LogCommitPolicy{/*group_commit=*/true}),
+      // Routine, elevated and urgent slots; 1024 in all, as before.
+      buffer_({512, 256, 256}),
       bridge_(std::make_unique<IpcBridge>(*this)) {}
 
 ShutdownMonitorService::~ShutdownMonitorService() { Stop(); }
@@ -57,6 +60,10 @@ void ShutdownMonitorService::Run() {
 
     set_status(SERVICE_START_PENDING, NO_ERROR, 4000);
 
+    black_box_.Open(std::filesystem::path{L"C:/ProgramData/WslMonitor/host-blackbox.ring"});
+    logger_.AttachBlackBox(&black_box_);
+    LogRecoveredEvents(logger_, black_box_.TakeRecovered(), "wslmon.windows.blackbox");
+
     collectors_.emplace_back(std::make_unique<EventLogCollector>());
     collectors_.emplace_back(std::make_unique<PowerCollector>());
     collectors_.emplace_back(std::make_unique<ProcessCollector>());
@@ -87,6 +94,7 @@ void ShutdownMonitorService::Stop() {
     if (worker_.joinable()) {
         worker_.join();
     }
+    black_box_.Close();
     set_status(SERVICE_STOPPED);
 }
 
@@ -126,7 +134,7 @@ void WINAPI ServiceMain(DWORD /*argc*/, LPWSTR * /*argv*/) {
     } catch (const std::exception &ex) {
         EventRecord record;
         record.category = "Service";
-        record.severity = "Critical";
+        record.severity = Severity::Critical;
         record.message = std::string("Failed to start service: ") + ex.what();
         service.Logger().Append(record);
     }
@@ -142,7 +150,7 @@ void WINAPI ServiceCtrlHandler(DWORD control_code) {
         case SERVICE_CONTROL_POWEREVENT: {
             EventRecord record;
             record.category = "PowerEvent";
-            record.severity = "Info";
+            record.severity = Severity::Info;
             record.message = "Received power event";
             record.attributes.push_back({"code", std::to_string(control_code)});
             service.Logger().Append(record);
@@ -40,7 +40,7 @@ void WslDiagnosticCollector::Start(ShutdownMonitorService &service) {
     if (!stop_event_) {
         EventRecord record;
         record.category = "WslDiagnostics";
-        record.severity = "Error";
+        record.severity = Severity::Error;
         record.message = "Failed to create stop event for WSL diagnostics collector";
         emit(service, std::move(record));
         return;
@@ -56,7 +56,7 @@ void WslDiagnosticCollector::Start(ShutdownMonitorService &service) {
     if (!thread) {
         EventRecord record;
         record.category = "WslDiagnostics";
-        record.severity = "Error";
+        record.severity = Severity::Error;
         record.message = "Failed to create WSL diagnostics collector thread";
         emit(service, std::move(record));
         return;
@@ -82,7 +82,7 @@ void WslDiagnosticCollector::collect_command(ShutdownMonitorService &service, co
     if (!pipe) {
         EventRecord record;
         record.category = category;
-        record.severity = "Warning";
+        record.severity = Severity::Warning;
         record.message = std::string("Failed to execute command: ") + wide_to_utf8(std::wstring(command));
         record.attributes.push_back({"error", std::to_string(GetLastError())});
         emit(service, std::move(record));
@@ -92,7 +92,7 @@ void WslDiagnosticCollector::collect_command(ShutdownMonitorService &service, co
     int exit_code = _pclose(pipe);
     EventRecord record;
     record.category = category;
-    record.severity = exit_code == 0 ? "Info" : "Warning";
+    record.severity = exit_code == 0 ? Severity::Info : Severity::Warning;
     record.message = message;
     record.attributes.push_back({"command", wide_to_utf8(std::wstring(command))});
     record.attributes.push_back({"exit_code", std::to_string(exit_code)});